@@ -0,0 +1,111 @@
+#include "ilp_async_solve.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace ilp_solver
+{
+    using Clock = std::chrono::steady_clock;
+
+    // How often a cancelled solve is interrupted again while waiting for it.
+    static constexpr std::chrono::milliseconds c_interrupt_interval{ 10 };
+
+
+    AsyncSolve::AsyncSolve(ILPSolverInterface* v_solver, ObjectiveSense p_sense)
+        : d_solver(v_solver)
+    {
+        auto* solver_impl = dynamic_cast<ILPSolverImpl*>(v_solver);
+        std::shared_ptr<SharedIncumbent> previous_incumbent;
+        if (solver_impl)
+        {
+            previous_incumbent = solver_impl->get_shared_incumbent();
+            d_incumbent = std::make_shared<SharedIncumbent>(p_sense);
+            solver_impl->set_shared_incumbent(d_incumbent);
+        }
+
+        d_solve = std::async(std::launch::async, [v_solver, solver_impl, p_sense, previous_incumbent]()
+        {
+            // The incumbent set by the caller, if any, is restored even if the solve fails.
+            struct IncumbentRestorer
+            {
+                ~IncumbentRestorer() { if (solver_impl) solver_impl->set_shared_incumbent(previous_incumbent); }
+
+                ILPSolverImpl*                   solver_impl;
+                std::shared_ptr<SharedIncumbent> previous_incumbent;
+            } incumbent_restorer{ solver_impl, previous_incumbent };
+
+            if (p_sense == ObjectiveSense::MINIMIZE)
+                v_solver->minimize();
+            else
+                v_solver->maximize();
+        });
+    }
+
+
+    AsyncSolve::~AsyncSolve()
+    {
+        if (!d_solve.valid())
+            return;
+        cancel();
+        wait_until(Clock::time_point::max());
+    }
+
+
+    void AsyncSolve::cancel()
+    {
+        d_cancelled = true;
+        d_solver->interrupt();
+    }
+
+
+    bool AsyncSolve::is_cancelled() const
+    {
+        return d_cancelled;
+    }
+
+
+    bool AsyncSolve::wait_for(double p_seconds)
+    {
+        if (!d_solve.valid())
+            return true;
+
+        // Huge values like c_default_max_seconds would overflow the time point.
+        const auto now = Clock::now();
+        if (p_seconds >= std::chrono::duration<double>(Clock::time_point::max() - now).count())
+            return wait_until(Clock::time_point::max());
+        return wait_until(now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(std::max(0., p_seconds))));
+    }
+
+
+    void AsyncSolve::finish()
+    {
+        if (!d_solve.valid())
+            return;
+        wait_until(Clock::time_point::max());
+        d_solve.get();
+    }
+
+
+    std::shared_ptr<const Incumbent> AsyncSolve::get_incumbent() const
+    {
+        return d_incumbent ? d_incumbent->get() : nullptr;
+    }
+
+
+    // Waits in short intervals, so that a cancel from another thread is noticed while waiting.
+    bool AsyncSolve::wait_until(Clock::time_point p_deadline)
+    {
+        while (true)
+        {
+            if (d_cancelled)
+                d_solver->interrupt();
+
+            const auto now  = Clock::now();
+            const auto next = (p_deadline - now > c_interrupt_interval) ? now + c_interrupt_interval : p_deadline;
+            if (d_solve.wait_until(next) == std::future_status::ready)
+                return true;
+            if (next == p_deadline)
+                return false;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ilp_shared_incumbent.hpp"
+#include "ilp_solver_interface.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+
+namespace ilp_solver
+{
+    // Minimizes or maximizes a solver on a separate thread, so that the calling thread can go on meanwhile,
+    // e.g. serving other requests, and poll the solve or cancel it.
+    // The solver must not be used otherwise until the solve has finished (see wait_for and finish).
+    // Afterwards, get_solution, get_objective and get_status of the solver return the result as usual.
+    // To poll the solutions, a new shared incumbent replaces the one of the solver (see ILPSolverImpl::set_shared_incumbent)
+    // during the solve. The previous one is restored when the solve has finished.
+    // cancel and get_incumbent may be called from any thread, the other methods only from one thread at a time.
+    class AsyncSolve
+    {
+        public:
+            // Starts the solve and returns immediately.
+            AsyncSolve(ILPSolverInterface* v_solver, ObjectiveSense p_sense);
+
+            // Cancels the solve if it is still running and waits for it. Its exception, if any, is dropped.
+            ~AsyncSolve();
+
+            AsyncSolve(const AsyncSolve&)            = delete;
+            AsyncSolve& operator=(const AsyncSolve&) = delete;
+
+            // Asks the solve to stop as soon as possible via interrupt, so that it keeps the best solution found so far.
+            // Does not wait. A solve that is just starting may miss an interrupt, thus waiting for a cancelled solve
+            // repeats it regularly.
+            void cancel();
+            bool is_cancelled() const;
+
+            // Waits at most p_seconds (0: not at all) and returns whether the solve has finished.
+            bool wait_for(double p_seconds);
+
+            // Waits for the solve and rethrows its exception, if any. Afterwards, wait_for returns true.
+            void finish();
+
+            // The best solution found so far, or nullptr if none has been found yet
+            // or the solver does not support shared incumbents. Never waits.
+            std::shared_ptr<const Incumbent> get_incumbent() const;
+
+        private:
+            ILPSolverInterface*              d_solver;
+            std::shared_ptr<SharedIncumbent> d_incumbent;
+            std::atomic<bool>                d_cancelled{ false };
+            std::future<void>                d_solve;
+
+            // Waits until the solve has finished or p_deadline has passed, interrupting it regularly once cancelled.
+            bool wait_until(std::chrono::steady_clock::time_point p_deadline);
+    };
+}
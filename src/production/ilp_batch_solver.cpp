@@ -0,0 +1,309 @@
+#include "ilp_batch_solver.hpp"
+
+#include "ilp_fingerprint.hpp"
+#include "ilp_structure_cache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    using Clock = std::chrono::steady_clock;
+
+
+    // One thread of an ILPBatchSolver.
+    struct BatchWorker
+    {
+        // The models of the current solve not yet taken, [begin, end).
+        // The worker takes them from the front, other workers steal from the back.
+        std::mutex mutex;
+        int        begin{ 0 };
+        int        end  { 0 };
+
+        // Kept between models and solves. The fingerprint is that of the model in the solver.
+        // A solver that could not be emptied after a failure is broken and replaced before the next solve.
+        ResidentSolver resident_solver;
+        std::uint64_t  fingerprint{ 0 };
+        bool           broken     { false };
+
+        // Statistics of the current solve.
+        long long num_solvers_created{ 0 };
+        long long num_structure_hits { 0 };
+        long long num_steals         { 0 };
+    };
+
+
+    // Removes the whole model, so that the solver can be filled with a model of another structure.
+    // The solution need not be reset, which some solvers do by reloading their model (e.g. CBC).
+    static void clear_model(ILPSolverInterface* v_solver)
+    {
+        vector<int> indices(v_solver->get_num_constraints());
+        std::iota(indices.begin(), indices.end(), 0);
+        if (!indices.empty())
+            v_solver->delete_constraints(indices);
+
+        indices.resize(v_solver->get_num_variables());
+        std::iota(indices.begin(), indices.end(), 0);
+        if (!indices.empty())
+            v_solver->delete_variables(indices);
+    }
+
+
+    // Called on the calling thread, so that the backends are never created concurrently.
+    static void create_solver(BatchWorker* v_worker, const BackendFactory& p_backend_factory)
+    {
+        ResidentSolver resident_solver;
+        resident_solver.solver.reset(p_backend_factory());
+        if (!resident_solver.solver)
+            throw std::exception("Could not create the backend solver.");
+
+        v_worker->resident_solver = std::move(resident_solver);
+        v_worker->fingerprint     = 0;
+        v_worker->broken          = false;
+        ++v_worker->num_solvers_created;
+    }
+
+
+    // A new solver holds no model, thus the fingerprint 0 only matches the empty model.
+    static ILPSolutionData solve_model(BatchWorker* v_worker, const ILPData& p_data)
+    {
+        auto& resident_solver  = v_worker->resident_solver;
+        const auto fingerprint = structure_fingerprint(p_data);
+
+        if (v_worker->fingerprint == fingerprint && has_same_structure(resident_solver, p_data))
+        {
+            resident_solver.solver->reset_solution();
+            update_resident_data(&resident_solver, p_data);
+            ++v_worker->num_structure_hits;
+        }
+        else
+        {
+            clear_model(resident_solver.solver.get());
+            transfer_model(resident_solver.solver.get(), p_data);
+            store_resident_data(&resident_solver, p_data);
+        }
+        v_worker->fingerprint = fingerprint;
+
+        auto* solver = resident_solver.solver.get();
+        if (!p_data.start_solution.empty())
+            solver->set_start_solution(p_data.start_solution);
+        set_solver_parameters(solver, p_data);
+        solver->set_num_threads(1);
+
+        return optimize(solver, p_data.objective_sense);
+    }
+
+
+    static bool take_model(BatchWorker* v_worker, int* r_model_index)
+    {
+        std::lock_guard<std::mutex> lock(v_worker->mutex);
+        if (v_worker->begin >= v_worker->end)
+            return false;
+        *r_model_index = v_worker->begin++;
+        return true;
+    }
+
+
+    // Moves the back half of the remaining models of p_victim to v_thief, whose models must have been taken.
+    static bool steal_models(BatchWorker* v_thief, BatchWorker* v_victim)
+    {
+        int begin, end;
+        {
+            std::lock_guard<std::mutex> lock(v_victim->mutex);
+            const auto num_remaining = v_victim->end - v_victim->begin;
+            if (num_remaining <= 0)
+                return false;
+            end             = v_victim->end;
+            begin           = end - (num_remaining + 1) / 2;
+            v_victim->end   = begin;
+        }
+
+        std::lock_guard<std::mutex> lock(v_thief->mutex);
+        v_thief->begin = begin;
+        v_thief->end   = end;
+        ++v_thief->num_steals;
+        return true;
+    }
+
+
+    ILPBatchSolver::ILPBatchSolver(BackendFactory p_backend_factory, int p_num_threads)
+        : d_backend_factory(std::move(p_backend_factory))
+    {
+        const auto num_threads = (p_num_threads > 0) ? p_num_threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        for (auto w = 0; w < num_threads; ++w)
+            d_workers.push_back(std::make_unique<BatchWorker>());
+    }
+
+
+    // Defined here, since BatchWorker is incomplete in the header.
+    ILPBatchSolver::~ILPBatchSolver() = default;
+
+
+    int ILPBatchSolver::get_num_threads() const
+    {
+        return static_cast<int>(d_workers.size());
+    }
+
+
+    const BatchStatistics& ILPBatchSolver::get_statistics() const
+    {
+        return d_statistics;
+    }
+
+
+    void ILPBatchSolver::solve(const vector<const ILPData*>& p_models, vector<ILPSolutionData>* r_results,
+                               vector<std::exception_ptr>* r_exceptions)
+    {
+        const auto start_time  = Clock::now();
+        const auto num_models  = static_cast<int>(p_models.size());
+        const auto num_workers = std::clamp(num_models, 1, get_num_threads());
+
+        r_results->clear();
+        for (const auto* model: p_models)
+            r_results->emplace_back(model->objective_sense);
+        r_exceptions->assign(num_models, nullptr);
+        auto& exceptions = *r_exceptions;
+
+        for (auto& worker: d_workers)
+        {
+            worker->num_solvers_created = 0;
+            worker->num_structure_hits  = 0;
+            worker->num_steals          = 0;
+        }
+
+        // Indices of the models not yet taken by any worker.
+        vector<int> pending(num_models);
+        std::iota(pending.begin(), pending.end(), 0);
+
+        // Every round solves at least one model, since a solver only breaks on a failed model.
+        // The models left by broken workers are solved in another round with new solvers.
+        do
+        {
+            const auto num_round_workers = std::clamp(static_cast<int>(pending.size()), 1, num_workers);
+            for (auto w = 0; w < num_round_workers; ++w)
+            {
+                auto& worker = *d_workers[w];
+                if (!worker.resident_solver.solver || worker.broken)
+                    create_solver(&worker, d_backend_factory);
+
+                // Contiguous shares, so that models of the same structure, which are often adjacent, stay on one thread.
+                worker.begin = static_cast<int>(static_cast<long long>(pending.size()) *  w      / num_round_workers);
+                worker.end   = static_cast<int>(static_cast<long long>(pending.size()) * (w + 1) / num_round_workers);
+            }
+
+            // Models are only moved between workers. Thus, a worker finding nothing to steal is done.
+            // A worker with a broken solver stops and leaves its models to the others.
+            auto work = [&](int p_w)
+            {
+                auto* worker = d_workers[p_w].get();
+                while (true)
+                {
+                    auto position{ 0 };
+                    if (take_model(worker, &position))
+                    {
+                        const auto k = pending[position];
+                        try
+                        {
+                            (*r_results)[k] = solve_model(worker, *p_models[k]);
+                        }
+                        catch (...)
+                        {
+                            exceptions[k] = std::current_exception();
+                            (*r_results)[k] = ILPSolutionData(p_models[k]->objective_sense);
+
+                            // The state of the solver is unknown. Thus, the next model is transferred completely.
+                            worker->fingerprint = 0;
+                            try
+                            {
+                                clear_model(worker->resident_solver.solver.get());
+                            }
+                            catch (...)
+                            {
+                                worker->broken = true;
+                                return;
+                            }
+                        }
+                        continue;
+                    }
+
+                    auto stolen{ false };
+                    for (auto offset = 1; offset < num_round_workers && !stolen; ++offset)
+                        stolen = steal_models(worker, d_workers[(p_w + offset) % num_round_workers].get());
+                    if (!stolen)
+                        return;
+                }
+            };
+
+            vector<std::thread> workers;
+            workers.reserve(num_round_workers - 1);
+            for (auto w = 1; w < num_round_workers; ++w)
+                workers.emplace_back(work, w);
+            work(0);
+            for (auto& worker: workers)
+                worker.join();
+
+            vector<int> left;
+            for (auto w = 0; w < num_round_workers; ++w)
+            {
+                auto& worker = *d_workers[w];
+                left.insert(left.end(), pending.begin() + worker.begin, pending.begin() + worker.end);
+                worker.begin = worker.end;
+            }
+            pending = std::move(left);
+        }
+        while (!pending.empty());
+
+        d_statistics                     = BatchStatistics();
+        d_statistics.num_models          = num_models;
+        d_statistics.num_threads         = num_workers;
+        d_statistics.num_failed          = static_cast<int>(std::count_if(exceptions.begin(), exceptions.end(), [](const std::exception_ptr& p_exception) { return p_exception != nullptr; }));
+        for (auto w = 0; w < num_workers; ++w)
+        {
+            d_statistics.num_solvers_created += d_workers[w]->num_solvers_created;
+            d_statistics.num_structure_hits  += d_workers[w]->num_structure_hits;
+            d_statistics.num_steals          += d_workers[w]->num_steals;
+        }
+        d_statistics.seconds             = std::chrono::duration<double>(Clock::now() - start_time).count();
+        d_statistics.models_per_second   = (d_statistics.seconds > 0.) ? num_models / d_statistics.seconds : 0.;
+    }
+
+
+    ILPSolverBatchModel::ILPSolverBatchModel(BackendFactory p_backend_factory)
+        : ILPSolverDecorator(std::move(p_backend_factory))
+    { }
+
+
+    const ILPData& ILPSolverBatchModel::prepare_batch(ObjectiveSense p_sense)
+    {
+        d_ilp_data.objective_sense = p_sense;
+        return d_ilp_data;
+    }
+
+
+    void ILPSolverBatchModel::set_result(ILPSolutionData p_result, bool p_failed)
+    {
+        d_ilp_solution_data = std::move(p_result);
+        d_failed            = p_failed;
+    }
+
+
+    bool ILPSolverBatchModel::has_failed() const
+    {
+        return d_failed;
+    }
+
+
+    void ILPSolverBatchModel::solve_impl()
+    {
+        d_failed            = false;
+        d_ilp_solution_data = solve_with_backend(d_ilp_data);
+    }
+}
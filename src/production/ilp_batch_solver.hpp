@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ilp_data.hpp"
+#include "ilp_solver_decorator.hpp"
+
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace ilp_solver
+{
+    struct BatchWorker;
+
+
+    // Statistics of the last solve of an ILPBatchSolver.
+    struct BatchStatistics
+    {
+        int       num_models         { 0 };
+        int       num_failed         { 0 };
+        int       num_threads        { 0 };
+
+        // Solvers created for threads without one. All models reused the solver of their thread.
+        long long num_solvers_created{ 0 };
+        // Models with the structure of the previous model of their thread. Only the differences were transferred.
+        long long num_structure_hits { 0 };
+        // Number of times a thread took over models from another one.
+        long long num_steals         { 0 };
+
+        double    seconds            { 0. };
+        double    models_per_second  { 0. };
+    };
+
+
+    // Solves many independent models at once, e.g. the thousands of small models of a single request.
+    // Every thread keeps its solver and reuses it for the next model: For a model with the same structure
+    // (see structure_fingerprint), only the differing bounds and objective coefficients are transferred.
+    // Otherwise, the solver is emptied and the new model is transferred.
+    // Each thread starts with a contiguous share of the models and, when done, takes over half of the
+    // remaining models of another thread, so that a few expensive models do not leave the other threads idle.
+    // Each model is solved with a single thread, since the threads of the batch already occupy the cores.
+    // The solvers are created on the calling thread before the first model is solved, since not every backend
+    // can be created concurrently. They are kept between solves and destroyed with the batch solver.
+    // A solver that cannot be emptied after a failed model is replaced, again on the calling thread.
+    class ILPBatchSolver
+    {
+        public:
+            // p_num_threads = 0 uses one thread per core.
+            explicit ILPBatchSolver(BackendFactory p_backend_factory, int p_num_threads = 0);
+            ~ILPBatchSolver();
+
+            ILPBatchSolver(const ILPBatchSolver&)            = delete;
+            ILPBatchSolver& operator=(const ILPBatchSolver&) = delete;
+
+            // Solves every model with its objective sense and parameters (except num_threads) and stores
+            // the results in the same order. If some models fail, the others are solved nonetheless.
+            // The failed models have no solution and their exception in r_exceptions, all others nullptr.
+            // Throws without solving if a solver cannot be created.
+            void solve(const std::vector<const ILPData*>& p_models, std::vector<ILPSolutionData>* r_results,
+                       std::vector<std::exception_ptr>* r_exceptions);
+
+            int                    get_num_threads() const;
+            const BatchStatistics& get_statistics () const;
+
+        private:
+            BackendFactory                            d_backend_factory;
+            std::vector<std::unique_ptr<BatchWorker>> d_workers;
+            BatchStatistics                           d_statistics;
+    };
+
+
+    // Collects a model for solve_batch (see ilp_solver_factory.hpp), which stores the result in it.
+    // Solving it on its own solves it with a new backend, like the other decorators.
+    class ILPSolverBatchModel : public ILPSolverDecorator
+    {
+        public:
+            explicit ILPSolverBatchModel(BackendFactory p_backend_factory);
+
+            // Sets the objective sense like minimize or maximize and returns the collected model.
+            const ILPData& prepare_batch(ObjectiveSense p_sense);
+            void           set_result   (ILPSolutionData p_result, bool p_failed);
+
+            // Whether the last solve_batch has failed for this model.
+            bool           has_failed   () const;
+
+        private:
+            bool d_failed{ false };
+
+            void solve_impl() override;
+    };
+}
@@ -0,0 +1,273 @@
+#include "ilp_bound_propagation.hpp"
+
+#include "ilp_sparse_matrix.hpp"
+#include "ilp_tolerance.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    namespace
+    {
+        // Tightenings of continuous bounds by less than this fraction of the bound (at least 1) are skipped.
+        constexpr double c_min_relative_improvement{ 1e-3 };
+
+        // Implied bounds of larger absolute value are numerically meaningless and are ignored.
+        constexpr double c_max_implied_bound{ 1e9 };
+
+
+
+        // Minimal and maximal activities of all constraints.
+        // Infinite contributions are counted instead of summed up.
+        struct Activities
+        {
+            vector<double> min_activity;
+            vector<double> max_activity;
+            vector<int>    num_neg_inf_contributions;
+            vector<int>    num_pos_inf_contributions;
+        };
+
+
+        class BoundPropagator
+        {
+            public:
+                explicit BoundPropagator(const ILPData& p_data);
+
+                PropagatedBounds run(int p_max_rounds);
+
+            private:
+                const ILPData&     d_data;
+                const SparseMatrix d_matrix;
+
+                PropagatedBounds d_result;
+                Activities       d_activities;
+
+                void compute_activities();
+
+                // Returns false if some constraint is infeasible.
+                bool find_redundant_constraints();
+
+                // Returns the number of tightened bounds.
+                int tighten_variable_bounds();
+
+                bool tighten_lower_bound(int p_variable_index, double p_lower_bound);
+                bool tighten_upper_bound(int p_variable_index, double p_upper_bound);
+        };
+
+
+        BoundPropagator::BoundPropagator(const ILPData& p_data)
+            : d_data(p_data),
+              d_matrix(column_major_copy(p_data))
+        {
+            d_result.variable_lower = p_data.variable_lower;
+            d_result.variable_upper = p_data.variable_upper;
+            d_result.redundant_constraint.assign(d_matrix.num_rows, false);
+
+            d_activities.min_activity             .resize(d_matrix.num_rows);
+            d_activities.max_activity             .resize(d_matrix.num_rows);
+            d_activities.num_neg_inf_contributions.resize(d_matrix.num_rows);
+            d_activities.num_pos_inf_contributions.resize(d_matrix.num_rows);
+        }
+
+
+        PropagatedBounds BoundPropagator::run(int p_max_rounds)
+        {
+            for (auto j = 0; j < d_matrix.num_columns; ++j)
+                if (d_result.variable_lower[j] > d_result.variable_upper[j] + feasibility_tolerance(d_result.variable_upper[j]))
+                    d_result.infeasible = true;
+
+            auto& statistics = d_result.statistics;
+            while (!d_result.infeasible && statistics.num_rounds < p_max_rounds)
+            {
+                ++statistics.num_rounds;
+                compute_activities();
+                if (!find_redundant_constraints())
+                {
+                    d_result.infeasible = true;
+                    break;
+                }
+
+                const auto num_tightened_bounds = tighten_variable_bounds();
+                statistics.num_tightened_bounds += num_tightened_bounds;
+                if (num_tightened_bounds == 0)
+                    break;
+            }
+
+            // The last round has tightened bounds. Constraints may have become redundant or infeasible by this.
+            if (!d_result.infeasible && statistics.num_rounds == p_max_rounds && p_max_rounds > 0)
+            {
+                compute_activities();
+                d_result.infeasible = !find_redundant_constraints();
+            }
+
+            statistics.num_redundant_constraints = static_cast<int>(std::count(d_result.redundant_constraint.begin(),
+                                                                               d_result.redundant_constraint.end(), true));
+            return std::move(d_result);
+        }
+
+
+        // One sweep over the non-zeros in column-major order.
+        // The bounds of a column are loaded once, the inner loop selects them without branches.
+        void BoundPropagator::compute_activities()
+        {
+            auto& [min_activity, max_activity, num_neg_inf, num_pos_inf] = d_activities;
+            std::fill(min_activity.begin(), min_activity.end(), 0.);
+            std::fill(max_activity.begin(), max_activity.end(), 0.);
+            std::fill(num_neg_inf .begin(), num_neg_inf .end(), 0);
+            std::fill(num_pos_inf .begin(), num_pos_inf .end(), 0);
+
+            for (auto j = 0; j < d_matrix.num_columns; ++j)
+            {
+                const auto lower          = d_result.variable_lower[j];
+                const auto upper          = d_result.variable_upper[j];
+                const auto lower_infinite = is_neg_inf(lower);
+                const auto upper_infinite = is_pos_inf(upper);
+                const auto finite_lower   = lower_infinite ? 0. : lower;
+                const auto finite_upper   = upper_infinite ? 0. : upper;
+
+                for (auto k = d_matrix.start[j]; k < d_matrix.start[j + 1]; ++k)
+                {
+                    const auto i        = d_matrix.index[k];
+                    const auto value    = d_matrix.value[k];
+                    const auto positive = (value > 0.);
+
+                    min_activity[i] += value * (positive ? finite_lower : finite_upper);
+                    max_activity[i] += value * (positive ? finite_upper : finite_lower);
+                    num_neg_inf [i] += positive ? lower_infinite : upper_infinite;
+                    num_pos_inf [i] += positive ? upper_infinite : lower_infinite;
+                }
+            }
+        }
+
+
+        bool BoundPropagator::find_redundant_constraints()
+        {
+            const auto& [min_activity, max_activity, num_neg_inf, num_pos_inf] = d_activities;
+            for (auto i = 0; i < d_matrix.num_rows; ++i)
+            {
+                if (d_result.redundant_constraint[i])
+                    continue;
+
+                const auto lower      = d_data.constraint_lower[i];
+                const auto upper      = d_data.constraint_upper[i];
+                const auto min_finite = (num_neg_inf[i] == 0);
+                const auto max_finite = (num_pos_inf[i] == 0);
+
+                if (min_finite && !is_pos_inf(upper) && min_activity[i] > upper + feasibility_tolerance(upper))
+                    return false;
+                if (max_finite && !is_neg_inf(lower) && max_activity[i] < lower - feasibility_tolerance(lower))
+                    return false;
+
+                // Without tolerance: Dropping the constraint must not allow any violation, which the backends might reject.
+                const auto lower_redundant = is_neg_inf(lower) || (min_finite && min_activity[i] >= lower);
+                const auto upper_redundant = is_pos_inf(upper) || (max_finite && max_activity[i] <= upper);
+                d_result.redundant_constraint[i] = lower_redundant && upper_redundant;
+            }
+            return true;
+        }
+
+
+        // The activities are those of the start of the round. Bounds tightened during the round
+        // make them weaker than necessary, but they stay valid.
+        int BoundPropagator::tighten_variable_bounds()
+        {
+            const auto& [min_activity, max_activity, num_neg_inf, num_pos_inf] = d_activities;
+
+            auto num_tightened_bounds = 0;
+            for (auto j = 0; j < d_matrix.num_columns && !d_result.infeasible; ++j)
+            {
+                // The bounds that have been used to compute the activities.
+                const auto lower          = d_result.variable_lower[j];
+                const auto upper          = d_result.variable_upper[j];
+                const auto lower_infinite = is_neg_inf(lower);
+                const auto upper_infinite = is_pos_inf(upper);
+
+                for (auto k = d_matrix.start[j]; k < d_matrix.start[j + 1] && !d_result.infeasible; ++k)
+                {
+                    const auto i = d_matrix.index[k];
+                    if (d_result.redundant_constraint[i])
+                        continue;
+
+                    const auto value    = d_matrix.value[k];
+                    const auto positive = (value > 0.);
+
+                    // Minimal and maximal activity of all other variables of the constraint, if finite.
+                    const auto min_bound_infinite = positive ? lower_infinite : upper_infinite;
+                    const auto max_bound_infinite = positive ? upper_infinite : lower_infinite;
+                    const auto rest_min_finite    = (num_neg_inf[i] == (min_bound_infinite ? 1 : 0));
+                    const auto rest_max_finite    = (num_pos_inf[i] == (max_bound_infinite ? 1 : 0));
+                    const auto rest_min = min_activity[i] - (min_bound_infinite ? 0. : value * (positive ? lower : upper));
+                    const auto rest_max = max_activity[i] - (max_bound_infinite ? 0. : value * (positive ? upper : lower));
+
+                    // value * x <= upper - rest_min and value * x >= lower - rest_max.
+                    const auto constraint_lower = d_data.constraint_lower[i];
+                    const auto constraint_upper = d_data.constraint_upper[i];
+                    if (rest_min_finite && !is_pos_inf(constraint_upper))
+                    {
+                        const auto bound = (constraint_upper - rest_min) / value;
+                        num_tightened_bounds += positive ? tighten_upper_bound(j, bound) : tighten_lower_bound(j, bound);
+                    }
+                    if (rest_max_finite && !is_neg_inf(constraint_lower))
+                    {
+                        const auto bound = (constraint_lower - rest_max) / value;
+                        num_tightened_bounds += positive ? tighten_lower_bound(j, bound) : tighten_upper_bound(j, bound);
+                    }
+                }
+            }
+            return num_tightened_bounds;
+        }
+
+
+        bool BoundPropagator::tighten_lower_bound(int p_variable_index, double p_lower_bound)
+        {
+            if (std::abs(p_lower_bound) > c_max_implied_bound)
+                return false;
+
+            auto& lower = d_result.variable_lower[p_variable_index];
+            auto& upper = d_result.variable_upper[p_variable_index];
+            if (d_data.variable_type[p_variable_index] != VariableType::CONTINUOUS)
+                p_lower_bound = std::ceil(p_lower_bound - c_feasibility_tolerance);
+            else if (!is_neg_inf(lower) && p_lower_bound <= lower + c_min_relative_improvement * std::max(1., std::abs(lower)))
+                return false;
+
+            if (p_lower_bound <= lower)
+                return false;
+
+            if (p_lower_bound > upper + feasibility_tolerance(upper))
+                d_result.infeasible = true;
+            lower = std::min(p_lower_bound, upper);
+            return true;
+        }
+
+
+        bool BoundPropagator::tighten_upper_bound(int p_variable_index, double p_upper_bound)
+        {
+            if (std::abs(p_upper_bound) > c_max_implied_bound)
+                return false;
+
+            auto& lower = d_result.variable_lower[p_variable_index];
+            auto& upper = d_result.variable_upper[p_variable_index];
+            if (d_data.variable_type[p_variable_index] != VariableType::CONTINUOUS)
+                p_upper_bound = std::floor(p_upper_bound + c_feasibility_tolerance);
+            else if (!is_pos_inf(upper) && p_upper_bound >= upper - c_min_relative_improvement * std::max(1., std::abs(upper)))
+                return false;
+
+            if (p_upper_bound >= upper)
+                return false;
+
+            if (p_upper_bound < lower - feasibility_tolerance(lower))
+                d_result.infeasible = true;
+            upper = std::max(p_upper_bound, lower);
+            return true;
+        }
+    }
+
+
+    PropagatedBounds propagate_bounds(const ILPData& p_data, int p_max_rounds)
+    {
+        return BoundPropagator(p_data).run(p_max_rounds);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ilp_data.hpp"
+
+#include <vector>
+
+namespace ilp_solver
+{
+    constexpr int c_default_max_propagation_rounds{ 10 };
+
+
+    struct PropagationStatistics
+    {
+        int num_rounds               { 0 };
+        int num_tightened_bounds     { 0 };
+        int num_redundant_constraints{ 0 };
+    };
+
+
+    struct PropagatedBounds
+    {
+        std::vector<double> variable_lower;
+        std::vector<double> variable_upper;
+
+        // Constraints that are satisfied for all values within the propagated variable bounds.
+        std::vector<bool> redundant_constraint;
+
+        // Some constraint can not be satisfied within the variable bounds. The bounds are meaningless then.
+        bool infeasible{ false };
+
+        PropagationStatistics statistics;
+    };
+
+
+    // Computes the minimal and maximal activity of every constraint from the variable bounds
+    // and tightens the variable bounds to the values implied by the constraints.
+    // This is repeated until no bound changes any more, but at most p_max_rounds times.
+    // Integer bounds are rounded. Tightenings of continuous bounds that are insignificant
+    // compared to the bound are skipped, so that the rounds do not creep towards a limit.
+    // Works on a column-major sparse copy of the matrix.
+    PropagatedBounds propagate_bounds(const ILPData& p_data, int p_max_rounds = c_default_max_propagation_rounds);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace ilp_solver
+{
+    // Configurations of the cut generators and heuristics used by CBC,
+    // modelled after the settings of the stand-alone cbc executable (CbcMain1).
+    // Its preprocessing (CglPreProcess) is not applied by any profile.
+    enum class CbcProfile
+    {
+        // Probing, Gomory, knapsack cover, clique, MIR, flow cover and two-step MIR cuts at the root,
+        // continued in the tree only where they are effective. Rounding, feasibility pump, greedy,
+        // solution combination and RINS heuristics. Like cbc with default settings.
+        DEFAULT,
+
+        // The cuts of DEFAULT in every node of the tree and with more passes at the root.
+        // Slower per node, but often fewer nodes on models with a weak LP relaxation.
+        AGGRESSIVE_CUTS,
+
+        // Cuts only at the root, heuristics called more often and depth first search,
+        // to find good solutions fast, e.g. together with a time limit.
+        FEASIBILITY_FIRST,
+
+        // Plain branch and bound without cuts and heuristics. Mainly for comparisons.
+        PLAIN
+    };
+}
@@ -61,4 +61,20 @@ namespace ilp_solver
               solution_status(SolutionStatus::NO_SOLUTION)
             {}
     };
+
+
+    // Copies the parameters (not the model and not the start solution).
+    // Useful for derived models, e.g. in presolve or decomposition.
+    inline void copy_parameters(const ILPData& p_data, ILPData* r_data)
+    {
+        r_data->num_threads   = p_data.num_threads;
+        r_data->deterministic = p_data.deterministic;
+        r_data->log_level     = p_data.log_level;
+        r_data->presolve      = p_data.presolve;
+        r_data->max_seconds   = p_data.max_seconds;
+        r_data->max_nodes     = p_data.max_nodes;
+        r_data->max_solutions = p_data.max_solutions;
+        r_data->max_abs_gap   = p_data.max_abs_gap;
+        r_data->max_rel_gap   = p_data.max_rel_gap;
+    }
 }
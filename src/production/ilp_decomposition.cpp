@@ -0,0 +1,168 @@
+#include "ilp_decomposition.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    namespace
+    {
+        // Union-find with union by size and path halving.
+        class DisjointSets
+        {
+            public:
+                explicit DisjointSets(int p_num_elements)
+                    : d_parent(p_num_elements),
+                      d_size(p_num_elements, 1)
+                {
+                    std::iota(d_parent.begin(), d_parent.end(), 0);
+                }
+
+                int find(int p_element)
+                {
+                    while (d_parent[p_element] != p_element)
+                    {
+                        d_parent[p_element] = d_parent[d_parent[p_element]];
+                        p_element = d_parent[p_element];
+                    }
+                    return p_element;
+                }
+
+                void unite(int p_first, int p_second)
+                {
+                    auto first  = find(p_first);
+                    auto second = find(p_second);
+                    if (first == second)
+                        return;
+                    if (d_size[first] < d_size[second])
+                        std::swap(first, second);
+                    d_parent[second] = first;
+                    d_size  [first] += d_size[second];
+                }
+
+            private:
+                vector<int> d_parent;
+                vector<int> d_size;
+        };
+    }
+
+
+    Decomposition decompose(const ILPData& p_data)
+    {
+        const auto num_variables   = static_cast<int>(p_data.variable_type.size());
+        const auto num_constraints = static_cast<int>(p_data.matrix.size());
+
+        DisjointSets sets(num_variables);
+        vector<int>  first_variable(num_constraints, -1);
+        vector<int>  num_non_zeros (num_constraints, 0);
+        vector<bool> in_constraint (num_variables, false);
+
+        for (auto i = 0; i < num_constraints; ++i)
+        {
+            const auto& row = p_data.matrix[i];
+            for (auto j = 0; j < num_variables; ++j)
+            {
+                if (row[j] == 0.)
+                    continue;
+
+                in_constraint[j] = true;
+                ++num_non_zeros[i];
+                if (first_variable[i] < 0)
+                    first_variable[i] = j;
+                else
+                    sets.unite(first_variable[i], j);
+            }
+        }
+
+        // Number the components in the order of their first variable.
+        // Variables without constraints go to an extra component, which is created on demand.
+        Decomposition decomposition;
+        vector<int> component_of_root(num_variables, -1);
+        vector<int> component_size   (0);
+        auto free_component = -1;
+
+        auto component_of_variable = [&](int p_variable_index)
+        {
+            auto& component = in_constraint[p_variable_index] ? component_of_root[sets.find(p_variable_index)] : free_component;
+            if (component < 0)
+            {
+                component = static_cast<int>(decomposition.components.size());
+                decomposition.components.emplace_back();
+                component_size.push_back(0);
+            }
+            return component;
+        };
+
+        for (auto j = 0; j < num_variables; ++j)
+        {
+            const auto component = component_of_variable(j);
+            decomposition.components[component].variables.push_back(j);
+            ++component_size[component];
+        }
+
+        for (auto i = 0; i < num_constraints; ++i)
+        {
+            if (first_variable[i] < 0)
+            {
+                decomposition.empty_constraints.push_back(i);
+                continue;
+            }
+            const auto component = component_of_variable(first_variable[i]);
+            decomposition.components[component].constraints.push_back(i);
+            component_size[component] += num_non_zeros[i];
+        }
+
+        // Largest first.
+        vector<int> order(decomposition.components.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int p_first, int p_second) { return component_size[p_first] > component_size[p_second]; });
+
+        vector<Component> sorted_components;
+        sorted_components.reserve(order.size());
+        for (auto component: order)
+        {
+            sorted_components.push_back(std::move(decomposition.components[component]));
+            sorted_components.back().size = component_size[component];
+        }
+        decomposition.components = std::move(sorted_components);
+
+        return decomposition;
+    }
+
+
+    ILPData extract_component(const ILPData& p_data, const Component& p_component)
+    {
+        ILPData data;
+
+        for (auto j: p_component.variables)
+        {
+            data.objective     .push_back(p_data.objective[j]);
+            data.variable_lower.push_back(p_data.variable_lower[j]);
+            data.variable_upper.push_back(p_data.variable_upper[j]);
+            data.variable_type .push_back(p_data.variable_type[j]);
+        }
+
+        for (auto i: p_component.constraints)
+        {
+            const auto& row = p_data.matrix[i];
+            vector<double> component_row;
+            component_row.reserve(p_component.variables.size());
+            for (auto j: p_component.variables)
+                component_row.push_back(row[j]);
+            data.matrix.push_back(std::move(component_row));
+
+            data.constraint_lower.push_back(p_data.constraint_lower[i]);
+            data.constraint_upper.push_back(p_data.constraint_upper[i]);
+        }
+
+        data.objective_sense = p_data.objective_sense;
+        if (!p_data.start_solution.empty())
+            for (auto j: p_component.variables)
+                data.start_solution.push_back(p_data.start_solution[j]);
+
+        copy_parameters(p_data, &data);
+        return data;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ilp_data.hpp"
+
+#include <vector>
+
+namespace ilp_solver
+{
+    // Variables and constraints of an independent part of a model.
+    // No constraint of a component contains a variable of another component.
+    struct Component
+    {
+        std::vector<int> variables;
+        std::vector<int> constraints;
+
+        // Number of variables plus number of non-zeros, as a measure of the effort to solve the component.
+        int size{ 0 };
+    };
+
+
+    struct Decomposition
+    {
+        // Sorted by decreasing number of non-zeros, so that the largest components can be started first.
+        std::vector<Component> components;
+
+        // Constraints without non-zeros. They belong to no component.
+        std::vector<int> empty_constraints;
+    };
+
+
+    // Finds the connected components of the bipartite graph of variables and constraints
+    // (union-find on the variables of each constraint).
+    // All variables that do not appear in any constraint are gathered in a single component.
+    Decomposition decompose(const ILPData& p_data);
+
+    // The model restricted to the variables and constraints of p_component, including start solution and parameters.
+    ILPData extract_component(const ILPData& p_data, const Component& p_component);
+}
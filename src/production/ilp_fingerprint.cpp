@@ -0,0 +1,221 @@
+#include "ilp_fingerprint.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+// SSE2 is available on every x64 processor.
+#if defined(_M_X64) || defined(__SSE2__)
+#define FINGERPRINT_SSE2
+#include <emmintrin.h>
+#endif
+
+// Constants of xxHash64 and XXH3, which the mixing below follows.
+constexpr std::uint64_t c_prime_1{ 0x9E3779B185EBCA87ull };
+constexpr std::uint64_t c_prime_2{ 0xC2B2AE3D27D4EB4Full };
+constexpr std::uint64_t c_prime_3{ 0x165667B19E3779F9ull };
+constexpr std::uint64_t c_prime_4{ 0x85EBCA77C2B2AE63ull };
+constexpr std::uint64_t c_prime_5{ 0x27D4EB2F165667C5ull };
+constexpr std::uint32_t c_prime32 { 0x9E3779B1u };
+
+// One key per lane
+alignas(16) constexpr std::uint64_t c_keys[4]{ 0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull };
+
+namespace ilp_solver
+{
+    static inline std::uint64_t rotate_left(std::uint64_t p_value, int p_bits)
+    {
+        return (p_value << p_bits) | (p_value >> (64 - p_bits));
+    }
+
+
+    static inline std::uint64_t mix_word(std::uint64_t p_lane, std::uint64_t p_word)
+    {
+        p_lane += p_word * c_prime_2;
+        p_lane  = rotate_left(p_lane, 31);
+        return p_lane * c_prime_1;
+    }
+
+
+    void Fingerprint::add_bytes(const void* p_address, std::size_t p_num_bytes)
+    {
+        if (p_num_bytes == 0)
+            return;
+
+        auto address = static_cast<const unsigned char*>(p_address);
+        d_num_bytes += p_num_bytes;
+
+        // Complete the pending block first.
+        if (d_num_pending > 0)
+        {
+            const auto num_copied = std::min(p_num_bytes, c_block_bytes - d_num_pending);
+            std::memcpy(d_pending.data() + d_num_pending, address, num_copied);
+            d_num_pending += num_copied;
+            address       += num_copied;
+            p_num_bytes   -= num_copied;
+
+            if (d_num_pending < c_block_bytes)
+                return;
+
+            add_blocks(d_pending.data(), 1);
+            d_num_pending = 0;
+        }
+
+        const auto num_blocks = p_num_bytes / c_block_bytes;
+        add_blocks(address, num_blocks);
+        address     += num_blocks * c_block_bytes;
+        p_num_bytes -= num_blocks * c_block_bytes;
+
+        // Keep the rest for the next call.
+        std::memcpy(d_pending.data(), address, p_num_bytes);
+        d_num_pending = p_num_bytes;
+    }
+
+
+#ifdef FINGERPRINT_SSE2
+    // Two lanes per register: Every lane adds the word of its neighbor and the product of the halves of its own word xor its key.
+    static void accumulate(std::uint64_t* v_lanes, const unsigned char* p_address, std::size_t p_num_blocks)
+    {
+        auto* lanes = reinterpret_cast<__m128i*>(v_lanes);
+        const auto* keys = reinterpret_cast<const __m128i*>(c_keys);
+
+        __m128i accumulators[2]{ _mm_loadu_si128(lanes), _mm_loadu_si128(lanes + 1) };
+        const __m128i key_pairs[2]{ _mm_load_si128(keys), _mm_load_si128(keys + 1) };
+        for (std::size_t block = 0; block < p_num_blocks; ++block)
+        {
+            const auto* words = reinterpret_cast<const __m128i*>(p_address + block * 32);
+            for (auto k = 0; k < 2; ++k)
+            {
+                const auto data     = _mm_loadu_si128(words + k);
+                const auto keyed    = _mm_xor_si128(data, key_pairs[k]);
+                const auto product  = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+                const auto swapped  = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                accumulators[k] = _mm_add_epi64(accumulators[k], _mm_add_epi64(product, swapped));
+            }
+        }
+        _mm_storeu_si128(lanes,     accumulators[0]);
+        _mm_storeu_si128(lanes + 1, accumulators[1]);
+    }
+
+
+    // 64 x 32 bit multiplication from two 32 x 32 to 64 bit ones.
+    static void scramble(std::uint64_t* v_lanes)
+    {
+        auto* lanes = reinterpret_cast<__m128i*>(v_lanes);
+        const auto* keys = reinterpret_cast<const __m128i*>(c_keys);
+        const auto prime = _mm_set1_epi32(static_cast<int>(c_prime32));
+        for (auto k = 0; k < 2; ++k)
+        {
+            auto lane_pair = _mm_loadu_si128(lanes + k);
+            lane_pair = _mm_xor_si128(lane_pair, _mm_srli_epi64(lane_pair, 47));
+            lane_pair = _mm_xor_si128(lane_pair, _mm_load_si128(keys + k));
+            const auto low  = _mm_mul_epu32(lane_pair, prime);
+            const auto high = _mm_mul_epu32(_mm_srli_epi64(lane_pair, 32), prime);
+            _mm_storeu_si128(lanes + k, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+        }
+    }
+#else
+    static void accumulate(std::uint64_t* v_lanes, const unsigned char* p_address, std::size_t p_num_blocks)
+    {
+        // Work on a local copy, so that the lanes can stay in registers.
+        std::uint64_t lanes[4];
+        std::memcpy(lanes, v_lanes, sizeof(lanes));
+        for (std::size_t block = 0; block < p_num_blocks; ++block, p_address += 32)
+        {
+            std::uint64_t words[4];
+            std::memcpy(words, p_address, sizeof(words));
+            for (auto lane = 0; lane < 4; ++lane)
+            {
+                const auto keyed = words[lane] ^ c_keys[lane];
+                lanes[lane ^ 1] += words[lane];
+                lanes[lane]     += (keyed & 0xFFFFFFFFull) * (keyed >> 32);
+            }
+        }
+        std::memcpy(v_lanes, lanes, sizeof(lanes));
+    }
+
+
+    static void scramble(std::uint64_t* v_lanes)
+    {
+        for (auto lane = 0; lane < 4; ++lane)
+        {
+            auto value = v_lanes[lane];
+            value ^= value >> 47;
+            value ^= c_keys[lane];
+            v_lanes[lane] = value * c_prime32;
+        }
+    }
+#endif
+
+
+    void Fingerprint::add_blocks(const unsigned char* p_address, std::size_t p_num_blocks)
+    {
+        static_assert(c_num_lanes == 4 && c_block_bytes == 32, "accumulate expects four lanes.");
+
+        while (p_num_blocks > 0)
+        {
+            const auto num_blocks = std::min<std::size_t>(p_num_blocks, c_blocks_per_scramble - d_num_blocks % c_blocks_per_scramble);
+            accumulate(d_lanes.data(), p_address, num_blocks);
+            d_num_blocks += num_blocks;
+            p_address    += num_blocks * c_block_bytes;
+            p_num_blocks -= num_blocks;
+
+            if (d_num_blocks % c_blocks_per_scramble == 0)
+                scramble(d_lanes.data());
+        }
+    }
+
+
+    std::uint64_t Fingerprint::value() const
+    {
+        auto result = rotate_left(d_lanes[0], 1) + rotate_left(d_lanes[1], 7) + rotate_left(d_lanes[2], 12) + rotate_left(d_lanes[3], 18);
+        for (auto lane: d_lanes)
+            result = (result ^ mix_word(0, lane)) * c_prime_1 + c_prime_4;
+
+        result += d_num_bytes;
+
+        // Bytes of an incomplete block.
+        std::size_t pos = 0;
+        for (; pos + sizeof(std::uint64_t) <= d_num_pending; pos += sizeof(std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, d_pending.data() + pos, sizeof(word));
+            result = rotate_left(result ^ mix_word(0, word), 27) * c_prime_1 + c_prime_4;
+        }
+        for (; pos < d_num_pending; ++pos)
+            result = rotate_left(result ^ (d_pending[pos] * c_prime_5), 11) * c_prime_1;
+
+        // Final avalanche.
+        result ^= result >> 33;
+        result *= c_prime_2;
+        result ^= result >> 29;
+        result *= c_prime_3;
+        result ^= result >> 32;
+        return result;
+    }
+
+
+    std::uint64_t model_fingerprint(const ILPData& p_data)
+    {
+        Fingerprint fingerprint;
+        fingerprint.add(p_data.matrix);
+        fingerprint.add(p_data.objective);
+        fingerprint.add(p_data.variable_lower);
+        fingerprint.add(p_data.variable_upper);
+        fingerprint.add(p_data.constraint_lower);
+        fingerprint.add(p_data.constraint_upper);
+        fingerprint.add(p_data.variable_type);
+        fingerprint.add(p_data.objective_sense);
+        fingerprint.add(p_data.max_abs_gap);
+        fingerprint.add(p_data.max_rel_gap);
+        return fingerprint.value();
+    }
+
+
+    std::uint64_t structure_fingerprint(const ILPData& p_data)
+    {
+        Fingerprint fingerprint;
+        fingerprint.add(p_data.matrix);
+        fingerprint.add(p_data.variable_type);
+        return fingerprint.value();
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ilp_data.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace ilp_solver
+{
+    /*********************************
+    * Streaming 64 bit hash of plain *
+    * old data types (POD types) and *
+    * vectors                        *
+    *********************************/
+    // The bytes are processed in blocks of 32 bytes by four independent 64-bit lanes, which are scrambled every 16 blocks.
+    // As in XXH3, every word is mixed by a 32 x 32 to 64 bit multiplication of its halves, which SSE2 does for two lanes
+    // per instruction. Without SSE2, the same value is computed with scalar code.
+    class Fingerprint
+    {
+        public:
+            template<typename POD_type>             void add(const POD_type& p_value);
+            template<typename POD_type>             void add(const std::vector<POD_type>& p_vector);
+            template<typename POD_type_or_vector>   void add(const std::vector< std::vector<POD_type_or_vector> >& p_vector_of_vectors);
+
+            void add_bytes(const void* p_address, std::size_t p_num_bytes);
+
+            std::uint64_t value() const;
+
+        private:
+            static constexpr std::size_t c_num_lanes           { 4 };
+            static constexpr std::size_t c_block_bytes         { c_num_lanes * sizeof(std::uint64_t) };
+            static constexpr std::size_t c_blocks_per_scramble { 16 };
+
+            std::array<std::uint64_t, c_num_lanes> d_lanes{ 0x60ea27eeadc0b5d6ull, 0xc2b2ae3d27d4eb4full, 0ull, 0x61c8864e7a143579ull };
+            std::array<unsigned char, c_block_bytes> d_pending{};
+            std::size_t   d_num_pending{ 0 };
+            std::uint64_t d_num_bytes  { 0 };
+            std::uint64_t d_num_blocks { 0 };
+
+            void add_blocks(const unsigned char* p_address, std::size_t p_num_blocks);
+    };
+
+
+    // Fingerprint of everything that determines the result of a solve:
+    // matrix, objective, bounds, variable types, objective sense and gap limits.
+    // Parameters that only influence the speed of the solve (threads, log level, start solution, ...) are ignored.
+    // Time, node and solution limits are ignored as well. Thus, only proven results should be reused.
+    std::uint64_t model_fingerprint(const ILPData& p_data);
+
+    // Fingerprint of the structure of the model: the matrix and the variable types.
+    // Models with the same structure differ at most in bounds, right-hand sides, objective and parameters.
+    std::uint64_t structure_fingerprint(const ILPData& p_data);
+
+
+    /*****************
+    * Implementation *
+    *****************/
+    template<typename POD_type>
+    void Fingerprint::add(const POD_type& p_value)
+    {
+        add_bytes(&p_value, sizeof(POD_type));
+    }
+
+
+    template<typename POD_type>
+    void Fingerprint::add(const std::vector<POD_type>& p_vector)
+    {
+        add(static_cast<std::uint64_t>(p_vector.size()));
+        add_bytes(p_vector.data(), p_vector.size()*sizeof(POD_type));
+    }
+
+
+    template<typename POD_type_or_vector>
+    void Fingerprint::add(const std::vector< std::vector<POD_type_or_vector> >& p_vector_of_vectors)
+    {
+        add(static_cast<std::uint64_t>(p_vector_of_vectors.size()));
+        for (const auto& vector: p_vector_of_vectors)
+            add(vector);
+    }
+}
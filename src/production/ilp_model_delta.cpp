@@ -0,0 +1,142 @@
+#include "ilp_model_delta.hpp"
+
+#include <algorithm>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    static int num_variables(const ILPData& p_data)
+    {
+        return static_cast<int>(p_data.variable_type.size());
+    }
+
+
+    static int num_constraints(const ILPData& p_data)
+    {
+        return static_cast<int>(p_data.constraint_lower.size());
+    }
+
+
+    static void add_changed_bounds_and_objective(const ILPData& p_old, const ILPData& p_new, ModelDelta* v_delta)
+    {
+        for (auto j = 0; j < num_variables(p_old); ++j)
+        {
+            if (p_new.variable_lower[j] != p_old.variable_lower[j] || p_new.variable_upper[j] != p_old.variable_upper[j])
+            {
+                v_delta->variable_indices.push_back(j);
+                v_delta->variable_lower  .push_back(p_new.variable_lower[j]);
+                v_delta->variable_upper  .push_back(p_new.variable_upper[j]);
+            }
+            if (p_new.objective[j] != p_old.objective[j])
+            {
+                v_delta->objective_indices.push_back(j);
+                v_delta->objective        .push_back(p_new.objective[j]);
+            }
+        }
+
+        for (auto i = 0; i < num_constraints(p_old); ++i)
+        {
+            if (p_new.constraint_lower[i] != p_old.constraint_lower[i] || p_new.constraint_upper[i] != p_old.constraint_upper[i])
+            {
+                v_delta->constraint_indices.push_back(i);
+                v_delta->constraint_lower  .push_back(p_new.constraint_lower[i]);
+                v_delta->constraint_upper  .push_back(p_new.constraint_upper[i]);
+            }
+        }
+    }
+
+
+    static void add_changed_coefficients(const ILPData& p_old, const ILPData& p_new, ModelDelta* v_delta)
+    {
+        for (auto i = 0; i < num_constraints(p_old); ++i)
+        {
+            const auto& old_row = p_old.matrix[i];
+            const auto& new_row = p_new.matrix[i];
+            for (auto j = 0; j < num_variables(p_old); ++j)
+            {
+                if (new_row[j] != old_row[j])
+                {
+                    v_delta->coefficient_rows   .push_back(i);
+                    v_delta->coefficient_columns.push_back(j);
+                    v_delta->coefficients       .push_back(new_row[j]);
+                }
+            }
+        }
+    }
+
+
+    static void add_new_variables(const ILPData& p_old, const ILPData& p_new, ModelDelta* v_delta)
+    {
+        for (auto j = num_variables(p_old); j < num_variables(p_new); ++j)
+        {
+            v_delta->new_variable_type     .push_back(p_new.variable_type[j]);
+            v_delta->new_variable_objective.push_back(p_new.objective[j]);
+            v_delta->new_variable_lower    .push_back(p_new.variable_lower[j]);
+            v_delta->new_variable_upper    .push_back(p_new.variable_upper[j]);
+
+            vector<int>    rows;
+            vector<double> values;
+            for (auto i = 0; i < num_constraints(p_old); ++i)
+            {
+                if (p_new.matrix[i][j] != 0.)
+                {
+                    rows  .push_back(i);
+                    values.push_back(p_new.matrix[i][j]);
+                }
+            }
+            v_delta->new_variable_rows  .push_back(std::move(rows));
+            v_delta->new_variable_values.push_back(std::move(values));
+        }
+    }
+
+
+    static void add_new_constraints(const ILPData& p_old, const ILPData& p_new, ModelDelta* v_delta)
+    {
+        for (auto i = num_constraints(p_old); i < num_constraints(p_new); ++i)
+        {
+            v_delta->new_constraint_lower.push_back(p_new.constraint_lower[i]);
+            v_delta->new_constraint_upper.push_back(p_new.constraint_upper[i]);
+
+            vector<int>    columns;
+            vector<double> values;
+            const auto& row = p_new.matrix[i];
+            for (auto j = 0; j < num_variables(p_new); ++j)
+            {
+                if (row[j] != 0.)
+                {
+                    columns.push_back(j);
+                    values .push_back(row[j]);
+                }
+            }
+            v_delta->new_constraint_columns.push_back(std::move(columns));
+            v_delta->new_constraint_values .push_back(std::move(values));
+        }
+    }
+
+
+    // Entries are compared by their indices. Thus, a model with deleted and appended variables or constraints
+    // may still be a delta, which then changes the entries that have moved.
+    bool compute_model_delta(const ILPData& p_old, const ILPData& p_new, bool p_matrix_changed, ModelDelta* r_delta)
+    {
+        if (num_variables(p_new) < num_variables(p_old) || num_constraints(p_new) < num_constraints(p_old))
+            return false;
+        if (!std::equal(p_old.variable_type.begin(), p_old.variable_type.end(), p_new.variable_type.begin()))
+            return false;
+        if (!p_old.start_solution.empty() && p_new.start_solution.empty())
+            return false;
+        if (!p_matrix_changed && (num_variables(p_new) != num_variables(p_old) || num_constraints(p_new) != num_constraints(p_old)))
+            return false;
+
+        *r_delta = ModelDelta();
+        r_delta->num_variables   = num_variables(p_new);
+        r_delta->num_constraints = num_constraints(p_new);
+
+        add_changed_bounds_and_objective(p_old, p_new, r_delta);
+        if (p_matrix_changed)
+            add_changed_coefficients(p_old, p_new, r_delta);
+        add_new_variables(p_old, p_new, r_delta);
+        add_new_constraints(p_old, p_new, r_delta);
+        return true;
+    }
+}
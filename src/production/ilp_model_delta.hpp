@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ilp_data.hpp"
+
+#include <vector>
+
+namespace ilp_solver
+{
+    // The changes from one model to another one that keeps all variables and constraints of the first one:
+    // changed bounds, objective and coefficients, and appended variables and constraints.
+    // Used by the stub to update the model of a solver process that has kept it since the previous solve (see ILPSolverStub).
+    // Objective sense, start solution and parameters are not part of the delta.
+    struct ModelDelta
+    {
+        // Of the new model.
+        int num_variables  { 0 };
+        int num_constraints{ 0 };
+
+        // Changed entries of the previous variables and constraints.
+        std::vector<int>    variable_indices;
+        std::vector<double> variable_lower;
+        std::vector<double> variable_upper;
+
+        std::vector<int>    objective_indices;
+        std::vector<double> objective;
+
+        std::vector<int>    constraint_indices;
+        std::vector<double> constraint_lower;
+        std::vector<double> constraint_upper;
+
+        std::vector<int>    coefficient_rows;
+        std::vector<int>    coefficient_columns;
+        std::vector<double> coefficients;
+
+        // Appended variables with their non-zero coefficients in the previous constraints.
+        std::vector<VariableType>        new_variable_type;
+        std::vector<double>              new_variable_objective;
+        std::vector<double>              new_variable_lower;
+        std::vector<double>              new_variable_upper;
+        std::vector<std::vector<int>>    new_variable_rows;
+        std::vector<std::vector<double>> new_variable_values;
+
+        // Appended constraints with their non-zero coefficients in all variables (including the appended ones).
+        std::vector<double>              new_constraint_lower;
+        std::vector<double>              new_constraint_upper;
+        std::vector<std::vector<int>>    new_constraint_columns;
+        std::vector<std::vector<double>> new_constraint_values;
+    };
+
+
+    // Returns false if p_new is no delta of p_old, i.e. if it has fewer variables or constraints,
+    // a previous variable has another type, or the start solution has been removed.
+    // The coefficients of the previous variables and constraints are only compared if p_matrix_changed.
+    bool compute_model_delta(const ILPData& p_old, const ILPData& p_new, bool p_matrix_changed, ModelDelta* r_delta);
+}
@@ -0,0 +1,116 @@
+#include "ilp_model_statistics.hpp"
+
+#include "ilp_data.hpp"
+#include "ilp_tolerance.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    namespace
+    {
+        void add_magnitude(MagnitudeRange* v_range, double p_value)
+        {
+            if (p_value == 0. || is_neg_inf(p_value) || is_pos_inf(p_value))
+                return;
+            const auto magnitude = std::abs(p_value);
+            v_range->min = std::min(v_range->min, magnitude);
+            v_range->max = std::max(v_range->max, magnitude);
+        }
+
+
+        int histogram_bucket(int p_num_non_zeros)
+        {
+            auto bucket = 0;
+            for (; p_num_non_zeros > 0; p_num_non_zeros >>= 1)
+                ++bucket;
+            return bucket;
+        }
+
+
+        void add_to_histogram(vector<int>* v_histogram, int p_num_non_zeros)
+        {
+            const auto bucket = histogram_bucket(p_num_non_zeros);
+            if (bucket >= static_cast<int>(v_histogram->size()))
+                v_histogram->resize(bucket + 1, 0);
+            ++(*v_histogram)[bucket];
+        }
+
+
+        void add_variable_statistics(ModelStatistics* v_statistics, const ILPData& p_data)
+        {
+            for (auto j = 0; j < v_statistics->num_variables; ++j)
+            {
+                switch (p_data.variable_type[j])
+                {
+                case VariableType::BINARY:     ++v_statistics->num_binary_variables;     break;
+                case VariableType::INTEGER:    ++v_statistics->num_integer_variables;    break;
+                case VariableType::CONTINUOUS: ++v_statistics->num_continuous_variables; break;
+                }
+
+                add_magnitude(&v_statistics->objective_range,      p_data.objective[j]);
+                add_magnitude(&v_statistics->variable_bound_range, p_data.variable_lower[j]);
+                add_magnitude(&v_statistics->variable_bound_range, p_data.variable_upper[j]);
+            }
+        }
+
+
+        void add_constraint_bound_statistics(ModelStatistics* v_statistics, double p_lower, double p_upper)
+        {
+            add_magnitude(&v_statistics->rhs_range, p_lower);
+            add_magnitude(&v_statistics->rhs_range, p_upper);
+
+            const auto lower_finite = !is_neg_inf(p_lower);
+            const auto upper_finite = !is_pos_inf(p_upper);
+            if      (lower_finite && upper_finite) ++(p_lower == p_upper ? v_statistics->num_equality_constraints : v_statistics->num_range_constraints);
+            else if (lower_finite || upper_finite) ++v_statistics->num_one_sided_constraints;
+            else                                   ++v_statistics->num_free_constraints;
+        }
+    }
+
+
+    // The matrix is dense and row-major. The inner loop over a row is scalar code without branches:
+    // zeros are mapped to neutral values of the min and max.
+    ModelStatistics model_statistics(const ILPData& p_data)
+    {
+        ModelStatistics statistics;
+        statistics.num_variables   = static_cast<int>(p_data.variable_type.size());
+        statistics.num_constraints = static_cast<int>(p_data.matrix.size());
+
+        add_variable_statistics(&statistics, p_data);
+
+        const auto num_variables = statistics.num_variables;
+        vector<int> column_non_zeros(num_variables, 0);
+        for (auto i = 0; i < statistics.num_constraints; ++i)
+        {
+            const auto* row = p_data.matrix[i].data();
+
+            auto num_non_zeros = 0;
+            auto min_magnitude = std::numeric_limits<double>::max();
+            auto max_magnitude = 0.;
+            for (auto j = 0; j < num_variables; ++j)
+            {
+                const auto magnitude = std::abs(row[j]);
+                const auto non_zero  = (magnitude != 0.);
+                num_non_zeros       += non_zero;
+                column_non_zeros[j] += non_zero;
+                min_magnitude = std::min(min_magnitude, non_zero ? magnitude : std::numeric_limits<double>::max());
+                max_magnitude = std::max(max_magnitude, magnitude);
+            }
+
+            statistics.num_non_zeros += num_non_zeros;
+            statistics.coefficient_range.min = std::min(statistics.coefficient_range.min, min_magnitude);
+            statistics.coefficient_range.max = std::max(statistics.coefficient_range.max, max_magnitude);
+            add_to_histogram(&statistics.row_non_zero_histogram, num_non_zeros);
+
+            add_constraint_bound_statistics(&statistics, p_data.constraint_lower[i], p_data.constraint_upper[i]);
+        }
+
+        for (auto num_non_zeros: column_non_zeros)
+            add_to_histogram(&statistics.column_non_zero_histogram, num_non_zeros);
+        return statistics;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+namespace ilp_solver
+{
+    struct ILPData;
+
+
+    // Range of the absolute values of the non-zero, finite entries. min > max if there are none.
+    struct MagnitudeRange
+    {
+        double min{ std::numeric_limits<double>::max() };
+        double max{ 0. };
+
+        bool empty() const { return min > max; }
+    };
+
+
+    struct ModelStatistics
+    {
+        int num_variables  { 0 };
+        int num_constraints{ 0 };
+
+        int num_binary_variables    { 0 };
+        int num_integer_variables   { 0 };
+        int num_continuous_variables{ 0 };
+
+        long long num_non_zeros{ 0 };
+
+        // Entry 0 counts the rows (columns) without non-zeros,
+        // entry k > 0 those with 2^(k-1) <= number of non-zeros < 2^k.
+        std::vector<int> row_non_zero_histogram;
+        std::vector<int> column_non_zero_histogram;
+
+        MagnitudeRange coefficient_range;
+        MagnitudeRange objective_range;
+        MagnitudeRange variable_bound_range;
+        MagnitudeRange rhs_range;
+
+        int num_equality_constraints { 0 };
+        int num_range_constraints    { 0 };   // Finite and different lower and upper bound
+        int num_one_sided_constraints{ 0 };
+        int num_free_constraints     { 0 };   // Neither bound is finite
+    };
+
+
+    // Computes the statistics with one pass over the matrix.
+    // Is used by ILPSolverCollect::get_model_statistics.
+    ModelStatistics model_statistics(const ILPData& p_data);
+}
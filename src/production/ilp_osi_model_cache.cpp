@@ -0,0 +1,367 @@
+#if WITH_OSI == 1
+
+#include "ilp_osi_model_cache.hpp"
+#include "ilp_solver_impl.hpp"
+
+#pragma warning(push)
+#pragma warning(disable : 4309) // silence warning in CBC concerning truncations of constant values in 64 bit.
+#include "CoinMpsIO.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#pragma warning(pop)
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+
+using std::string;
+using std::vector;
+
+namespace ilp_solver
+{
+    namespace
+    {
+        // Spaces are problematic when printing to mps.
+        string mps_name(const string& p_name, char p_prefix, int p_index)
+        {
+            if (p_name.empty())
+            {
+                char default_name[16];
+                std::snprintf(default_name, sizeof(default_name), "%c%07d", p_prefix, p_index);
+                return default_name;
+            }
+
+            auto name = p_name;
+            std::replace(name.begin(), name.end(), ' ', '_');
+            return name;
+        }
+
+
+        // Copies the lines [p_first, p_first + p_num_lines) of a compressed matrix, with starts relative to the copy.
+        void copy_lines(const vector<CoinBigIndex>& p_starts, const vector<int>& p_indices, const vector<double>& p_values,
+                        int p_first, int p_num_lines,
+                        vector<CoinBigIndex>* r_starts, vector<int>* r_indices, vector<double>* r_values)
+        {
+            const auto begin = p_starts[p_first];
+            const auto end   = p_starts[p_first + p_num_lines];
+
+            r_starts->resize(p_num_lines + 1);
+            for (auto k = 0; k <= p_num_lines; ++k)
+                (*r_starts)[k] = p_starts[p_first + k] - begin;
+            r_indices->assign(p_indices.begin() + begin, p_indices.begin() + end);
+            r_values ->assign(p_values .begin() + begin, p_values .begin() + end);
+        }
+
+
+        // Inserts a non-zero at the end of line p_line of a compressed matrix.
+        void insert_non_zero(vector<CoinBigIndex>* v_starts, vector<int>* v_indices, vector<double>* v_values,
+                             int p_line, int p_index, double p_value)
+        {
+            const auto position = (*v_starts)[p_line + 1];
+            v_indices->insert(v_indices->begin() + position, p_index);
+            v_values ->insert(v_values ->begin() + position, p_value);
+            for (auto k = p_line + 1; k < static_cast<int>(v_starts->size()); ++k)
+                ++(*v_starts)[k];
+        }
+
+
+        // Returns the position of p_index in line p_line of a compressed matrix, or -1.
+        CoinBigIndex find_non_zero(const vector<CoinBigIndex>& p_starts, const vector<int>& p_indices, int p_line, int p_index)
+        {
+            for (auto k = p_starts[p_line]; k < p_starts[p_line + 1]; ++k)
+                if (p_indices[k] == p_index)
+                    return k;
+            return -1;
+        }
+
+
+        // Removes the lines mapped to -1 from a compressed matrix.
+        void delete_lines(vector<CoinBigIndex>* v_starts, vector<int>* v_indices, vector<double>* v_values, const vector<int>& p_line_mapping)
+        {
+            // The kept lines only move to the front, so the end of each line is read before its entry in v_starts is overwritten.
+            CoinBigIndex position = 0;
+            auto         begin    = (*v_starts)[0];
+            auto         num_kept = 0;
+            for (auto line = 0; line < static_cast<int>(p_line_mapping.size()); ++line)
+            {
+                const auto end = (*v_starts)[line + 1];
+                if (p_line_mapping[line] >= 0)
+                {
+                    for (auto k = begin; k < end; ++k, ++position)
+                    {
+                        (*v_indices)[position] = (*v_indices)[k];
+                        (*v_values) [position] = (*v_values) [k];
+                    }
+                    (*v_starts)[++num_kept] = position;
+                }
+                begin = end;
+            }
+            v_starts ->resize(num_kept + 1);
+            v_indices->resize(position);
+            v_values ->resize(position);
+        }
+
+
+        // Removes the non-zeros whose index is mapped to -1 from a compressed matrix and renumbers the others.
+        void delete_indices(vector<CoinBigIndex>* v_starts, vector<int>* v_indices, vector<double>* v_values, const vector<int>& p_index_mapping)
+        {
+            CoinBigIndex position = 0;
+            auto         begin    = (*v_starts)[0];
+            for (auto line = 0; line + 1 < static_cast<int>(v_starts->size()); ++line)
+            {
+                const auto end = (*v_starts)[line + 1];
+                for (auto k = begin; k < end; ++k)
+                {
+                    const auto new_index = p_index_mapping[(*v_indices)[k]];
+                    if (new_index < 0)
+                        continue;
+                    (*v_indices)[position]   = new_index;
+                    (*v_values) [position++] = (*v_values)[k];
+                }
+                (*v_starts)[line + 1] = position;
+                begin = end;
+            }
+            v_indices->resize(position);
+            v_values ->resize(position);
+        }
+
+
+        void set_integers(OsiSolverInterface* v_solver, const vector<char>& p_is_integer, int p_first_column)
+        {
+            vector<int> integer_columns;
+            for (auto j = p_first_column; j < static_cast<int>(p_is_integer.size()); ++j)
+                if (p_is_integer[j])
+                    integer_columns.push_back(j);
+            if (!integer_columns.empty())
+                v_solver->setInteger(integer_columns.data(), static_cast<int>(integer_columns.size()));
+        }
+    }
+
+
+    void OsiModelCache::add_column(int p_num_non_zeros, const int* p_row_indices, const double* p_values,
+                                   double p_lower_bound, double p_upper_bound, double p_objective, bool p_integer, const string& p_name)
+    {
+        d_column_indices.insert(d_column_indices.end(), p_row_indices, p_row_indices + p_num_non_zeros);
+        d_column_values .insert(d_column_values .end(), p_values,      p_values      + p_num_non_zeros);
+        d_column_starts.push_back(static_cast<CoinBigIndex>(d_column_values.size()));
+
+        d_column_lower.push_back(p_lower_bound);
+        d_column_upper.push_back(p_upper_bound);
+        d_objective   .push_back(p_objective);
+        d_is_integer  .push_back(p_integer ? 1 : 0);
+
+        // Names are only stored once the first one is given.
+        if (!p_name.empty() || !d_column_names.empty())
+        {
+            d_column_names.resize(num_columns());
+            d_column_names.back() = p_name;
+        }
+    }
+
+
+    void OsiModelCache::add_row(int p_num_non_zeros, const int* p_column_indices, const double* p_values,
+                                double p_lower_bound, double p_upper_bound, const string& p_name)
+    {
+        d_row_indices.insert(d_row_indices.end(), p_column_indices, p_column_indices + p_num_non_zeros);
+        d_row_values .insert(d_row_values .end(), p_values,         p_values         + p_num_non_zeros);
+        d_row_starts.push_back(static_cast<CoinBigIndex>(d_row_values.size()));
+
+        d_row_lower.push_back(p_lower_bound);
+        d_row_upper.push_back(p_upper_bound);
+
+        if (!p_name.empty() || !d_row_names.empty())
+        {
+            d_row_names.resize(num_rows());
+            d_row_names.back() = p_name;
+        }
+    }
+
+
+    void OsiModelCache::set_column_bounds(int p_column_index, double p_lower_bound, double p_upper_bound)
+    {
+        d_column_lower[p_column_index] = p_lower_bound;
+        d_column_upper[p_column_index] = p_upper_bound;
+    }
+
+
+    void OsiModelCache::set_row_bounds(int p_row_index, double p_lower_bound, double p_upper_bound)
+    {
+        d_row_lower[p_row_index] = p_lower_bound;
+        d_row_upper[p_row_index] = p_upper_bound;
+    }
+
+
+    void OsiModelCache::set_column_objective(int p_column_index, double p_objective)
+    {
+        d_objective[p_column_index] = p_objective;
+    }
+
+
+    void OsiModelCache::set_coefficient(int p_row_index, int p_column_index, double p_value, bool p_store_with_row)
+    {
+        if (const auto k = find_non_zero(d_column_starts, d_column_indices, p_column_index, p_row_index); k >= 0)
+            d_column_values[k] = p_value;
+        else if (const auto l = find_non_zero(d_row_starts, d_row_indices, p_row_index, p_column_index); l >= 0)
+            d_row_values[l] = p_value;
+        else if (p_value != 0.)
+        {
+            if (p_store_with_row)
+                insert_non_zero(&d_row_starts,    &d_row_indices,    &d_row_values,    p_row_index,    p_column_index, p_value);
+            else
+                insert_non_zero(&d_column_starts, &d_column_indices, &d_column_values, p_column_index, p_row_index,    p_value);
+        }
+    }
+
+
+    void OsiModelCache::delete_rows(const vector<int>& p_row_mapping)
+    {
+        delete_lines  (&d_row_starts,    &d_row_indices,    &d_row_values,    p_row_mapping);
+        delete_indices(&d_column_starts, &d_column_indices, &d_column_values, p_row_mapping);
+
+        compact(&d_row_lower, p_row_mapping);
+        compact(&d_row_upper, p_row_mapping);
+        compact(&d_row_names, p_row_mapping);
+    }
+
+
+    void OsiModelCache::delete_columns(const vector<int>& p_column_mapping)
+    {
+        delete_lines  (&d_column_starts, &d_column_indices, &d_column_values, p_column_mapping);
+        delete_indices(&d_row_starts,    &d_row_indices,    &d_row_values,    p_column_mapping);
+
+        compact(&d_column_lower, p_column_mapping);
+        compact(&d_column_upper, p_column_mapping);
+        compact(&d_objective,    p_column_mapping);
+        compact(&d_is_integer,   p_column_mapping);
+        compact(&d_column_names, p_column_mapping);
+    }
+
+
+    void OsiModelCache::load(OsiSolverInterface* v_solver, bool p_keep_solution) const
+    {
+        vector<double> solution;
+        if (p_keep_solution && v_solver->getNumCols() == num_columns() && v_solver->getColSolution())
+            solution.assign(v_solver->getColSolution(), v_solver->getColSolution() + num_columns());
+
+        vector<CoinBigIndex> starts;
+        vector<int>          indices;
+        vector<double>       values;
+        build_column_major(&starts, &indices, &values);
+
+        v_solver->loadProblem(num_columns(), num_rows(), starts.data(), indices.data(), values.data(),
+                              d_column_lower.data(), d_column_upper.data(), d_objective.data(),
+                              d_row_lower.data(), d_row_upper.data());
+        set_integers(v_solver, d_is_integer, 0);
+
+        if (!solution.empty())
+            v_solver->setColSolution(solution.data());
+    }
+
+
+    void OsiModelCache::append_rows(OsiSolverInterface* v_solver, int p_first_row) const
+    {
+        const auto num_new_rows = num_rows() - p_first_row;
+        if (num_new_rows <= 0)
+            return;
+
+        vector<CoinBigIndex> starts;
+        vector<int>          indices;
+        vector<double>       values;
+        copy_lines(d_row_starts, d_row_indices, d_row_values, p_first_row, num_new_rows, &starts, &indices, &values);
+
+        v_solver->addRows(num_new_rows, starts.data(), indices.data(), values.data(),
+                          d_row_lower.data() + p_first_row, d_row_upper.data() + p_first_row);
+    }
+
+
+    void OsiModelCache::append_columns(OsiSolverInterface* v_solver, int p_first_column) const
+    {
+        const auto num_new_columns = num_columns() - p_first_column;
+        if (num_new_columns <= 0)
+            return;
+
+        vector<CoinBigIndex> starts;
+        vector<int>          indices;
+        vector<double>       values;
+        copy_lines(d_column_starts, d_column_indices, d_column_values, p_first_column, num_new_columns, &starts, &indices, &values);
+
+        v_solver->addCols(num_new_columns, starts.data(), indices.data(), values.data(),
+                          d_column_lower.data() + p_first_column, d_column_upper.data() + p_first_column,
+                          d_objective.data() + p_first_column);
+        set_integers(v_solver, d_is_integer, p_first_column);
+    }
+
+
+    void OsiModelCache::write_mps(const string& p_filename) const
+    {
+        vector<CoinBigIndex> starts;
+        vector<int>          indices;
+        vector<double>       values;
+        build_column_major(&starts, &indices, &values);
+
+        vector<int> lengths(num_columns());
+        for (auto j = 0; j < num_columns(); ++j)
+            lengths[j] = static_cast<int>(starts[j + 1] - starts[j]);
+        const CoinPackedMatrix matrix(true, num_rows(), num_columns(), static_cast<CoinBigIndex>(values.size()),
+                                      values.data(), indices.data(), starts.data(), lengths.data());
+
+        vector<string> column_names(num_columns());
+        vector<string> row_names   (num_rows());
+        for (auto j = 0; j < num_columns(); ++j)
+            column_names[j] = mps_name(d_column_names.empty() ? string() : d_column_names[j], 'C', j);
+        for (auto i = 0; i < num_rows(); ++i)
+            row_names[i] = mps_name(d_row_names.empty() ? string() : d_row_names[i], 'R', i);
+
+        CoinMpsIO mps_writer;
+        mps_writer.setMpsData(matrix, DBL_MAX, d_column_lower.data(), d_column_upper.data(), d_objective.data(),
+                              d_is_integer.data(), d_row_lower.data(), d_row_upper.data(), column_names, row_names);
+
+        // path,
+        // compression (off),
+        // format (extra precision),
+        // number of values per dataline (1 or 2).
+        if (mps_writer.writeMps(p_filename.c_str(), 0, 1, 1))
+            throw std::exception("Could not write mps file.");
+    }
+
+
+    // Counts the non-zeros per column first, so that every array is allocated exactly once.
+    void OsiModelCache::build_column_major(vector<CoinBigIndex>* r_starts, vector<int>* r_indices, vector<double>* r_values) const
+    {
+        const auto num_non_zeros = d_column_values.size() + d_row_values.size();
+
+        r_starts->assign(num_columns() + 1, 0);
+        for (auto j = 0; j < num_columns(); ++j)
+            (*r_starts)[j + 1] = d_column_starts[j + 1] - d_column_starts[j];
+        for (auto column: d_row_indices)
+            ++(*r_starts)[column + 1];
+        for (auto j = 0; j < num_columns(); ++j)
+            (*r_starts)[j + 1] += (*r_starts)[j];
+
+        r_indices->resize(num_non_zeros);
+        r_values ->resize(num_non_zeros);
+
+        // The non-zeros given with a column are in rows that existed before the column,
+        // those given with the rows are in later rows. Copying them in this order keeps the rows roughly ordered.
+        vector<CoinBigIndex> position(r_starts->begin(), r_starts->end() - 1);
+        for (auto j = 0; j < num_columns(); ++j)
+        {
+            for (auto k = d_column_starts[j]; k < d_column_starts[j + 1]; ++k)
+            {
+                (*r_indices)[position[j]  ] = d_column_indices[k];
+                (*r_values) [position[j]++] = d_column_values [k];
+            }
+        }
+        for (auto i = 0; i < num_rows(); ++i)
+        {
+            for (auto k = d_row_starts[i]; k < d_row_starts[i + 1]; ++k)
+            {
+                const auto j = d_row_indices[k];
+                (*r_indices)[position[j]  ] = i;
+                (*r_values) [position[j]++] = d_row_values[k];
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#if WITH_OSI == 1
+
+#include "CoinTypes.hpp"
+
+#include <string>
+#include <vector>
+
+class OsiSolverInterface;
+
+
+namespace ilp_solver
+{
+    // Stores the model of an ILPSolverOsiModel in contiguous arrays, so that it can be passed
+    // to an OsiSolverInterface with a single loadProblem (instead of via a CoinModel).
+    // The non-zeros given with a column are stored column-major, those given with a row are stored row-major.
+    // Thus, adding a column or a row only appends to arrays.
+    // Each non-zero is stored only once: A column can only have non-zeros in rows that exist already, and vice versa.
+    class OsiModelCache
+    {
+        public:
+            int num_rows   () const { return static_cast<int>(d_row_lower.size()); }
+            int num_columns() const { return static_cast<int>(d_column_lower.size()); }
+
+            void add_column(int p_num_non_zeros, const int* p_row_indices, const double* p_values,
+                            double p_lower_bound, double p_upper_bound, double p_objective, bool p_integer, const std::string& p_name);
+            void add_row   (int p_num_non_zeros, const int* p_column_indices, const double* p_values,
+                            double p_lower_bound, double p_upper_bound, const std::string& p_name);
+
+            void set_column_bounds   (int p_column_index, double p_lower_bound, double p_upper_bound);
+            void set_row_bounds      (int p_row_index,    double p_lower_bound, double p_upper_bound);
+            void set_column_objective(int p_column_index, double p_objective);
+
+            // Replaces the non-zero if it is stored already. Otherwise, it is inserted with the row if p_store_with_row is set,
+            // and with the column otherwise, which takes time linear in the number of non-zeros.
+            void set_coefficient     (int p_row_index, int p_column_index, double p_value, bool p_store_with_row);
+
+            // Remove the rows (columns) mapped to -1 and renumber the others as given by the mapping
+            // (see ILPSolverInterface::delete_constraints). Takes time linear in the size of the cache.
+            void delete_rows   (const std::vector<int>& p_row_mapping);
+            void delete_columns(const std::vector<int>& p_column_mapping);
+
+            // Replaces the model of the solver by the cached one.
+            // If p_keep_solution is set and the number of columns does not change, the column solution of the solver is kept.
+            void load(OsiSolverInterface* v_solver, bool p_keep_solution) const;
+
+            // Appends the rows (columns) from p_first_row (p_first_column) on to the solver.
+            // The solver must contain all other rows and columns of the cache.
+            void append_rows   (OsiSolverInterface* v_solver, int p_first_row)    const;
+            void append_columns(OsiSolverInterface* v_solver, int p_first_column) const;
+
+            // Throws if the file could not be written.
+            void write_mps(const std::string& p_filename) const;
+
+        private:
+            // Non-zeros given with the columns. d_column_indices are row indices.
+            std::vector<CoinBigIndex> d_column_starts{ 0 };
+            std::vector<int>          d_column_indices;
+            std::vector<double>       d_column_values;
+
+            // Non-zeros given with the rows. d_row_indices are column indices.
+            std::vector<CoinBigIndex> d_row_starts{ 0 };
+            std::vector<int>          d_row_indices;
+            std::vector<double>       d_row_values;
+
+            std::vector<double> d_column_lower;
+            std::vector<double> d_column_upper;
+            std::vector<double> d_objective;
+            std::vector<char>   d_is_integer;
+
+            std::vector<double> d_row_lower;
+            std::vector<double> d_row_upper;
+
+            // Only used for writing mps files. Empty names are replaced by default names there.
+            std::vector<std::string> d_column_names;
+            std::vector<std::string> d_row_names;
+
+            // Merges both parts of the matrix into one column-major matrix.
+            void build_column_major(std::vector<CoinBigIndex>* r_starts, std::vector<int>* r_indices, std::vector<double>* r_values) const;
+    };
+}
+
+#endif
@@ -0,0 +1,412 @@
+#include "ilp_presolve.hpp"
+
+#include "ilp_tolerance.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    namespace
+    {
+        // Presolve stops after this many rounds, even if there are further reductions.
+        constexpr int c_max_presolve_rounds{ 20 };
+
+
+
+        // Bounds of p_scale * x for p_lower <= x <= p_upper.
+        std::pair<double, double> scale_bounds(double p_lower, double p_upper, double p_scale)
+        {
+            if (p_scale < 0.)
+                return { is_pos_inf(p_upper) ? c_neg_inf : p_upper * p_scale,
+                         is_neg_inf(p_lower) ? c_pos_inf : p_lower * p_scale };
+            return { is_neg_inf(p_lower) ? c_neg_inf : p_lower * p_scale,
+                     is_pos_inf(p_upper) ? c_pos_inf : p_upper * p_scale };
+        }
+
+
+        class Presolver
+        {
+            public:
+                explicit Presolver(const ILPData& p_data);
+
+                PresolvedModel run();
+
+            private:
+                const ILPData& d_data;
+
+                int d_num_variables;
+                int d_num_constraints;
+
+                // Current bounds. Constraint bounds do not contain the activity of fixed variables.
+                vector<double> d_variable_lower;
+                vector<double> d_variable_upper;
+                vector<double> d_constraint_lower;
+                vector<double> d_constraint_upper;
+
+                vector<bool> d_variable_active;
+                vector<bool> d_constraint_active;
+
+                vector<double> d_fixed_values;
+                double         d_objective_offset{ 0. };
+                bool           d_infeasible{ false };
+
+                PresolveStatistics d_statistics;
+
+                bool is_integer(int p_variable_index) const;
+
+                void fix_variable(int p_variable_index, double p_value);
+                bool tighten_variable_bounds(int p_variable_index, double p_lower_bound, double p_upper_bound);
+
+                bool reduce_variables();
+                bool reduce_constraints();
+                bool reduce_duplicate_constraints();
+                bool reduce_empty_columns();
+
+                PresolvedModel create_result(int p_num_rounds) const;
+        };
+
+
+        Presolver::Presolver(const ILPData& p_data)
+            : d_data(p_data),
+              d_num_variables(static_cast<int>(p_data.variable_type.size())),
+              d_num_constraints(static_cast<int>(p_data.matrix.size())),
+              d_variable_lower(p_data.variable_lower),
+              d_variable_upper(p_data.variable_upper),
+              d_constraint_lower(p_data.constraint_lower),
+              d_constraint_upper(p_data.constraint_upper),
+              d_variable_active(d_num_variables, true),
+              d_constraint_active(d_num_constraints, true),
+              d_fixed_values(d_num_variables, 0.)
+        { }
+
+
+        PresolvedModel Presolver::run()
+        {
+            const auto propagated_bounds = propagate_bounds(d_data);
+            d_statistics.propagation = propagated_bounds.statistics;
+            if (propagated_bounds.infeasible)
+            {
+                d_infeasible = true;
+                return create_result(0);
+            }
+
+            d_variable_lower = propagated_bounds.variable_lower;
+            d_variable_upper = propagated_bounds.variable_upper;
+            for (auto i = 0; i < d_num_constraints; ++i)
+                d_constraint_active[i] = !propagated_bounds.redundant_constraint[i];
+
+            auto num_rounds = 0;
+            auto changed    = true;
+            while (changed && !d_infeasible && num_rounds < c_max_presolve_rounds)
+            {
+                ++num_rounds;
+                changed = reduce_variables();
+                if (!d_infeasible) changed |= reduce_constraints();
+                if (!d_infeasible) changed |= reduce_duplicate_constraints();
+                if (!d_infeasible) changed |= reduce_empty_columns();
+            }
+            return create_result(num_rounds);
+        }
+
+
+        bool Presolver::is_integer(int p_variable_index) const
+        {
+            return d_data.variable_type[p_variable_index] != VariableType::CONTINUOUS;
+        }
+
+
+        // Moves the activity of the variable into the constraint bounds.
+        void Presolver::fix_variable(int p_variable_index, double p_value)
+        {
+            d_variable_active[p_variable_index] = false;
+            d_fixed_values   [p_variable_index] = p_value;
+            d_objective_offset += d_data.objective[p_variable_index] * p_value;
+
+            for (auto i = 0; i < d_num_constraints; ++i)
+            {
+                const auto coefficient = d_data.matrix[i][p_variable_index];
+                if (!d_constraint_active[i] || coefficient == 0.)
+                    continue;
+
+                if (!is_neg_inf(d_constraint_lower[i])) d_constraint_lower[i] -= coefficient * p_value;
+                if (!is_pos_inf(d_constraint_upper[i])) d_constraint_upper[i] -= coefficient * p_value;
+            }
+        }
+
+
+        // Returns whether a bound has been tightened.
+        bool Presolver::tighten_variable_bounds(int p_variable_index, double p_lower_bound, double p_upper_bound)
+        {
+            if (is_integer(p_variable_index))
+            {
+                if (!is_neg_inf(p_lower_bound)) p_lower_bound = std::ceil (p_lower_bound - c_feasibility_tolerance);
+                if (!is_pos_inf(p_upper_bound)) p_upper_bound = std::floor(p_upper_bound + c_feasibility_tolerance);
+            }
+
+            auto changed = false;
+            if (p_lower_bound > d_variable_lower[p_variable_index])
+            {
+                d_variable_lower[p_variable_index] = p_lower_bound;
+                changed = true;
+            }
+            if (p_upper_bound < d_variable_upper[p_variable_index])
+            {
+                d_variable_upper[p_variable_index] = p_upper_bound;
+                changed = true;
+            }
+
+            if (d_variable_lower[p_variable_index] > d_variable_upper[p_variable_index] + feasibility_tolerance(d_variable_upper[p_variable_index]))
+                d_infeasible = true;
+            return changed;
+        }
+
+
+        // Rounds integer bounds and removes fixed variables.
+        bool Presolver::reduce_variables()
+        {
+            auto changed = false;
+            for (auto j = 0; j < d_num_variables && !d_infeasible; ++j)
+            {
+                if (!d_variable_active[j])
+                    continue;
+
+                changed |= tighten_variable_bounds(j, d_variable_lower[j], d_variable_upper[j]);
+                if (!d_infeasible && d_variable_upper[j] <= d_variable_lower[j])
+                {
+                    fix_variable(j, d_variable_lower[j]);
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+
+        // Removes empty, singleton and redundant constraints.
+        bool Presolver::reduce_constraints()
+        {
+            auto changed = false;
+            for (auto i = 0; i < d_num_constraints && !d_infeasible; ++i)
+            {
+                if (!d_constraint_active[i])
+                    continue;
+
+                const auto& row   = d_data.matrix[i];
+                const auto  lower = d_constraint_lower[i];
+                const auto  upper = d_constraint_upper[i];
+
+                auto num_non_zeros = 0;
+                auto last_index    = -1;
+
+                // Bounds of the activity. Infinite contributions are counted instead of summed up.
+                double min_activity{ 0. };
+                double max_activity{ 0. };
+                auto num_neg_inf_contributions = 0;
+                auto num_pos_inf_contributions = 0;
+
+                for (auto j = 0; j < d_num_variables; ++j)
+                {
+                    const auto coefficient = row[j];
+                    if (!d_variable_active[j] || coefficient == 0.)
+                        continue;
+
+                    ++num_non_zeros;
+                    last_index = j;
+
+                    const auto min_bound = (coefficient > 0.) ? d_variable_lower[j] : d_variable_upper[j];
+                    const auto max_bound = (coefficient > 0.) ? d_variable_upper[j] : d_variable_lower[j];
+                    if (is_neg_inf(min_bound) || is_pos_inf(min_bound)) ++num_neg_inf_contributions;
+                    else                                                 min_activity += coefficient * min_bound;
+                    if (is_neg_inf(max_bound) || is_pos_inf(max_bound)) ++num_pos_inf_contributions;
+                    else                                                 max_activity += coefficient * max_bound;
+                }
+
+                if (num_non_zeros == 0)
+                {
+                    if (lower > feasibility_tolerance(lower) || upper < -feasibility_tolerance(upper))
+                        d_infeasible = true;
+                }
+                else if (num_non_zeros == 1)
+                {
+                    const auto [variable_lower, variable_upper] = scale_bounds(lower, upper, 1. / row[last_index]);
+                    tighten_variable_bounds(last_index, variable_lower, variable_upper);
+                }
+                else
+                {
+                    const auto min_finite = (num_neg_inf_contributions == 0);
+                    const auto max_finite = (num_pos_inf_contributions == 0);
+                    if ((min_finite && min_activity > upper + feasibility_tolerance(upper)) || (max_finite && max_activity < lower - feasibility_tolerance(lower)))
+                        d_infeasible = true;
+
+                    // Without tolerance: Dropping the constraint must not allow any violation.
+                    const auto lower_redundant = is_neg_inf(lower) || (min_finite && min_activity >= lower);
+                    const auto upper_redundant = is_pos_inf(upper) || (max_finite && max_activity <= upper);
+                    if (!lower_redundant || !upper_redundant)
+                        continue;
+                }
+
+                d_constraint_active[i] = false;
+                changed = true;
+            }
+            return changed;
+        }
+
+
+        // Of several constraints that are multiples of each other, keeps the first with the intersection of all bounds.
+        bool Presolver::reduce_duplicate_constraints()
+        {
+            // The rows are normalized such that their first non-zero is 1.
+            // Maps each normalized row to the first constraint with this row and its scaling factor.
+            std::map<vector<std::pair<int, double>>, std::pair<int, double>> first_constraint_of_row;
+
+            auto changed = false;
+            vector<std::pair<int, double>> normalized_row;
+            for (auto i = 0; i < d_num_constraints && !d_infeasible; ++i)
+            {
+                if (!d_constraint_active[i])
+                    continue;
+
+                const auto& row = d_data.matrix[i];
+                normalized_row.clear();
+                auto scale = 0.;
+                for (auto j = 0; j < d_num_variables; ++j)
+                {
+                    if (!d_variable_active[j] || row[j] == 0.)
+                        continue;
+                    if (scale == 0.)
+                        scale = 1. / row[j];
+                    normalized_row.emplace_back(j, row[j] * scale);
+                }
+
+                const auto [position, inserted] = first_constraint_of_row.emplace(normalized_row, std::pair{ i, scale });
+                if (inserted)
+                    continue;
+
+                // Transform the bounds of constraint i into the scale of the first constraint.
+                const auto [first, first_scale] = position->second;
+                const auto [normalized_lower, normalized_upper] = scale_bounds(d_constraint_lower[i], d_constraint_upper[i], scale);
+                const auto [lower, upper] = scale_bounds(normalized_lower, normalized_upper, 1. / first_scale);
+
+                d_constraint_lower[first] = std::max(d_constraint_lower[first], lower);
+                d_constraint_upper[first] = std::min(d_constraint_upper[first], upper);
+                if (d_constraint_lower[first] > d_constraint_upper[first] + feasibility_tolerance(d_constraint_upper[first]))
+                    d_infeasible = true;
+
+                d_constraint_active[i] = false;
+                changed = true;
+            }
+            return changed;
+        }
+
+
+        // Fixes variables that do not appear in any constraint at the bound that is best for the objective.
+        bool Presolver::reduce_empty_columns()
+        {
+            const auto sense = (d_data.objective_sense == ObjectiveSense::MINIMIZE) ? 1. : -1.;
+
+            auto changed = false;
+            for (auto j = 0; j < d_num_variables; ++j)
+            {
+                if (!d_variable_active[j])
+                    continue;
+
+                auto empty = true;
+                for (auto i = 0; i < d_num_constraints && empty; ++i)
+                    empty = !d_constraint_active[i] || d_data.matrix[i][j] == 0.;
+                if (!empty)
+                    continue;
+
+                const auto objective = sense * d_data.objective[j];
+                const auto lower     = d_variable_lower[j];
+                const auto upper     = d_variable_upper[j];
+
+                auto value = 0.;
+                if      (objective > 0.) value = lower;
+                else if (objective < 0.) value = upper;
+                else                     value = std::clamp(0., lower, upper);
+
+                // Unbounded variables are left to the solver.
+                if (is_neg_inf(value) || is_pos_inf(value))
+                    continue;
+
+                fix_variable(j, value);
+                changed = true;
+            }
+            return changed;
+        }
+
+
+        PresolvedModel Presolver::create_result(int p_num_rounds) const
+        {
+            PresolvedModel result;
+            result.fixed_values     = d_fixed_values;
+            result.objective_offset = d_objective_offset;
+            result.infeasible       = d_infeasible;
+            result.statistics       = d_statistics;
+            result.statistics.num_rounds = p_num_rounds;
+            if (d_infeasible)
+                return result;
+
+            for (auto j = 0; j < d_num_variables; ++j)
+                if (d_variable_active[j])
+                    result.kept_variables.push_back(j);
+            for (auto i = 0; i < d_num_constraints; ++i)
+                if (d_constraint_active[i])
+                    result.kept_constraints.push_back(i);
+            result.statistics.num_removed_variables   = d_num_variables   - static_cast<int>(result.kept_variables  .size());
+            result.statistics.num_removed_constraints = d_num_constraints - static_cast<int>(result.kept_constraints.size());
+
+            auto& reduced = result.reduced_data;
+            for (auto j: result.kept_variables)
+            {
+                reduced.objective     .push_back(d_data.objective[j]);
+                reduced.variable_lower.push_back(d_variable_lower[j]);
+                reduced.variable_upper.push_back(d_variable_upper[j]);
+                reduced.variable_type .push_back(d_data.variable_type[j]);
+            }
+
+            for (auto i: result.kept_constraints)
+            {
+                const auto& row = d_data.matrix[i];
+                vector<double> reduced_row;
+                reduced_row.reserve(result.kept_variables.size());
+                for (auto j: result.kept_variables)
+                    reduced_row.push_back(row[j]);
+                reduced.matrix.push_back(std::move(reduced_row));
+
+                reduced.constraint_lower.push_back(d_constraint_lower[i]);
+                reduced.constraint_upper.push_back(d_constraint_upper[i]);
+            }
+
+            reduced.objective_sense = d_data.objective_sense;
+            if (!d_data.start_solution.empty())
+                for (auto j: result.kept_variables)
+                    reduced.start_solution.push_back(d_data.start_solution[j]);
+
+            copy_parameters(d_data, &reduced);
+            return result;
+        }
+    }
+
+
+    PresolvedModel presolve(const ILPData& p_data)
+    {
+        return Presolver(p_data).run();
+    }
+
+
+    vector<double> postsolve(const PresolvedModel& p_presolved_model, const vector<double>& p_reduced_solution)
+    {
+        if (p_reduced_solution.size() != p_presolved_model.kept_variables.size())
+            return vector<double>();
+
+        auto solution = p_presolved_model.fixed_values;
+        for (auto k = 0; k < static_cast<int>(p_reduced_solution.size()); ++k)
+            solution[p_presolved_model.kept_variables[k]] = p_reduced_solution[k];
+        return solution;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ilp_bound_propagation.hpp"
+#include "ilp_data.hpp"
+
+#include <vector>
+
+namespace ilp_solver
+{
+    struct PresolveStatistics
+    {
+        int num_rounds             { 0 };
+        int num_removed_variables  { 0 };
+        int num_removed_constraints{ 0 };
+
+        // Of the bound propagation before the reductions.
+        PropagationStatistics propagation;
+    };
+
+
+    // Result of presolve: a reduced model and the information to map its solutions back.
+    struct PresolvedModel
+    {
+        ILPData reduced_data;
+
+        // Index in the original model of every variable and constraint of the reduced model.
+        std::vector<int> kept_variables;
+        std::vector<int> kept_constraints;
+
+        // Values of all variables of the original model that have been removed (fixed).
+        // Entries of kept variables are meaningless.
+        std::vector<double> fixed_values;
+
+        // Objective value of the fixed variables. Must be added to the objective of the reduced model.
+        double objective_offset{ 0. };
+
+        // Presolve has proven that the model is infeasible. reduced_data is meaningless then.
+        bool infeasible{ false };
+
+        PresolveStatistics statistics;
+    };
+
+
+    // Tightens the variable bounds by bound propagation (see ilp_bound_propagation.hpp) and removes
+    // the constraints that are redundant afterwards. Then, applies cheap reductions until nothing changes any more:
+    // - Integer bounds are rounded. Variables with equal bounds are fixed and removed.
+    // - Empty constraints are checked for feasibility and removed.
+    // - Constraints with a single non-zero are turned into variable bounds.
+    // - Of several constraints that are multiples of each other, only one with the intersected bounds is kept.
+    // - Constraints that are satisfied for all values within the variable bounds are removed.
+    // - Variables that do not appear in any constraint are fixed at their best bound, if it is finite.
+    PresolvedModel presolve(const ILPData& p_data);
+
+    // Maps a solution of the reduced model to a solution of the original model.
+    std::vector<double> postsolve(const PresolvedModel& p_presolved_model, const std::vector<double>& p_reduced_solution);
+}
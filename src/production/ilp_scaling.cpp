@@ -0,0 +1,262 @@
+#include "ilp_scaling.hpp"
+
+#include "ilp_tolerance.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    namespace
+    {
+        constexpr int c_max_geometric_passes{ 4 };
+
+        // Geometric scaling stops if a pass reduces the ratio of the largest to the smallest absolute value
+        // by less than this factor.
+        constexpr double c_min_geometric_improvement{ 0.9 };
+
+        // Matrices with a smaller ratio of the largest to the smallest absolute value are not scaled.
+        constexpr double c_min_ratio_to_scale{ 16. };
+
+
+
+        double round_to_power_of_2(double p_scale)
+        {
+            return std::exp2(std::round(std::log2(p_scale)));
+        }
+
+
+        // Ratio of the largest to the smallest absolute value of the scaled matrix.
+        double scaled_ratio(const ILPData::Matrix& p_matrix, const vector<double>& p_row_scale, const vector<double>& p_column_scale)
+        {
+            auto min_value = std::numeric_limits<double>::max();
+            auto max_value = 0.;
+            for (auto i = 0; i < static_cast<int>(p_matrix.size()); ++i)
+            {
+                const auto& row = p_matrix[i];
+                for (auto j = 0; j < static_cast<int>(row.size()); ++j)
+                {
+                    if (row[j] == 0.)
+                        continue;
+                    const auto value = std::abs(row[j]) * p_row_scale[i] * p_column_scale[j];
+                    min_value = std::min(min_value, value);
+                    max_value = std::max(max_value, value);
+                }
+            }
+            return (max_value > 0.) ? max_value / min_value : 1.;
+        }
+
+
+        class Scaler
+        {
+            public:
+                explicit Scaler(const ILPData& p_data);
+
+                void scale_geometric();
+                void equilibrate();
+
+                ScaledModel create_result() const;
+
+            private:
+                const ILPData& d_data;
+
+                int d_num_variables;
+                int d_num_constraints;
+
+                vector<double> d_row_scale;
+                vector<double> d_column_scale;
+
+                bool is_integer(int p_variable_index) const;
+
+                void scale_rows_geometric();
+                void scale_columns_geometric();
+        };
+
+
+        Scaler::Scaler(const ILPData& p_data)
+            : d_data(p_data),
+              d_num_variables(static_cast<int>(p_data.variable_type.size())),
+              d_num_constraints(static_cast<int>(p_data.matrix.size())),
+              d_row_scale(d_num_constraints, 1.),
+              d_column_scale(d_num_variables, 1.)
+        { }
+
+
+        bool Scaler::is_integer(int p_variable_index) const
+        {
+            return d_data.variable_type[p_variable_index] != VariableType::CONTINUOUS;
+        }
+
+
+        void Scaler::scale_geometric()
+        {
+            auto ratio = scaled_ratio(d_data.matrix, d_row_scale, d_column_scale);
+            for (auto pass = 0; pass < c_max_geometric_passes; ++pass)
+            {
+                const auto previous_row_scale    = d_row_scale;
+                const auto previous_column_scale = d_column_scale;
+
+                scale_rows_geometric();
+                scale_columns_geometric();
+
+                const auto new_ratio = scaled_ratio(d_data.matrix, d_row_scale, d_column_scale);
+                if (new_ratio > ratio)
+                {
+                    d_row_scale    = previous_row_scale;
+                    d_column_scale = previous_column_scale;
+                    break;
+                }
+                if (new_ratio > c_min_geometric_improvement * ratio)
+                    break;
+                ratio = new_ratio;
+            }
+        }
+
+
+        // Divides each row by the geometric mean of its smallest and largest absolute value.
+        void Scaler::scale_rows_geometric()
+        {
+            for (auto i = 0; i < d_num_constraints; ++i)
+            {
+                const auto& row = d_data.matrix[i];
+                auto min_value = std::numeric_limits<double>::max();
+                auto max_value = 0.;
+                for (auto j = 0; j < d_num_variables; ++j)
+                {
+                    if (row[j] == 0.)
+                        continue;
+                    const auto value = std::abs(row[j]) * d_column_scale[j];
+                    min_value = std::min(min_value, value);
+                    max_value = std::max(max_value, value);
+                }
+                if (max_value > 0.)
+                    d_row_scale[i] = 1. / std::sqrt(min_value * max_value);
+            }
+        }
+
+
+        // Divides each continuous column by the geometric mean of its smallest and largest absolute value.
+        // The matrix is stored row-wise, so all columns are processed in one sweep over the rows.
+        void Scaler::scale_columns_geometric()
+        {
+            vector<double> min_value(d_num_variables, std::numeric_limits<double>::max());
+            vector<double> max_value(d_num_variables, 0.);
+            for (auto i = 0; i < d_num_constraints; ++i)
+            {
+                const auto& row = d_data.matrix[i];
+                for (auto j = 0; j < d_num_variables; ++j)
+                {
+                    if (row[j] == 0.)
+                        continue;
+                    const auto value = std::abs(row[j]) * d_row_scale[i];
+                    min_value[j] = std::min(min_value[j], value);
+                    max_value[j] = std::max(max_value[j], value);
+                }
+            }
+
+            for (auto j = 0; j < d_num_variables; ++j)
+                if (!is_integer(j) && max_value[j] > 0.)
+                    d_column_scale[j] = 1. / std::sqrt(min_value[j] * max_value[j]);
+        }
+
+
+        void Scaler::equilibrate()
+        {
+            for (auto i = 0; i < d_num_constraints; ++i)
+            {
+                const auto& row = d_data.matrix[i];
+                auto max_value = 0.;
+                for (auto j = 0; j < d_num_variables; ++j)
+                    max_value = std::max(max_value, std::abs(row[j]) * d_column_scale[j]);
+                if (max_value > 0.)
+                    d_row_scale[i] = 1. / max_value;
+            }
+
+            vector<double> max_value(d_num_variables, 0.);
+            for (auto i = 0; i < d_num_constraints; ++i)
+            {
+                const auto& row = d_data.matrix[i];
+                for (auto j = 0; j < d_num_variables; ++j)
+                    max_value[j] = std::max(max_value[j], std::abs(row[j]) * d_row_scale[i]);
+            }
+            for (auto j = 0; j < d_num_variables; ++j)
+                if (!is_integer(j) && max_value[j] > 0.)
+                    d_column_scale[j] = 1. / max_value[j];
+        }
+
+
+        ScaledModel Scaler::create_result() const
+        {
+            ScaledModel result;
+            result.row_scale   .resize(d_num_constraints);
+            result.column_scale.resize(d_num_variables);
+            std::transform(d_row_scale   .begin(), d_row_scale   .end(), result.row_scale   .begin(), round_to_power_of_2);
+            std::transform(d_column_scale.begin(), d_column_scale.end(), result.column_scale.begin(), round_to_power_of_2);
+
+            auto& scaled = result.scaled_data;
+            scaled.matrix = d_data.matrix;
+            for (auto i = 0; i < d_num_constraints; ++i)
+            {
+                auto& row = scaled.matrix[i];
+                for (auto j = 0; j < d_num_variables; ++j)
+                    row[j] *= result.row_scale[i] * result.column_scale[j];
+            }
+
+            scaled.constraint_lower = d_data.constraint_lower;
+            scaled.constraint_upper = d_data.constraint_upper;
+            for (auto i = 0; i < d_num_constraints; ++i)
+            {
+                if (!is_neg_inf(scaled.constraint_lower[i])) scaled.constraint_lower[i] *= result.row_scale[i];
+                if (!is_pos_inf(scaled.constraint_upper[i])) scaled.constraint_upper[i] *= result.row_scale[i];
+            }
+
+            scaled.objective      = d_data.objective;
+            scaled.variable_lower = d_data.variable_lower;
+            scaled.variable_upper = d_data.variable_upper;
+            scaled.start_solution = d_data.start_solution;
+            for (auto j = 0; j < d_num_variables; ++j)
+            {
+                const auto scale = result.column_scale[j];
+                scaled.objective[j] *= scale;
+                if (!is_neg_inf(scaled.variable_lower[j])) scaled.variable_lower[j] /= scale;
+                if (!is_pos_inf(scaled.variable_upper[j])) scaled.variable_upper[j] /= scale;
+                if (!scaled.start_solution.empty())        scaled.start_solution[j] /= scale;
+            }
+
+            scaled.variable_type   = d_data.variable_type;
+            scaled.objective_sense = d_data.objective_sense;
+            copy_parameters(d_data, &scaled);
+            return result;
+        }
+    }
+
+
+    ScaledModel scale_model(const ILPData& p_data, ScalingMethod p_method)
+    {
+        const auto num_variables   = static_cast<int>(p_data.variable_type.size());
+        const auto num_constraints = static_cast<int>(p_data.matrix.size());
+
+        Scaler scaler(p_data);
+        if (scaled_ratio(p_data.matrix, vector<double>(num_constraints, 1.), vector<double>(num_variables, 1.)) >= c_min_ratio_to_scale)
+        {
+            if (p_method == ScalingMethod::GEOMETRIC)
+                scaler.scale_geometric();
+            scaler.equilibrate();
+        }
+        return scaler.create_result();
+    }
+
+
+    vector<double> unscale_solution(const ScaledModel& p_scaled_model, const vector<double>& p_scaled_solution)
+    {
+        if (p_scaled_solution.size() != p_scaled_model.column_scale.size())
+            return vector<double>();
+
+        auto solution = p_scaled_solution;
+        for (auto j = 0; j < static_cast<int>(solution.size()); ++j)
+            solution[j] *= p_scaled_model.column_scale[j];
+        return solution;
+    }
+}
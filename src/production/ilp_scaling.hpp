@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ilp_data.hpp"
+
+#include <vector>
+
+namespace ilp_solver
+{
+    enum class ScalingMethod
+    {
+        GEOMETRIC,      // Geometric mean scaling of rows and columns, followed by equilibration.
+        EQUILIBRATION   // Only equilibration: the largest absolute value of each row and column becomes 1.
+    };
+
+
+    // The scaled model has the matrix entries row_scale[i] * a_ij * column_scale[j].
+    // Its variables are x_j / column_scale[j], so that the objective value does not change.
+    struct ScaledModel
+    {
+        ILPData scaled_data;
+
+        std::vector<double> row_scale;
+        std::vector<double> column_scale;
+    };
+
+
+    // Scales the rows and the continuous columns. Integer columns keep the scale 1, so that integrality is preserved.
+    // All scales are powers of 2, so that scaling and unscaling cause no rounding errors.
+    // A matrix whose absolute values differ by less than a small factor is not scaled at all (all scales 1).
+    ScaledModel scale_model(const ILPData& p_data, ScalingMethod p_method);
+
+    // Maps a solution of the scaled model to a solution of the original model.
+    std::vector<double> unscale_solution(const ScaledModel& p_scaled_model, const std::vector<double>& p_scaled_solution);
+}
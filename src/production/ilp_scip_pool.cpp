@@ -0,0 +1,166 @@
+#if WITH_SCIP == 1
+
+#include "ilp_scip_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+
+namespace ilp_solver
+{
+    #include "scip/scip.h"
+    #include "scip/scipdefplugins.h"
+
+    using Clock = std::chrono::steady_clock;
+
+
+    SCIPPool::SCIPPool(std::size_t p_capacity)
+        : d_capacity(p_capacity)
+    { }
+
+
+    SCIPPool::~SCIPPool()
+    {
+        for (auto* scip : d_environments)
+            SCIPfree(&scip);
+    }
+
+
+    SCIP* SCIPPool::acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            if (!d_environments.empty())
+            {
+                auto* scip = d_environments.back();
+                d_environments.pop_back();
+                ++d_num_reused;
+                return scip;
+            }
+        }
+        return create();
+    }
+
+
+    // Freeing an environment may take a while. Thus, it is freed after the lock has been released.
+    void SCIPPool::release(SCIP* p_scip)
+    {
+        // Returns the environment to the state after SCIPincludeDefaultPlugins.
+        const auto start_time = Clock::now();
+        const auto reset = SCIPfreeProb(p_scip)                    == SCIP_OKAY
+                        && SCIPenableReoptimization(p_scip, FALSE) == SCIP_OKAY
+                        && SCIPresetParams(p_scip)                 == SCIP_OKAY;
+        const auto elapsed_seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_reset_seconds += elapsed_seconds;
+            if (reset && d_environments.size() < d_capacity)
+            {
+                d_environments.push_back(p_scip);
+                return;
+            }
+        }
+        SCIPfree(&p_scip);
+    }
+
+
+    void SCIPPool::warm_up(std::size_t p_num_environments)
+    {
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (d_environments.size() >= std::min(p_num_environments, d_capacity))
+                    return;
+            }
+
+            // Created without the lock, so that other threads can acquire environments meanwhile.
+            auto* scip = create();
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (d_environments.size() < d_capacity)
+                {
+                    d_environments.push_back(scip);
+                    continue;
+                }
+            }
+            SCIPfree(&scip);
+            return;
+        }
+    }
+
+
+    void SCIPPool::configure(std::size_t p_capacity)
+    {
+        std::vector<SCIP*> evicted;
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_capacity = p_capacity;
+            if (d_environments.size() > d_capacity)
+            {
+                evicted.assign(d_environments.begin() + d_capacity, d_environments.end());
+                d_environments.resize(d_capacity);
+            }
+        }
+        for (auto* scip : evicted)
+            SCIPfree(&scip);
+    }
+
+
+    long long SCIPPool::num_created() const
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_num_created;
+    }
+
+
+    long long SCIPPool::num_reused() const
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_num_reused;
+    }
+
+
+    double SCIPPool::creation_seconds() const
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_creation_seconds;
+    }
+
+
+    double SCIPPool::reset_seconds() const
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_reset_seconds;
+    }
+
+
+    SCIP* SCIPPool::create()
+    {
+        const auto start_time = Clock::now();
+        SCIP* scip{ nullptr };
+        if (SCIPcreate(&scip) != SCIP_OKAY)
+            throw std::exception("SCIP could not create an environment.");
+        if (SCIPincludeDefaultPlugins(scip) != SCIP_OKAY)
+        {
+            SCIPfree(&scip);
+            throw std::exception("SCIP could not include the default plugins.");
+        }
+        const auto elapsed_seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+        std::lock_guard<std::mutex> lock(d_mutex);
+        ++d_num_created;
+        d_creation_seconds += elapsed_seconds;
+        return scip;
+    }
+
+
+    std::shared_ptr<SCIPPool> default_scip_pool()
+    {
+        static const auto s_pool{ std::make_shared<SCIPPool>() };
+        return s_pool;
+    }
+}
+
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+#if WITH_SCIP == 1
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ilp_solver
+{
+    // Necessary forward declarations of structs and typedefs.
+    struct  Scip;
+    typedef Scip SCIP;
+
+    static constexpr std::size_t c_default_scip_pool_capacity{ 16 };
+
+
+    // Thread-safe pool of SCIP environments with the default plugins included, but without a problem.
+    // Creating an environment includes hundreds of plugins and parameters, which takes longer than
+    // solving many small models. Keeps at most p_capacity unused environments.
+    // An environment is removed from the pool while it is in use, so that no two threads use the same environment.
+    class SCIPPool
+    {
+        public:
+            explicit SCIPPool(std::size_t p_capacity = c_default_scip_pool_capacity);
+            ~SCIPPool();
+
+            SCIPPool(const SCIPPool&)            = delete;
+            SCIPPool& operator=(const SCIPPool&) = delete;
+
+            // Returns an unused environment of the pool or a new one if there is none.
+            SCIP* acquire();
+
+            // Frees the problem of p_scip and resets its parameters before returning it to the pool.
+            // p_scip is freed if this fails or if the pool is full.
+            void  release(SCIP* p_scip);
+
+            // Creates new environments until the pool contains p_num_environments, but at most its capacity.
+            // Call this e.g. on startup to avoid the creation latency for the first solvers.
+            void  warm_up(std::size_t p_num_environments);
+
+            // Frees unused environments if p_capacity is smaller than before.
+            void  configure(std::size_t p_capacity);
+
+            // Statistics on the time spent for creating environments and resetting them for reuse.
+            long long num_created     () const;
+            long long num_reused      () const;
+            double    creation_seconds() const;
+            double    reset_seconds   () const;
+
+        private:
+            mutable std::mutex d_mutex;
+
+            std::size_t        d_capacity;
+            std::vector<SCIP*> d_environments;
+
+            long long d_num_created     { 0 };
+            long long d_num_reused      { 0 };
+            double    d_creation_seconds{ 0. };
+            double    d_reset_seconds   { 0. };
+
+            // Creates a new environment without locking the pool.
+            SCIP* create();
+    };
+
+
+    // The pool shared by all solvers created via create_solver_scip_pooled.
+    std::shared_ptr<SCIPPool> default_scip_pool();
+}
+
+#endif
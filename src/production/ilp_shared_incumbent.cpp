@@ -0,0 +1,111 @@
+#include "ilp_shared_incumbent.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace ilp_solver
+{
+    SharedIncumbent::SharedIncumbent(ObjectiveSense p_sense)
+        : d_sense(p_sense)
+    { }
+
+
+    // The objective is checked before and after excluding the other publishing solvers,
+    // so that a solution that is not better never waits for them.
+    bool SharedIncumbent::publish(const std::vector<double>& p_solution, double p_objective)
+    {
+        auto current = d_current.load(std::memory_order_acquire);
+        if (current >= 0 && !is_better(p_objective, d_slots[current].objective.load(std::memory_order_relaxed)))
+            return false;
+
+        auto publishing{ false };
+        while (!d_publishing.compare_exchange_weak(publishing, true, std::memory_order_acquire))
+        {
+            publishing = false;
+            std::this_thread::yield();
+        }
+
+        current = d_current.load(std::memory_order_relaxed);
+        if (current >= 0 && !is_better(p_objective, d_slots[current].objective.load(std::memory_order_relaxed)))
+        {
+            d_publishing.store(false, std::memory_order_release);
+            return false;
+        }
+
+        const auto next          = (current == 0) ? 1 : 0;
+        const auto num_variables = static_cast<int>(p_solution.size());
+        auto&      slot          = d_slots[next];
+        auto*      values        = slot.values.load(std::memory_order_relaxed);
+        if (!values || static_cast<int>(values->size()) < num_variables)
+        {
+            d_values.push_back(std::make_unique<Values>(num_variables));
+            values = d_values.back().get();
+        }
+
+        const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.values       .store(values,        std::memory_order_relaxed);
+        slot.num_variables.store(num_variables, std::memory_order_relaxed);
+        slot.objective    .store(p_objective,   std::memory_order_relaxed);
+        for (auto j = 0; j < num_variables; ++j)
+            (*values)[j].store(p_solution[j], std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+
+        d_current.store(next, std::memory_order_release);
+        ++d_version;
+        d_publishing.store(false, std::memory_order_release);
+        return true;
+    }
+
+
+    // Only the slot that is not current is written. So the current slot only changes if two solutions
+    // are published while copying it, and then the copy is retried with the other slot.
+    std::shared_ptr<const Incumbent> SharedIncumbent::get() const
+    {
+        auto incumbent = std::make_shared<Incumbent>();
+        for (;;)
+        {
+            const auto current = d_current.load(std::memory_order_acquire);
+            if (current < 0)
+                return nullptr;
+
+            const auto& slot     = d_slots[current];
+            const auto  sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence % 2 == 1)
+                continue;
+
+            // The number of variables of a slot being rewritten may not fit its values yet.
+            const auto* values        = slot.values.load(std::memory_order_relaxed);
+            const auto  num_variables = std::min(slot.num_variables.load(std::memory_order_relaxed), static_cast<int>(values->size()));
+            incumbent->objective = slot.objective.load(std::memory_order_relaxed);
+            incumbent->solution.resize(num_variables);
+            for (auto j = 0; j < num_variables; ++j)
+                incumbent->solution[j] = (*values)[j].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+                return incumbent;
+        }
+    }
+
+
+    long long SharedIncumbent::version() const
+    {
+        return d_version;
+    }
+
+
+    ObjectiveSense SharedIncumbent::sense() const
+    {
+        return d_sense;
+    }
+
+
+    bool SharedIncumbent::is_better(double p_objective, double p_reference) const
+    {
+        return (d_sense == ObjectiveSense::MINIMIZE) ? p_objective < p_reference
+                                                     : p_objective > p_reference;
+    }
+}
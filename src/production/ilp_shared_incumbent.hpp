@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ilp_solver_impl.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ilp_solver
+{
+    struct Incumbent
+    {
+        std::vector<double> solution;
+        double              objective;
+    };
+
+
+    // The best solution found so far by any of several solvers working on the same model at once,
+    // e.g. the backends of a portfolio. Every solver publishes its new solutions and picks up
+    // the better ones of the others at safe points, as a cutoff and as a start for its heuristics.
+    // The incumbent is kept in two versioned slots like IncumbentSlot, without any lock: a new incumbent is written
+    // to the slot that is not current, which then becomes current. Readers copy the current slot and retry
+    // if its sequence number has changed meanwhile, so they never wait for a publishing solver.
+    // Publishing solvers only exclude each other while one of them writes a better solution.
+    class SharedIncumbent
+    {
+        public:
+            explicit SharedIncumbent(ObjectiveSense p_sense);
+
+            // Replaces the incumbent if p_objective is strictly better. Returns whether it has been replaced.
+            bool publish(const std::vector<double>& p_solution, double p_objective);
+
+            // A copy of the incumbent, nullptr if nothing has been published yet.
+            std::shared_ptr<const Incumbent> get() const;
+
+            // Incremented on every replacement, so that solvers can cheaply check for a new incumbent.
+            long long version() const;
+
+            ObjectiveSense sense() const;
+
+            // Whether p_objective is strictly better than p_reference for the objective sense.
+            bool is_better(double p_objective, double p_reference) const;
+
+        private:
+            // Solution values of the slots. Larger ones are allocated if a solution does not fit.
+            using Values = std::vector<std::atomic<double>>;
+
+            struct Slot
+            {
+                std::atomic<std::uint64_t> sequence     { 0 };          // Odd while being written.
+                std::atomic<double>        objective    { 0. };
+                std::atomic<int>           num_variables{ 0 };
+                std::atomic<Values*>       values       { nullptr };
+            };
+
+            ObjectiveSense         d_sense;
+            Slot                   d_slots[2];
+            std::atomic<int>       d_current{ -1 };         // Slot of the incumbent, -1 if nothing has been published yet.
+            std::atomic<bool>      d_publishing{ false };
+            std::atomic<long long> d_version{ 0 };
+
+            // All values ever allocated, only changed while publishing. They are kept,
+            // since a reader may still copy from values that a slot has already replaced.
+            std::vector<std::unique_ptr<Values>> d_values;
+    };
+}
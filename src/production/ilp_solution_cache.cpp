@@ -0,0 +1,224 @@
+#include "ilp_solution_cache.hpp"
+
+#include "ilp_solution_verifier.hpp"
+#include "serialization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+namespace ilp_solver
+{
+    /******************************************
+    * Files of solutions in the cache directory *
+    ******************************************/
+    static std::filesystem::path file_name(const std::string& p_directory, std::uint64_t p_fingerprint)
+    {
+        std::stringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << p_fingerprint << ".sol";
+        return std::filesystem::u8path(p_directory) / name.str();
+    }
+
+
+    static void serialize_solution(Serializer* v_serializer, const ILPSolutionData& p_solution_data)
+    {
+        *v_serializer << p_solution_data.solution
+                      << p_solution_data.objective
+                      << p_solution_data.solution_status;
+    }
+
+
+    static bool read_solution_file(const std::filesystem::path& p_file_name, ILPSolutionData* r_solution_data)
+    {
+        std::ifstream file(p_file_name, std::ios_base::binary);
+        if (!file)
+            return false;
+
+        const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        // Check the size before deserializing. A file may be truncated or written by someone else.
+        int num_variables{ -1 };
+        if (buffer.size() >= sizeof(num_variables))
+            std::memcpy(&num_variables, buffer.data(), sizeof(num_variables));
+        if (num_variables < 0
+            || buffer.size() != sizeof(int) + num_variables*sizeof(double) + sizeof(double) + sizeof(SolutionStatus))
+            return false;
+
+        Deserializer deserializer(const_cast<char*>(buffer.data()));
+        deserializer >> r_solution_data->solution
+                     >> r_solution_data->objective
+                     >> r_solution_data->solution_status;
+        return true;
+    }
+
+
+    static void write_solution_file(const std::filesystem::path& p_file_name, const ILPSolutionData& p_solution_data)
+    {
+        Serializer simulator(nullptr);
+        serialize_solution(&simulator, p_solution_data);
+
+        std::vector<char> buffer(simulator.required_bytes());
+        Serializer serializer(buffer.data());
+        serialize_solution(&serializer, p_solution_data);
+
+        // Write to a temporary file and rename it, so that other processes never read an incomplete file.
+        auto temporary_name = p_file_name;
+        temporary_name += ".tmp";
+        {
+            std::ofstream file(temporary_name, std::ios_base::binary | std::ios_base::trunc);
+            if (!file)
+                return;
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (!file)
+                return;
+        }
+
+        // The disk cache is optional. If another process wins the race, its file is just as good.
+        std::error_code ignored;
+        std::filesystem::rename(temporary_name, p_file_name, ignored);
+        std::filesystem::remove(temporary_name, ignored);
+    }
+
+
+    // Fingerprints may collide, and a file may be stale or written for another model by another process.
+    // Results without a solution (infeasible, unbounded) can not be checked.
+    static bool fits_model(const ILPData& p_data, const ILPSolutionData& p_solution_data)
+    {
+        const auto& solution = p_solution_data.solution;
+        if (solution.size() != p_data.variable_type.size())
+            return solution.empty() && p_solution_data.solution_status != SolutionStatus::PROVEN_OPTIMAL;
+
+        const auto report = verify_solution(p_data, solution);
+        if (!report.feasible)
+            return false;
+        if (p_solution_data.solution_status != SolutionStatus::PROVEN_OPTIMAL)
+            return true;
+        return std::abs(report.objective - p_solution_data.objective)
+            <= c_default_verification_tolerance * std::max(1., std::abs(p_solution_data.objective));
+    }
+
+
+    /********************
+    * ILPSolutionCache *
+    ********************/
+    ILPSolutionCache::ILPSolutionCache(std::size_t p_capacity, const std::string& p_directory)
+        : d_capacity(p_capacity),
+          d_directory(p_directory)
+    { }
+
+
+    bool ILPSolutionCache::find(std::uint64_t p_fingerprint, const ILPData& p_data, ILPSolutionData* r_solution_data)
+    {
+        std::string directory;
+        bool found_in_memory;
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            found_in_memory = find_in_memory(p_fingerprint, r_solution_data);
+            directory = d_directory;
+        }
+
+        // Do not block other threads while reading the file or checking the solution.
+        auto found = found_in_memory || (!directory.empty() && read_solution_file(file_name(directory, p_fingerprint), r_solution_data));
+        found = found && fits_model(p_data, *r_solution_data);
+
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (found)
+        {
+            ++d_num_hits;
+            if (!found_in_memory)
+                insert_in_memory(p_fingerprint, *r_solution_data);
+        }
+        else
+            ++d_num_misses;
+        return found;
+    }
+
+
+    void ILPSolutionCache::insert(std::uint64_t p_fingerprint, const ILPSolutionData& p_solution_data)
+    {
+        std::string directory;
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            insert_in_memory(p_fingerprint, p_solution_data);
+            directory = d_directory;
+        }
+
+        if (!directory.empty())
+            write_solution_file(file_name(directory, p_fingerprint), p_solution_data);
+    }
+
+
+    void ILPSolutionCache::configure(std::size_t p_capacity, const std::string& p_directory)
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_capacity  = p_capacity;
+        d_directory = p_directory;
+        shrink_to_capacity();
+    }
+
+
+    long long ILPSolutionCache::num_hits() const
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_num_hits;
+    }
+
+
+    long long ILPSolutionCache::num_misses() const
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_num_misses;
+    }
+
+
+    bool ILPSolutionCache::find_in_memory(std::uint64_t p_fingerprint, ILPSolutionData* r_solution_data)
+    {
+        const auto position = d_positions.find(p_fingerprint);
+        if (position == d_positions.end())
+            return false;
+
+        // Move the entry to the front (most recently used).
+        d_entries.splice(d_entries.begin(), d_entries, position->second);
+        *r_solution_data = position->second->second;
+        return true;
+    }
+
+
+    void ILPSolutionCache::insert_in_memory(std::uint64_t p_fingerprint, const ILPSolutionData& p_solution_data)
+    {
+        const auto position = d_positions.find(p_fingerprint);
+        if (position != d_positions.end())
+        {
+            position->second->second = p_solution_data;
+            d_entries.splice(d_entries.begin(), d_entries, position->second);
+            return;
+        }
+
+        d_entries.emplace_front(p_fingerprint, p_solution_data);
+        d_positions[p_fingerprint] = d_entries.begin();
+        shrink_to_capacity();
+    }
+
+
+    void ILPSolutionCache::shrink_to_capacity()
+    {
+        while (d_entries.size() > d_capacity)
+        {
+            d_positions.erase(d_entries.back().first);
+            d_entries.pop_back();
+        }
+    }
+
+
+    std::shared_ptr<ILPSolutionCache> default_solution_cache()
+    {
+        static const auto s_cache{ std::make_shared<ILPSolutionCache>() };
+        return s_cache;
+    }
+}
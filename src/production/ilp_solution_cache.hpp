@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ilp_data.hpp"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace ilp_solver
+{
+    static constexpr std::size_t c_default_solution_cache_capacity{ 1000 };
+
+
+    // Thread-safe cache of solutions, keyed by model fingerprints (see ilp_fingerprint.hpp).
+    // Keeps the p_capacity most recently used solutions in memory.
+    // If p_directory is not empty, solutions are additionally stored in and looked up from files in this directory.
+    // Thus, several processes can share solutions.
+    class ILPSolutionCache
+    {
+        public:
+            explicit ILPSolutionCache(std::size_t p_capacity = c_default_solution_cache_capacity, const std::string& p_directory = "");
+
+            // Returns true and sets r_solution_data if the cache contains a solution for p_fingerprint,
+            // the fingerprint of p_data. A solution that does not fit p_data (wrong size, infeasible or another objective)
+            // counts as a miss.
+            bool find  (std::uint64_t p_fingerprint, const ILPData& p_data, ILPSolutionData* r_solution_data);
+            void insert(std::uint64_t p_fingerprint, const ILPSolutionData& p_solution_data);
+
+            // Drops the least recently used solutions from memory if p_capacity is smaller than before.
+            void configure(std::size_t p_capacity, const std::string& p_directory);
+
+            long long num_hits  () const;
+            long long num_misses() const;
+
+        private:
+            using Entry = std::pair<std::uint64_t, ILPSolutionData>;
+
+            mutable std::mutex d_mutex;
+
+            std::size_t d_capacity;
+            std::string d_directory;
+
+            // Most recently used entries first.
+            std::list<Entry> d_entries;
+            std::unordered_map<std::uint64_t, std::list<Entry>::iterator> d_positions;
+
+            long long d_num_hits  { 0 };
+            long long d_num_misses{ 0 };
+
+            bool find_in_memory  (std::uint64_t p_fingerprint, ILPSolutionData* r_solution_data);
+            void insert_in_memory(std::uint64_t p_fingerprint, const ILPSolutionData& p_solution_data);
+            void shrink_to_capacity();
+    };
+
+
+    // The cache shared by all solvers created via create_solver_cache.
+    std::shared_ptr<ILPSolutionCache> default_solution_cache();
+}
@@ -0,0 +1,149 @@
+#include "ilp_solution_verifier.hpp"
+
+#include "ilp_data.hpp"
+#include "ilp_sparse_matrix.hpp"
+#include "ilp_tolerance.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    namespace
+    {
+        // Scalar loop with four partial sums, which shortens the chain of dependent additions.
+        // The lanes do not force the compiler to vectorize anything.
+        double dot_product(const double* p_values, const double* p_solution, int p_size)
+        {
+            constexpr int c_num_lanes{ 4 };
+
+            std::array<double, c_num_lanes> lanes{};
+            auto j = 0;
+            for (; j + c_num_lanes <= p_size; j += c_num_lanes)
+                for (auto lane = 0; lane < c_num_lanes; ++lane)
+                    lanes[lane] += p_values[j + lane] * p_solution[j + lane];
+
+            auto result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            for (; j < p_size; ++j)
+                result += p_values[j] * p_solution[j];
+            return result;
+        }
+
+
+        // Like dot_product, but only over the non-zeros p_values of a sparse row, whose columns are p_indices.
+        double sparse_dot_product(const int* p_indices, const double* p_values, const double* p_solution, int p_size)
+        {
+            constexpr int c_num_lanes{ 4 };
+
+            std::array<double, c_num_lanes> lanes{};
+            auto k = 0;
+            for (; k + c_num_lanes <= p_size; k += c_num_lanes)
+                for (auto lane = 0; lane < c_num_lanes; ++lane)
+                    lanes[lane] += p_values[k + lane] * p_solution[p_indices[k + lane]];
+
+            auto result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            for (; k < p_size; ++k)
+                result += p_values[k] * p_solution[p_indices[k]];
+            return result;
+        }
+
+
+        // From the row-major copy if there is one, otherwise from the dense row.
+        double activity(const ILPData& p_data, const SparseMatrix* p_row_major_matrix, const vector<double>& p_solution, int p_constraint_index)
+        {
+            if (!p_row_major_matrix)
+                return dot_product(p_data.matrix[p_constraint_index].data(), p_solution.data(), static_cast<int>(p_solution.size()));
+
+            const auto begin = p_row_major_matrix->start[p_constraint_index];
+            const auto end   = p_row_major_matrix->start[p_constraint_index + 1];
+            return sparse_dot_product(p_row_major_matrix->index.data() + begin, p_row_major_matrix->value.data() + begin, p_solution.data(), end - begin);
+        }
+
+
+        // Violation of p_lower <= p_value <= p_upper. Returns whether it exceeds the tolerance.
+        bool add_violation(double p_value, double p_lower, double p_upper, double p_tolerance, int p_index,
+                           int* v_num_violations, double* v_max_violation, int* v_max_index)
+        {
+            auto violation = 0.;
+            auto tolerance = p_tolerance;
+            if (!is_neg_inf(p_lower) && p_value < p_lower)
+            {
+                violation = p_lower - p_value;
+                tolerance = p_tolerance * std::max(1., std::abs(p_lower));
+            }
+            else if (!is_pos_inf(p_upper) && p_value > p_upper)
+            {
+                violation = p_value - p_upper;
+                tolerance = p_tolerance * std::max(1., std::abs(p_upper));
+            }
+
+            if (violation > *v_max_violation)
+            {
+                *v_max_violation = violation;
+                *v_max_index     = p_index;
+            }
+            if (violation <= tolerance)
+                return false;
+
+            ++*v_num_violations;
+            return true;
+        }
+    }
+
+
+    static ViolationReport verify(const ILPData& p_data, const SparseMatrix* p_row_major_matrix, const vector<double>& p_solution, double p_tolerance)
+    {
+        const auto num_variables = static_cast<int>(p_data.variable_type.size());
+        if (static_cast<int>(p_solution.size()) != num_variables)
+            throw std::exception("Solution has the wrong number of variables.");
+
+        ViolationReport report;
+        report.objective = dot_product(p_data.objective.data(), p_solution.data(), num_variables);
+
+        for (auto i = 0; i < static_cast<int>(p_data.matrix.size()); ++i)
+        {
+            if (add_violation(activity(p_data, p_row_major_matrix, p_solution, i), p_data.constraint_lower[i], p_data.constraint_upper[i], p_tolerance, i,
+                              &report.num_violated_constraints, &report.max_constraint_violation, &report.max_violated_constraint))
+                report.feasible = false;
+        }
+
+        for (auto j = 0; j < num_variables; ++j)
+        {
+            const auto value = p_solution[j];
+            if (add_violation(value, p_data.variable_lower[j], p_data.variable_upper[j], p_tolerance, j,
+                              &report.num_violated_bounds, &report.max_bound_violation, &report.max_violated_bound))
+                report.feasible = false;
+
+            if (p_data.variable_type[j] == VariableType::CONTINUOUS)
+                continue;
+
+            const auto violation = std::abs(value - std::round(value));
+            if (violation > report.max_integrality_violation)
+            {
+                report.max_integrality_violation = violation;
+                report.max_integrality_violated  = j;
+            }
+            if (violation > p_tolerance)
+            {
+                ++report.num_integrality_violations;
+                report.feasible = false;
+            }
+        }
+        return report;
+    }
+
+
+    ViolationReport verify_solution(const ILPData& p_data, const vector<double>& p_solution, double p_tolerance)
+    {
+        return verify(p_data, nullptr, p_solution, p_tolerance);
+    }
+
+
+    ViolationReport verify_solution(const ILPData& p_data, const SparseMatrix& p_row_major_matrix, const vector<double>& p_solution, double p_tolerance)
+    {
+        return verify(p_data, &p_row_major_matrix, p_solution, p_tolerance);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+namespace ilp_solver
+{
+    struct ILPData;
+    struct SparseMatrix;
+
+
+    constexpr double c_default_verification_tolerance{ 1e-6 };
+
+
+    // Violations of a solution. Violations are absolute. For each kind, the number of violations
+    // beyond the tolerance, the largest violation and the index of the constraint or variable
+    // with the largest violation (-1 if there is no violation at all) are given.
+    struct ViolationReport
+    {
+        // No violation exceeds the tolerance.
+        bool   feasible { true };
+        double objective{ 0. };
+
+        int    num_violated_constraints  { 0 };
+        double max_constraint_violation  { 0. };
+        int    max_violated_constraint   { -1 };
+
+        int    num_violated_bounds       { 0 };
+        double max_bound_violation       { 0. };
+        int    max_violated_bound        { -1 };
+
+        int    num_integrality_violations{ 0 };
+        double max_integrality_violation { 0. };
+        int    max_integrality_violated  { -1 };
+    };
+
+
+    // Checks the constraints, variable bounds and integrality and computes the objective.
+    // Constraint and bound violations are compared with p_tolerance * max(1, |bound|),
+    // integrality violations with p_tolerance.
+    // Throws if the size of the solution does not match the number of variables.
+    ViolationReport verify_solution(const ILPData& p_data, const std::vector<double>& p_solution,
+                                    double p_tolerance = c_default_verification_tolerance);
+
+    // Like verify_solution above, but the activities are computed from p_row_major_matrix, the row_major_copy
+    // of the matrix of p_data (see ilp_sparse_matrix.hpp), which only touches the non-zeros.
+    // Pays off if the copy is reused for several solutions, as in ILPSolverCollect::verify_solution.
+    ViolationReport verify_solution(const ILPData& p_data, const SparseMatrix& p_row_major_matrix, const std::vector<double>& p_solution,
+                                    double p_tolerance = c_default_verification_tolerance);
+}
@@ -0,0 +1,120 @@
+#include "ilp_solve_observer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ilp_solver
+{
+    // Longer intervals would overflow the clock.
+    static constexpr double c_max_interval_seconds{ 1e9 };
+
+
+    // Relative to the objective, as for set_max_rel_gap.
+    static double relative_gap(double p_objective, double p_best_bound)
+    {
+        if (p_objective <= c_neg_inf_bound || p_objective >= c_pos_inf_bound)
+            return c_pos_inf;
+
+        const auto difference = std::abs(p_objective - p_best_bound);
+        if (difference == 0.)
+            return 0.;
+        if (p_objective == 0.)
+            return c_pos_inf;
+        return std::min(difference / std::abs(p_objective), c_pos_inf);
+    }
+
+
+    SolveObserver::SolveObserver(ObjectiveSense p_sense, IncumbentCallback p_incumbent_callback,
+                                 ProgressCallback p_progress_callback, double p_progress_interval_seconds)
+        : d_sense(p_sense),
+          d_incumbent_callback(std::move(p_incumbent_callback)),
+          d_progress_callback(std::move(p_progress_callback)),
+          d_progress_interval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(std::clamp(p_progress_interval_seconds, 0., c_max_interval_seconds)))),
+          d_start_time(Clock::now()),
+          d_best_objective((p_sense == ObjectiveSense::MINIMIZE) ? c_pos_inf : c_neg_inf),
+          d_last_progress_time(d_start_time)
+    { }
+
+
+    bool SolveObserver::report_incumbent(const double* p_solution, int p_num_variables, double p_objective)
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (!is_better(p_objective, d_best_objective))
+            return d_stop_requested;
+        d_best_objective = p_objective;
+
+        if (d_incumbent_callback && !d_callback_exception)
+        {
+            try
+            {
+                d_incumbent_callback(IncumbentEvent{ p_solution, p_num_variables, p_objective, seconds(Clock::now()) });
+            }
+            catch (...)
+            {
+                d_callback_exception = std::current_exception();
+                d_stop_requested     = true;
+            }
+        }
+        return d_stop_requested;
+    }
+
+
+    bool SolveObserver::report_progress(double p_objective, double p_best_bound, long long p_num_nodes)
+    {
+        if (d_stop_requested)
+            return true;
+        if (!d_progress_callback)
+            return false;
+
+        std::lock_guard<std::mutex> lock(d_mutex);
+        const auto now = Clock::now();
+        if (now - d_last_progress_time < d_progress_interval)
+            return false;
+        d_last_progress_time = now;
+
+        // Another thread of the solve may have found a better solution than the reporting one.
+        ProgressEvent event;
+        event.objective  = is_better(d_best_objective, p_objective) ? d_best_objective : p_objective;
+        event.best_bound = p_best_bound;
+        event.gap        = relative_gap(event.objective, p_best_bound);
+        event.num_nodes  = p_num_nodes;
+        event.seconds    = seconds(now);
+        try
+        {
+            if (d_progress_callback(event) == ProgressAction::STOP)
+                d_stop_requested = true;
+        }
+        catch (...)
+        {
+            d_callback_exception = std::current_exception();
+            d_stop_requested     = true;
+        }
+        return d_stop_requested;
+    }
+
+
+    bool SolveObserver::stop_requested() const
+    {
+        return d_stop_requested;
+    }
+
+
+    // Only called after the solve, when no other thread reports anymore.
+    void SolveObserver::rethrow_callback_exception() const
+    {
+        if (d_callback_exception)
+            std::rethrow_exception(d_callback_exception);
+    }
+
+
+    bool SolveObserver::is_better(double p_objective, double p_reference) const
+    {
+        return (d_sense == ObjectiveSense::MINIMIZE) ? p_objective < p_reference : p_objective > p_reference;
+    }
+
+
+    double SolveObserver::seconds(Clock::time_point p_time) const
+    {
+        return std::chrono::duration<double>(p_time - d_start_time).count();
+    }
+}
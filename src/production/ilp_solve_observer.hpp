@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ilp_solver_impl.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+
+namespace ilp_solver
+{
+    // Passes the reports of a running solve on to the callbacks set via set_incumbent_callback and set_progress_callback.
+    // ILPSolverImpl creates one for every solve with callbacks, which the solvers supporting them report to.
+    // Reports may come from several threads at once, the callbacks are called one at a time.
+    // Only strictly better solutions are passed on, the progress at most once per interval.
+    // Once the progress callback has asked to stop, every report asks to stop, so that all threads of a solve stop.
+    // An exception thrown by a callback must not pass the solver: It is kept, stops the solve, and is rethrown afterwards.
+    class SolveObserver
+    {
+        public:
+            SolveObserver(ObjectiveSense p_sense, IncumbentCallback p_incumbent_callback,
+                          ProgressCallback p_progress_callback, double p_progress_interval_seconds);
+
+            SolveObserver(const SolveObserver&)            = delete;
+            SolveObserver& operator=(const SolveObserver&) = delete;
+
+            // Return whether the solve should stop.
+            // Without a solution, p_objective is c_pos_inf (minimize) or c_neg_inf (maximize).
+            bool report_incumbent(const double* p_solution, int p_num_variables, double p_objective);
+            bool report_progress (double p_objective, double p_best_bound, long long p_num_nodes);
+
+            bool stop_requested() const;
+
+            // Rethrows the first exception thrown by a callback, if any.
+            void rethrow_callback_exception() const;
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            ObjectiveSense    d_sense;
+            IncumbentCallback d_incumbent_callback;
+            ProgressCallback  d_progress_callback;
+            Clock::duration   d_progress_interval;
+            Clock::time_point d_start_time;
+
+            std::mutex         d_mutex;
+            double             d_best_objective;
+            Clock::time_point  d_last_progress_time;
+            std::exception_ptr d_callback_exception;
+            std::atomic<bool>  d_stop_requested{ false };
+
+            bool   is_better(double p_objective, double p_reference) const;
+            double seconds  (Clock::time_point p_time)               const;
+    };
+}
@@ -0,0 +1,33 @@
+#include "ilp_solver_cache.hpp"
+
+#include "ilp_fingerprint.hpp"
+
+namespace ilp_solver
+{
+    static bool is_proven(SolutionStatus p_status)
+    {
+        return p_status == SolutionStatus::PROVEN_OPTIMAL
+            || p_status == SolutionStatus::PROVEN_INFEASIBLE
+            || p_status == SolutionStatus::PROVEN_UNBOUNDED;
+    }
+
+
+    ILPSolverCache::ILPSolverCache(BackendFactory p_backend_factory, std::shared_ptr<ILPSolutionCache> p_cache)
+        : ILPSolverDecorator(std::move(p_backend_factory)),
+          d_cache(std::move(p_cache))
+    { }
+
+
+    void ILPSolverCache::solve_impl()
+    {
+        d_ilp_solution_data = ILPSolutionData(d_ilp_data.objective_sense);
+
+        const auto fingerprint = model_fingerprint(d_ilp_data);
+        if (d_cache->find(fingerprint, d_ilp_data, &d_ilp_solution_data))
+            return;
+
+        d_ilp_solution_data = solve_with_backend(d_ilp_data);
+        if (is_proven(d_ilp_solution_data.solution_status))
+            d_cache->insert(fingerprint, d_ilp_solution_data);
+    }
+}
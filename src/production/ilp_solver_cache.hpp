@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ilp_solution_cache.hpp"
+#include "ilp_solver_decorator.hpp"
+
+#include <memory>
+
+namespace ilp_solver
+{
+    // Looks up the solution of the collected model in an ILPSolutionCache before solving it with the backend.
+    // Only proven results (optimal, infeasible, unbounded) are stored in the cache,
+    // since a result limited by time, nodes or solutions may be improved by another solve.
+    class ILPSolverCache : public ILPSolverDecorator
+    {
+        public:
+            explicit ILPSolverCache(BackendFactory p_backend_factory,
+                                    std::shared_ptr<ILPSolutionCache> p_cache = default_solution_cache());
+
+        private:
+            std::shared_ptr<ILPSolutionCache> d_cache;
+
+            void solve_impl() override;
+    };
+}
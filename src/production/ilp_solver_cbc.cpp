@@ -7,19 +7,242 @@
 
 #include "ilp_solver_cbc.hpp"
 
-#include "CglTreeInfo.hpp" // Needed to deal with the probing_info memory leak in Cbc
+#include "ilp_shared_incumbent.hpp"
+#include "ilp_solve_observer.hpp"
+
 #pragma warning(push)
 #pragma warning(disable : 5033) // silence warning in CBC concerning the deprecated keyword 'register'
+#include "CbcCompareActual.hpp"
+#include "CbcEventHandler.hpp"
+#include "CbcHeuristic.hpp"
+#include "CbcHeuristicFPump.hpp"
+#include "CbcHeuristicGreedy.hpp"
+#include "CbcHeuristicLocal.hpp"
+#include "CbcHeuristicRINS.hpp"
+#include "CglClique.hpp"
+#include "CglFlowCover.hpp"
+#include "CglGomory.hpp"
+#include "CglKnapsackCover.hpp"
+#include "CglMixedIntegerRounding2.hpp"
+#include "CglProbing.hpp"
+#include "CglTwomir.hpp"
 #include "CoinMessageHandler.hpp"
+#include "CoinWarmStartBasis.hpp"
 #include "OsiSolverInterface.hpp"
 #pragma warning(pop)
 
 #include <algorithm>
+#include <memory>
+
+
+namespace
+{
+    using ilp_solver::c_neg_inf;
+    using ilp_solver::c_pos_inf;
+    using ilp_solver::CbcProfile;
+    using ilp_solver::SharedIncumbent;
+    using ilp_solver::SolveObserver;
+
+    // Frequencies of CbcModel::addCutGenerator.
+    constexpr int c_cuts_if_effective{ -1 };  // At the root and in the tree as long as they are effective.
+    constexpr int c_cuts_at_root     { -99 };
+    constexpr int c_cuts_every_node  {  1 };
+
+
+    void add_cut_generators(CbcModel* v_model, CbcProfile p_profile)
+    {
+        const int how_often = (p_profile == CbcProfile::AGGRESSIVE_CUTS)   ? c_cuts_every_node
+                            : (p_profile == CbcProfile::FEASIBILITY_FIRST) ? c_cuts_at_root
+                                                                           : c_cuts_if_effective;
+
+        // The generators are cloned by addCutGenerator.
+        CglProbing probing;
+        probing.setUsingObjective(1);
+        probing.setMaxPass(1);
+        probing.setMaxPassRoot(5);
+        probing.setMaxProbe(10);
+        probing.setMaxProbeRoot(1000);
+        probing.setMaxLook(50);
+        probing.setMaxLookRoot(500);
+        probing.setMaxElements(200);
+        probing.setRowCuts(3);
+        // Probing is too expensive to be done in every node, even when cutting aggressively.
+        v_model->addCutGenerator(&probing, std::min(how_often, c_cuts_if_effective), "Probing");
+
+        CglGomory gomory;
+        gomory.setLimitAtRoot(1000);
+        gomory.setLimit(50);
+        v_model->addCutGenerator(&gomory, how_often, "Gomory");
+
+        CglKnapsackCover knapsack;
+        v_model->addCutGenerator(&knapsack, how_often, "Knapsack");
+
+        CglClique clique;
+        clique.setStarCliqueReport(false);
+        clique.setRowCliqueReport(false);
+        v_model->addCutGenerator(&clique, how_often, "Clique");
+
+        CglMixedIntegerRounding2 mixed_integer_rounding;
+        v_model->addCutGenerator(&mixed_integer_rounding, how_often, "MixedIntegerRounding2");
+
+        CglFlowCover flow_cover;
+        v_model->addCutGenerator(&flow_cover, how_often, "FlowCover");
+
+        // Like cbc, two-step MIR cuts are only generated at the root by default.
+        CglTwomir two_mir;
+        v_model->addCutGenerator(&two_mir, (p_profile == CbcProfile::AGGRESSIVE_CUTS) ? c_cuts_every_node : c_cuts_at_root, "TwoMirCuts");
+
+        if (p_profile == CbcProfile::AGGRESSIVE_CUTS)
+        {
+            v_model->setMaximumCutPassesAtRoot(50);
+            v_model->setMaximumCutPasses(10);
+        }
+        else if (p_profile == CbcProfile::FEASIBILITY_FIRST)
+        {
+            v_model->setMaximumCutPassesAtRoot(5);
+        }
+    }
+
+
+    void add_heuristics(CbcModel* v_model, CbcProfile p_profile)
+    {
+        const bool feasibility_first = (p_profile == CbcProfile::FEASIBILITY_FIRST);
+
+        // The heuristics are cloned by addHeuristic. They copy the matrix of the model on construction.
+        CbcRounding rounding(*v_model);
+        v_model->addHeuristic(&rounding);
+
+        CbcHeuristicFPump feasibility_pump(*v_model);
+        feasibility_pump.setMaximumPasses(feasibility_first ? 100 : 30);
+        v_model->addHeuristic(&feasibility_pump);
+
+        CbcHeuristicGreedyCover greedy_cover(*v_model);
+        v_model->addHeuristic(&greedy_cover);
+
+        CbcHeuristicGreedyEquality greedy_equality(*v_model);
+        v_model->addHeuristic(&greedy_equality);
+
+        // Combines the solutions found so far.
+        CbcHeuristicLocal combine(*v_model);
+        combine.setSearchType(1);
+        v_model->addHeuristic(&combine);
+
+        CbcHeuristicRINS rins(*v_model);
+        rins.setHowOften(feasibility_first ? 10 : 100);
+        v_model->addHeuristic(&rins);
+
+        if (feasibility_first)
+        {
+            CbcCompareDepth depth_first;
+            v_model->setNodeComparison(depth_first);
+        }
+    }
+
+
+    // Publishes every new solution of branch and bound into the shared incumbent (if any)
+    // and reports the solutions and the progress to the observer (if any).
+    // With several threads, each thread works on a clone.
+    class SolveEventHandler : public CbcEventHandler
+    {
+        public:
+            SolveEventHandler(std::shared_ptr<SharedIncumbent> p_incumbent, SolveObserver* p_observer, int p_num_columns)
+                : d_incumbent(std::move(p_incumbent)), d_observer(p_observer), d_num_columns(p_num_columns)
+            { }
+
+            CbcEventHandler* clone() const override
+            {
+                return new SolveEventHandler(*this);
+            }
+
+            CbcAction event(CbcEvent p_event) override
+            {
+                auto stop_requested{ false };
+                if (p_event == solution || p_event == heuristicSolution)
+                {
+                    // The best solution has already been replaced when the event is raised.
+                    const auto* best = model_->bestSolution();
+                    if (best && model_->getNumCols() == d_num_columns)
+                    {
+                        if (d_incumbent)
+                            d_incumbent->publish(std::vector<double>(best, best + d_num_columns), model_->getObjValue());
+                        if (d_observer)
+                            stop_requested = d_observer->report_incumbent(best, d_num_columns, model_->getObjValue());
+                    }
+                }
+                else if (p_event == node && d_observer)
+                {
+                    const auto no_solution = (model_->solver()->getObjSense() > 0.) ? c_pos_inf : c_neg_inf;
+                    const auto objective   = model_->bestSolution() ? model_->getObjValue() : no_solution;
+                    stop_requested = d_observer->report_progress(objective, model_->getBestPossibleObjValue(), model_->getNodeCount());
+                }
+
+                // CBC only stops on the result of some events, but always on the flag, like on interrupt.
+                if (!stop_requested)
+                    return noAction;
+                model_->sayEventHappened();
+                return stop;
+            }
+
+        private:
+            std::shared_ptr<SharedIncumbent> d_incumbent;
+            SolveObserver*                   d_observer;
+            int                              d_num_columns;
+    };
+
+
+    // Hands the shared incumbent to CBC whenever it has been improved by another solver.
+    // CBC checks the feasibility of the solutions of heuristics and uses them as a cutoff.
+    class IncumbentImport : public CbcHeuristic
+    {
+        public:
+            IncumbentImport(CbcModel& p_model, std::shared_ptr<SharedIncumbent> p_incumbent)
+                : CbcHeuristic(p_model), d_incumbent(std::move(p_incumbent))
+            {
+                setHeuristicName("SharedIncumbent");
+            }
+
+            CbcHeuristic* clone() const override
+            {
+                return new IncumbentImport(*this);
+            }
+
+            void resetModel(CbcModel* p_model) override
+            {
+                model_ = p_model;
+            }
+
+            // v_objective is the objective of the best solution of CBC, which always minimizes internally.
+            int solution(double& v_objective, double* r_solution) override
+            {
+                const auto version = d_incumbent->version();
+                if (version == d_version)
+                    return 0;
+                d_version = version;
+
+                const auto incumbent = d_incumbent->get();
+                if (!incumbent || static_cast<int>(incumbent->solution.size()) != model_->getNumCols())
+                    return 0;
+
+                const auto objective = incumbent->objective * model_->solver()->getObjSense();
+                if (objective >= v_objective)
+                    return 0;
+
+                std::copy(incumbent->solution.begin(), incumbent->solution.end(), r_solution);
+                v_objective = objective;
+                return 1;
+            }
+
+        private:
+            std::shared_ptr<SharedIncumbent> d_incumbent;
+            long long                        d_version{ 0 };
+    };
+}
 
 
 namespace ilp_solver
 {
-    ILPSolverCbc::ILPSolverCbc()
+    ILPSolverCbc::ILPSolverCbc(CbcProfile p_profile)
+        : d_profile(p_profile)
     {
         // CbcModel assumes ownership over solver and deletes it in its destructor.
         OsiSolverInterface* solver = new OsiClpSolverInterface();
@@ -36,40 +259,66 @@ namespace ilp_solver
     std::vector<double> ILPSolverCbc::get_solution() const
     {
         // The best solution is stored by CbcModel, not by the solver, thus reimplementation.
-        const auto* result = d_model.bestSolution();
+        const auto& model = result_model();
+        const auto* result = model.bestSolution();
         if (!result) return std::vector<double>();
         // No virtual call necessary, since the problem is solved.
-        return std::vector<double>(result, result + d_model.getNumCols());
+        return std::vector<double>(result, result + model.getNumCols());
     }
 
 
     double ILPSolverCbc::get_objective() const
     {
         // The best objective value is stored by CbcModel, not by the solver, thus reimplementation.
-        return d_model.getObjValue();
+        return result_model().getObjValue();
     }
 
 
     SolutionStatus ILPSolverCbc::get_status() const
     {
         // Solution status is stored by CbcModel.
-        if (d_model.isProvenOptimal())
+        const auto& model = result_model();
+        if (model.isProvenOptimal())
             return SolutionStatus::PROVEN_OPTIMAL;
-        else if (d_model.isProvenInfeasible())
+        else if (model.isProvenInfeasible())
             return SolutionStatus::PROVEN_INFEASIBLE;
-        else if (d_model.isProvenDualInfeasible())
+        else if (model.isProvenDualInfeasible())
             return SolutionStatus::PROVEN_UNBOUNDED;
         else
-            return ((d_model.bestSolution() == nullptr) ? SolutionStatus::NO_SOLUTION
-                                                        : SolutionStatus::SUBOPTIMAL);
+            return ((model.bestSolution() == nullptr) ? SolutionStatus::NO_SOLUTION
+                                                      : SolutionStatus::SUBOPTIMAL);
     }
 
 
     void ILPSolverCbc::reset_solution()
     {
+        d_solved_model.reset();
         d_model.gutsOfDestructor2(); // "Clears enough to reset CbcModel as if no branch and bound done."
-        d_model.solver()->loadFromCoinModel(d_cache, false);
-        d_cache_changed = false;
+        // Branch and bound runs on a copy, thus the model in d_model is still unchanged.
+        if (!d_reset_branch_and_bound_only)
+            load_cache(false);
+    }
+
+
+    int ILPSolverCbc::get_num_nodes() const
+    {
+        return d_solved_model ? d_solved_model->getNodeCount() : 0;
+    }
+
+
+    void ILPSolverCbc::set_warm_start(bool p_keep_root_basis, bool p_reset_branch_and_bound_only)
+    {
+        d_keep_root_basis             = p_keep_root_basis;
+        d_reset_branch_and_bound_only = p_reset_branch_and_bound_only;
+        if (!d_keep_root_basis)
+            d_root_basis.reset();
+    }
+
+
+    const CbcModel& ILPSolverCbc::result_model() const
+    {
+        // Before the first solve, e.g. the start solution is stored in d_model.
+        return d_solved_model ? *d_solved_model : d_model;
     }
 
 
@@ -79,6 +328,7 @@ namespace ilp_solver
         // get_num_variables necessary since the cache may not be included in the problem.
         assert( static_cast<int>(p_solution.size()) == get_num_variables() );
         d_model.setBestSolution(p_solution.data(), static_cast<int>(p_solution.size()), COIN_DBL_MAX, false);
+        d_start_solution_size = static_cast<int>(p_solution.size());
     }
 
 
@@ -148,15 +398,125 @@ namespace ilp_solver
     }
 
 
+    bool ILPSolverCbc::modify_loaded_coefficient(int p_row_index, int p_column_index, double p_value)
+    {
+        // The solver is created in the constructor.
+        static_cast<OsiClpSolverInterface*>(d_model.solver())->modifyCoefficient(p_row_index, p_column_index, p_value);
+        return true;
+    }
+
+
+    // The rows (columns) of the stored root basis are the loaded ones of the last solve,
+    // thus the first ones of p_deleted_indices, as in ILPSolverOsiModel.
+    void ILPSolverCbc::delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping)
+    {
+        if (auto* basis = dynamic_cast<CoinWarmStartBasis*>(d_root_basis.get()))
+        {
+            const auto num_in_basis = std::lower_bound(p_deleted_indices.begin(), p_deleted_indices.end(), basis->getNumArtificial()) - p_deleted_indices.begin();
+            basis->deleteRows(static_cast<int>(num_in_basis), p_deleted_indices.data());
+        }
+        d_solved_model.reset();
+        ILPSolverOsiModel::delete_constraints_impl(p_deleted_indices, p_index_mapping);
+    }
+
+
+    void ILPSolverCbc::delete_variables_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping)
+    {
+        if (auto* basis = dynamic_cast<CoinWarmStartBasis*>(d_root_basis.get()))
+        {
+            const auto num_in_basis = std::lower_bound(p_deleted_indices.begin(), p_deleted_indices.end(), basis->getNumStructural()) - p_deleted_indices.begin();
+            basis->deleteColumns(static_cast<int>(num_in_basis), p_deleted_indices.data());
+        }
+        d_solved_model.reset();
+
+        // The start solution may be shorter than the mapping if variables have been added after it was set.
+        std::vector<double> start_solution;
+        const auto* start = d_model.bestSolution();
+        if (start)
+        {
+            assert(d_start_solution_size <= static_cast<int>(p_index_mapping.size()));
+            start_solution.assign(start, start + d_start_solution_size);
+            compact(&start_solution, std::vector<int>(p_index_mapping.begin(), p_index_mapping.begin() + d_start_solution_size));
+        }
+
+        ILPSolverOsiModel::delete_variables_impl(p_deleted_indices, p_index_mapping);
+
+        if (start)
+        {
+            d_model.setBestSolution(start_solution.data(), static_cast<int>(start_solution.size()), COIN_DBL_MAX, false);
+            d_start_solution_size = static_cast<int>(start_solution.size());
+        }
+    }
+
+
+    void ILPSolverCbc::solve_root_lp()
+    {
+        // Solved on the LP solver of d_model, so that the copy for branch and bound starts with the optimal root basis.
+        auto* solver = d_model.solver();
+        if (auto* basis = dynamic_cast<CoinWarmStartBasis*>(d_root_basis.get()))
+        {
+            // Rows added since the last solve enter the basis with their slacks, new columns at their bounds.
+            basis->resize(solver->getNumRows(), solver->getNumCols());
+            solver->setWarmStart(basis);
+            solver->resolve();
+        }
+        else
+            solver->initialSolve();
+
+        d_root_basis.reset(solver->getWarmStart());
+    }
+
+
     void ILPSolverCbc::solve_impl()
     {
-        // The probingInfo is not deleted on successive solves, but overwritten.
-        // Thus, it produces memory leaks if not deleted here.
-        auto probing_ptr = d_model.probingInfo();
-        if (probing_ptr)
-            delete probing_ptr;
+        if (d_keep_root_basis)
+            solve_root_lp();
+
+        // The copy takes the parameters, the message handler and the start solution of d_model.
+        // Since it is destroyed before the next solve, the probingInfo of CBC does not leak either.
+        d_solved_model = std::make_unique<CbcModel>(d_model);
+        if (d_profile != CbcProfile::PLAIN)
+        {
+            add_cut_generators(d_solved_model.get(), d_profile);
+            add_heuristics    (d_solved_model.get(), d_profile);
+        }
+        // Both are cloned by CBC.
+        if (d_shared_incumbent)
+        {
+            IncumbentImport import(*d_solved_model, d_shared_incumbent);
+            d_solved_model->addHeuristic(&import);
+        }
+        if (d_shared_incumbent || d_observer)
+        {
+            const SolveEventHandler event_handler(d_shared_incumbent, d_observer.get(), d_solved_model->getNumCols());
+            d_solved_model->passInEventHandler(&event_handler);
+        }
 
-        d_model.branchAndBound();
+        {
+            std::lock_guard<std::mutex> lock(d_interrupt_mutex);
+            d_running_model = d_solved_model.get();
+        }
+        try
+        {
+            d_solved_model->branchAndBound();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(d_interrupt_mutex);
+            d_running_model = nullptr;
+            throw;
+        }
+        std::lock_guard<std::mutex> lock(d_interrupt_mutex);
+        d_running_model = nullptr;
+    }
+
+
+    // CBC checks for the event between the nodes of the branch and bound tree and then stops like on a time limit.
+    void ILPSolverCbc::interrupt()
+    {
+        std::lock_guard<std::mutex> lock(d_interrupt_mutex);
+        if (d_running_model)
+            d_running_model->sayEventHappened();
     }
 
 
@@ -6,15 +6,20 @@ static_assert(WITH_OSI == 1,
     "CBC requires the Osi-Interface and the CoinUtils contained therein. "
     "Please set WITH_OSI=1 or deactivate CBC with WITH_CBC=0.");
 
+#include "ilp_cbc_profile.hpp"
 #include "ilp_solver_osi_model.hpp" // Including this also links with the required COIN Libraries.
 
 #pragma warning(push)
 #pragma warning(disable : 5033) // silence warning in CBC concerning the deprecated keyword 'register'
 #pragma warning(disable : 4309) // silence warning in CBC concerning truncations of constant values in 64 bit.
 #include "CbcModel.hpp"
+#include "CoinWarmStart.hpp"
 #include "OsiClpSolverInterface.hpp"
 #pragma warning(pop)
 
+#include <memory>
+#include <mutex>
+
 class OsiSolverInterface;
 
 
@@ -24,7 +29,7 @@ namespace ilp_solver
     class ILPSolverCbc : public ILPSolverOsiModel
     {
         public:
-            ILPSolverCbc();
+            explicit ILPSolverCbc(CbcProfile p_profile = CbcProfile::DEFAULT);
 
             std::vector<double> get_solution  () const override;
             double              get_objective () const override;
@@ -32,6 +37,17 @@ namespace ilp_solver
 
             void                reset_solution()       override;
 
+            void                interrupt     ()       override;
+
+            // Number of branch and bound nodes of the last solve.
+            int                 get_num_nodes () const;
+
+            // If p_keep_root_basis is set, the basis of the root LP is kept and the next solve starts from it,
+            // even if the model has been modified or reloaded in between.
+            // If p_reset_branch_and_bound_only is set, reset_solution only discards the branch and bound state,
+            // but keeps the model loaded into the LP solver instead of reloading it.
+            void set_warm_start(bool p_keep_root_basis, bool p_reset_branch_and_bound_only);
+
             void set_start_solution(const std::vector<double>& p_solution) override;
 
             void set_num_threads        (int p_num_threads)    override;
@@ -45,9 +61,34 @@ namespace ilp_solver
             void set_max_abs_gap        (double p_gap)         override;
             void set_max_rel_gap        (double p_gap)         override;
         private:
-            CbcModel d_model;
+            // Holds the problem and the parameters, but is never solved itself.
+            // Branch and bound runs on a copy with the cut generators and heuristics of d_profile,
+            // so that they are always set up for the current matrix. Unlike CbcMain1, the copy is not
+            // preprocessed by CglPreProcess, since the solution, the callbacks and the shared incumbent
+            // refer to the variables of the original model.
+            CbcModel                  d_model;
+            std::unique_ptr<CbcModel> d_solved_model;
+            CbcProfile                d_profile;
+
+            // The model in branch and bound, which interrupt may access from another thread, or nullptr.
+            std::mutex                d_interrupt_mutex;
+            CbcModel*                 d_running_model{ nullptr };
+
+            bool                           d_keep_root_basis{ false };
+            bool                           d_reset_branch_and_bound_only{ false };
+            std::unique_ptr<CoinWarmStart> d_root_basis;
+
+            // Length of the start solution in d_model, which CbcModel does not provide.
+            int                            d_start_solution_size{ 0 };
+
+            const CbcModel& result_model() const;
+            void            solve_root_lp();
 
             OsiSolverInterface*       get_solver_osi_model    ()       override;
+            bool                      modify_loaded_coefficient(int p_row_index, int p_column_index, double p_value) override;
+
+            void delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
+            void delete_variables_impl  (const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
 
             void solve_impl() override;
             void set_objective_sense_impl(ObjectiveSense p_sense) override;
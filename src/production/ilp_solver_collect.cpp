@@ -74,6 +74,20 @@ namespace ilp_solver
     }
 
 
+    ModelStatistics ILPSolverCollect::get_model_statistics() const
+    {
+        return model_statistics(d_ilp_data);
+    }
+
+
+    ViolationReport ILPSolverCollect::verify_solution(const std::vector<double>& p_solution, double p_tolerance) const
+    {
+        if (!d_row_major_matrix)
+            d_row_major_matrix = row_major_copy(d_ilp_data);
+        return ilp_solver::verify_solution(d_ilp_data, *d_row_major_matrix, p_solution, p_tolerance);
+    }
+
+
     namespace
     {
         std::string to_name(int p_num, char p_type, int p_alignment = 15)
@@ -249,6 +263,8 @@ namespace ilp_solver
         d_ilp_data.variable_lower.push_back(p_lower_bound);
         d_ilp_data.variable_upper.push_back(p_upper_bound);
         d_ilp_data.variable_type.push_back(p_type);
+        d_matrix_changed = true;
+        d_row_major_matrix.reset();
     }
 
 
@@ -272,6 +288,8 @@ namespace ilp_solver
 
         d_ilp_data.constraint_lower.push_back(p_lower_bound);
         d_ilp_data.constraint_upper.push_back(p_upper_bound);
+        d_matrix_changed = true;
+        d_row_major_matrix.reset();
     }
 
 
@@ -281,6 +299,60 @@ namespace ilp_solver
     }
 
 
+    // The matrix is not changed, so d_matrix_changed stays as it is.
+    void ILPSolverCollect::set_variable_bounds_impl(int p_variable_index, double p_lower_bound, double p_upper_bound)
+    {
+        d_ilp_data.variable_lower[p_variable_index] = p_lower_bound;
+        d_ilp_data.variable_upper[p_variable_index] = p_upper_bound;
+    }
+
+
+    void ILPSolverCollect::set_constraint_bounds_impl(int p_constraint_index, double p_lower_bound, double p_upper_bound)
+    {
+        d_ilp_data.constraint_lower[p_constraint_index] = p_lower_bound;
+        d_ilp_data.constraint_upper[p_constraint_index] = p_upper_bound;
+    }
+
+
+    void ILPSolverCollect::set_objective_coefficient_impl(int p_variable_index, double p_objective)
+    {
+        d_ilp_data.objective[p_variable_index] = p_objective;
+    }
+
+
+    void ILPSolverCollect::set_coefficient_impl(int p_constraint_index, int p_variable_index, double p_value)
+    {
+        d_ilp_data.matrix[p_constraint_index][p_variable_index] = p_value;
+        d_matrix_changed = true;
+        d_row_major_matrix.reset();
+    }
+
+
+    // Both compact the data in place in a single pass over it.
+    void ILPSolverCollect::delete_constraints_impl(const std::vector<int>& /* p_deleted_indices */, const std::vector<int>& p_index_mapping)
+    {
+        compact(&d_ilp_data.matrix,           p_index_mapping);
+        compact(&d_ilp_data.constraint_lower, p_index_mapping);
+        compact(&d_ilp_data.constraint_upper, p_index_mapping);
+        d_matrix_changed = true;
+        d_row_major_matrix.reset();
+    }
+
+
+    void ILPSolverCollect::delete_variables_impl(const std::vector<int>& /* p_deleted_indices */, const std::vector<int>& p_index_mapping)
+    {
+        for (auto& row: d_ilp_data.matrix)
+            compact(&row, p_index_mapping);
+        compact(&d_ilp_data.objective,      p_index_mapping);
+        compact(&d_ilp_data.variable_lower, p_index_mapping);
+        compact(&d_ilp_data.variable_upper, p_index_mapping);
+        compact(&d_ilp_data.variable_type,  p_index_mapping);
+        compact(&d_ilp_data.start_solution, p_index_mapping);
+        d_matrix_changed = true;
+        d_row_major_matrix.reset();
+    }
+
+
     void ILPSolverCollect::set_start_solution(const std::vector<double>& p_solution)
     {
         d_ilp_data.start_solution = p_solution;
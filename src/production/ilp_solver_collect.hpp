@@ -1,7 +1,12 @@
 #pragma once
 
 #include "ilp_data.hpp"
+#include "ilp_model_statistics.hpp"
+#include "ilp_solution_verifier.hpp"
 #include "ilp_solver_impl.hpp"
+#include "ilp_sparse_matrix.hpp"
+
+#include <optional>
 
 namespace ilp_solver
 {
@@ -14,12 +19,25 @@ namespace ilp_solver
             int  get_num_variables  () const override;
 
             void print_mps_file(const std::string& p_filename) override;
+
+            // Computed from the collected model on every call.
+            ModelStatistics get_model_statistics() const;
+
+            // Checks p_solution against the collected model, e.g. a solution returned by get_solution
+            // or a start solution before passing it to set_start_solution.
+            // The sparse copy of the matrix it needs is kept until the matrix changes. Thus, not thread-safe.
+            ViolationReport verify_solution(const std::vector<double>& p_solution, double p_tolerance = c_default_verification_tolerance) const;
         protected:
             ILPSolverCollect();
 
             ILPData d_ilp_data;
 
+            // Set whenever the matrix is changed. Derived classes may reset it, e.g. after transferring the matrix.
+            bool d_matrix_changed{ true };
+
         private:
+            // Created by verify_solution, reset whenever the matrix is changed.
+            mutable std::optional<SparseMatrix> d_row_major_matrix;
 
             void add_variable_impl (VariableType p_type, double p_objective, double p_lower_bound, double p_upper_bound,
                 const std::string& p_name = "", const std::vector<double>* p_row_values = nullptr,
@@ -30,6 +48,14 @@ namespace ilp_solver
                 const std::vector<int>* p_col_indices = nullptr) override;
             void set_objective_sense_impl(ObjectiveSense p_sense) override;
 
+            void set_variable_bounds_impl      (int p_variable_index,   double p_lower_bound, double p_upper_bound) override;
+            void set_constraint_bounds_impl    (int p_constraint_index, double p_lower_bound, double p_upper_bound) override;
+            void set_objective_coefficient_impl(int p_variable_index,   double p_objective)                         override;
+            void set_coefficient_impl          (int p_constraint_index, int p_variable_index, double p_value)       override;
+
+            void delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
+            void delete_variables_impl  (const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
+
             void set_start_solution     (const std::vector<double>& p_solution) override;
 
             void set_num_threads        (int p_num_threads)    override;
@@ -0,0 +1,190 @@
+#include "ilp_solver_decompose.hpp"
+
+#include "ilp_decomposition.hpp"
+#include "ilp_tolerance.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    static SolutionStatus combine_status(const vector<ILPSolutionData>& p_results)
+    {
+        auto all_optimal = true;
+        auto unbounded   = false;
+        for (const auto& result: p_results)
+        {
+            switch (result.solution_status)
+            {
+            case SolutionStatus::PROVEN_INFEASIBLE: return SolutionStatus::PROVEN_INFEASIBLE;
+            case SolutionStatus::PROVEN_UNBOUNDED:  unbounded   = true;  break;
+            case SolutionStatus::NO_SOLUTION:       all_optimal = false; break;
+            case SolutionStatus::SUBOPTIMAL:        all_optimal = false; break;
+            case SolutionStatus::PROVEN_OPTIMAL:    break;
+            }
+        }
+
+        if (unbounded)
+            return SolutionStatus::PROVEN_UNBOUNDED;
+        for (const auto& result: p_results)
+            if (result.solution.empty())
+                return SolutionStatus::NO_SOLUTION;
+        return all_optimal ? SolutionStatus::PROVEN_OPTIMAL : SolutionStatus::SUBOPTIMAL;
+    }
+
+
+    ILPSolverDecompose::ILPSolverDecompose(BackendFactory p_backend_factory)
+        : ILPSolverDecorator(std::move(p_backend_factory))
+    { }
+
+
+    int ILPSolverDecompose::get_num_components() const
+    {
+        return d_num_components;
+    }
+
+
+    void ILPSolverDecompose::solve_impl()
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto start_time = Clock::now();
+
+        d_ilp_solution_data = ILPSolutionData(d_ilp_data.objective_sense);
+
+        const auto decomposition = decompose(d_ilp_data);
+        d_num_components = static_cast<int>(decomposition.components.size());
+
+        // The activity of an empty constraint is 0.
+        for (auto i: decomposition.empty_constraints)
+        {
+            const auto lower = d_ilp_data.constraint_lower[i];
+            const auto upper = d_ilp_data.constraint_upper[i];
+            if (lower > feasibility_tolerance(lower) || upper < -feasibility_tolerance(upper))
+            {
+                d_ilp_solution_data.solution_status = SolutionStatus::PROVEN_INFEASIBLE;
+                return;
+            }
+        }
+
+        if (d_num_components <= 1)
+        {
+            d_ilp_solution_data = solve_with_backend(d_ilp_data);
+            return;
+        }
+
+        const auto num_workers = std::clamp(d_ilp_data.num_threads, 1, d_num_components);
+
+        auto remaining_size = 0.;
+        for (const auto& component: decomposition.components)
+            remaining_size += component.size;
+
+        vector<ILPSolutionData>                     results   (d_num_components);
+        vector<std::exception_ptr>                  exceptions(d_num_components);
+        vector<std::unique_ptr<ILPSolverInterface>> backends  (d_num_components);
+        vector<std::thread>                         threads   (d_num_components);
+        vector<int>                                 finished;
+        auto                                        num_running{ 0 };
+        std::mutex                                  mutex;
+        std::condition_variable                     finished_condition;
+
+        // The components are sorted by size. Taking them in this order starts the largest ones first.
+        // Each gets the share of the remaining time that its size has of the components not yet started,
+        // times the number of workers, since that many components are solved at once.
+        // Time left over by a component is passed on to those started later.
+        auto start_component = [&](int p_k)
+        {
+            const auto& component = decomposition.components[p_k];
+
+            auto data = extract_component(d_ilp_data, component);
+            data.max_abs_gap = d_ilp_data.max_abs_gap / d_num_components;
+            data.num_threads = std::max(1, d_ilp_data.num_threads / num_workers);
+
+            const auto elapsed_seconds   = std::chrono::duration<double>(Clock::now() - start_time).count();
+            const auto remaining_seconds = std::max(0., d_ilp_data.max_seconds - elapsed_seconds);
+            const auto share             = std::min(1., num_workers * component.size / std::max(1., remaining_size));
+            data.max_seconds = share * remaining_seconds;
+            remaining_size  -= component.size;
+
+            backends[p_k] = create_backend();
+            transfer_ilp_data(backends[p_k].get(), data);
+
+            threads[p_k] = std::thread([&, p_k]()
+            {
+                try
+                {
+                    results[p_k] = optimize_backend(backends[p_k].get(), d_ilp_data.objective_sense);
+                }
+                catch (...)
+                {
+                    exceptions[p_k] = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.push_back(p_k);
+                finished_condition.notify_all();
+            });
+            ++num_running;
+        };
+
+        // Waits until fewer than p_max_running components are running, joins the threads of the finished ones
+        // and destroys their backends.
+        auto collect_components = [&](int p_max_running)
+        {
+            vector<int> collected;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                finished_condition.wait(lock, [&]() { return num_running - static_cast<int>(finished.size()) < p_max_running; });
+                collected.swap(finished);
+                num_running -= static_cast<int>(collected.size());
+            }
+            for (auto k: collected)
+            {
+                threads[k].join();
+                backends[k].reset();
+            }
+        };
+
+        // As in ILPSolverPortfolio, the backends are created, filled and destroyed on this thread and only solve in parallel.
+        // They are created when their component starts, so that at most num_workers of them exist at once.
+        try
+        {
+            for (auto k = 0; k < d_num_components; ++k)
+            {
+                collect_components(num_workers);
+                start_component(k);
+            }
+        }
+        catch (...)
+        {
+            interrupt();
+            collect_components(1);
+            throw;
+        }
+        collect_components(1);
+
+        for (const auto& exception: exceptions)
+            if (exception)
+                std::rethrow_exception(exception);
+
+        d_ilp_solution_data.solution_status = combine_status(results);
+        if (d_ilp_solution_data.solution_status != SolutionStatus::PROVEN_OPTIMAL && d_ilp_solution_data.solution_status != SolutionStatus::SUBOPTIMAL)
+            return;
+
+        d_ilp_solution_data.solution.assign(d_ilp_data.variable_type.size(), 0.);
+        d_ilp_solution_data.objective = 0.;
+        for (auto k = 0; k < d_num_components; ++k)
+        {
+            const auto& variables = decomposition.components[k].variables;
+            for (auto l = 0; l < static_cast<int>(variables.size()); ++l)
+                d_ilp_solution_data.solution[variables[l]] = results[k].solution[l];
+            d_ilp_solution_data.objective += results[k].objective;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ilp_solver_decorator.hpp"
+
+namespace ilp_solver
+{
+    // Splits the collected model into independent components (see ilp_decomposition.hpp)
+    // and solves each component with its own backend. Up to num_threads components are solved in parallel,
+    // each backend getting an equal share of the threads.
+    // A backend is only created when its component starts and destroyed when it has finished,
+    // so that at most num_threads backends exist at once.
+    // The limits are split as follows:
+    // - The time limit applies to the whole solve. Each component gets a share of the remaining time
+    //   proportional to its size (see Component::size).
+    // - The absolute gap is divided equally among the components. Thus, the gaps add up to at most the given one.
+    // - The relative gap, node and solution limits apply to each component.
+    class ILPSolverDecompose : public ILPSolverDecorator
+    {
+        public:
+            explicit ILPSolverDecompose(BackendFactory p_backend_factory);
+
+            // Number of components found by the last solve.
+            int get_num_components() const;
+
+        private:
+            int d_num_components{ 0 };
+
+            void solve_impl() override;
+    };
+}
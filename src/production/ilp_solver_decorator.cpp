@@ -0,0 +1,233 @@
+#include "ilp_solver_decorator.hpp"
+
+#include "ilp_solve_observer.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    static void add_variables(ILPSolverInterface* v_solver, const ILPData& p_data)
+    {
+        const auto num_variables = static_cast<int>(p_data.variable_type.size());
+
+        for (auto variable_idx = 0; variable_idx < num_variables; ++variable_idx)
+        {
+            const auto lower     = p_data.variable_lower[variable_idx];
+            const auto upper     = p_data.variable_upper[variable_idx];
+            const auto objective = p_data.objective[variable_idx];
+
+            switch (p_data.variable_type[variable_idx])
+            {
+            case VariableType::BINARY:
+                // The bounds of a binary variable may have been tightened.
+                if (lower == 0. && upper == 1.)
+                    v_solver->add_variable_boolean(objective);
+                else
+                    v_solver->add_variable_integer(objective, lower, upper);
+                break;
+            case VariableType::INTEGER:
+                v_solver->add_variable_integer(objective, lower, upper);
+                break;
+            case VariableType::CONTINUOUS:
+            default:
+                v_solver->add_variable_continuous(objective, lower, upper);
+                break;
+            }
+        }
+    }
+
+
+    static void add_constraints(ILPSolverInterface* v_solver, const ILPData& p_data)
+    {
+        const auto num_constraints = static_cast<int>(p_data.matrix.size());
+
+        // The matrix is dense. Pass only the non-zeros to the solver.
+        vector<int>    indices;
+        vector<double> values;
+        for (auto i = 0; i < num_constraints; ++i)
+        {
+            const auto& row = p_data.matrix[i];
+
+            indices.clear();
+            values.clear();
+            for (auto j = 0; j < static_cast<int>(row.size()); ++j)
+            {
+                if (row[j] != 0.)
+                {
+                    indices.push_back(j);
+                    values.push_back(row[j]);
+                }
+            }
+
+            // ILPSolverImpl drops constraints without any bound.
+            // Keep them, so that the constraint indices of the solver match those of p_data.
+            const auto lower = p_data.constraint_lower[i];
+            const auto upper = p_data.constraint_upper[i];
+            if (lower < c_neg_inf_bound && upper > c_pos_inf_bound)
+                v_solver->add_constraint(indices, values, c_neg_inf_bound, upper);
+            else
+                v_solver->add_constraint(indices, values, lower, upper);
+        }
+    }
+
+
+    void set_solver_parameters(ILPSolverInterface* v_solver, const ILPData& p_data)
+    {
+        v_solver->set_num_threads       (p_data.num_threads);
+        v_solver->set_deterministic_mode(p_data.deterministic);
+        v_solver->set_log_level         (p_data.log_level);
+        v_solver->set_presolve          (p_data.presolve);
+
+        v_solver->set_max_seconds       (p_data.max_seconds);
+        v_solver->set_max_nodes         (p_data.max_nodes);
+        v_solver->set_max_solutions     (p_data.max_solutions);
+        v_solver->set_max_abs_gap       (p_data.max_abs_gap);
+        v_solver->set_max_rel_gap       (p_data.max_rel_gap);
+    }
+
+
+    void transfer_model(ILPSolverInterface* v_solver, const ILPData& p_data)
+    {
+        add_variables(v_solver, p_data);
+        add_constraints(v_solver, p_data);
+    }
+
+
+    void transfer_ilp_data(ILPSolverInterface* v_solver, const ILPData& p_data)
+    {
+        transfer_model(v_solver, p_data);
+
+        if (!p_data.start_solution.empty())
+            v_solver->set_start_solution(p_data.start_solution);
+
+        set_solver_parameters(v_solver, p_data);
+    }
+
+
+    // set_default_parameters is called in ILPSolverCollect.
+    ILPSolverDecorator::ILPSolverDecorator(BackendFactory p_backend_factory)
+        : d_backend_factory(std::move(p_backend_factory))
+    { }
+
+
+    std::vector<double> ILPSolverDecorator::get_solution() const
+    {
+        return d_ilp_solution_data.solution;
+    }
+
+
+    double ILPSolverDecorator::get_objective() const
+    {
+        return d_ilp_solution_data.objective;
+    }
+
+
+    SolutionStatus ILPSolverDecorator::get_status() const
+    {
+        return d_ilp_solution_data.solution_status;
+    }
+
+
+    void ILPSolverDecorator::reset_solution()
+    {
+        d_ilp_data.start_solution.clear();
+        d_ilp_solution_data = ILPSolutionData(d_ilp_data.objective_sense);
+    }
+
+
+    ILPSolutionData optimize(ILPSolverInterface* v_solver, ObjectiveSense p_sense)
+    {
+        if (p_sense == ObjectiveSense::MINIMIZE)
+            v_solver->minimize();
+        else
+            v_solver->maximize();
+
+        ILPSolutionData solution_data;
+        solution_data.solution        = v_solver->get_solution();
+        solution_data.objective       = v_solver->get_objective();
+        solution_data.solution_status = v_solver->get_status();
+        return solution_data;
+    }
+
+
+    std::unique_ptr<ILPSolverInterface> ILPSolverDecorator::create_backend()
+    {
+        std::unique_ptr<ILPSolverInterface> solver{ d_backend_factory() };
+        if (!solver)
+            throw std::exception("Could not create the backend solver.");
+        return solver;
+    }
+
+
+    ILPSolutionData ILPSolverDecorator::solve_with_backend(const ILPData& p_data)
+    {
+        const auto solver = create_backend();
+        transfer_ilp_data(solver.get(), p_data);
+        if (&p_data == &d_ilp_data)
+            relay_callbacks(solver.get());
+        return optimize_backend(solver.get(), p_data.objective_sense);
+    }
+
+
+    // The observer of this decorator filters and throttles the reports of all its backends at once.
+    // A request to stop reaches the backends at their next progress report.
+    void ILPSolverDecorator::relay_callbacks(ILPSolverInterface* v_backend)
+    {
+        const auto observer = d_observer;
+        if (!observer)
+        {
+            v_backend->set_incumbent_callback(IncumbentCallback());
+            v_backend->set_progress_callback (ProgressCallback(), 0.);
+            return;
+        }
+
+        v_backend->set_incumbent_callback([observer](const IncumbentEvent& p_event)
+        {
+            observer->report_incumbent(p_event.solution, p_event.num_variables, p_event.objective);
+        });
+        v_backend->set_progress_callback([observer](const ProgressEvent& p_event)
+        {
+            return observer->report_progress(p_event.objective, p_event.best_bound, p_event.num_nodes) ? ProgressAction::STOP
+                                                                                                      : ProgressAction::CONTINUE;
+        }, 0.);
+    }
+
+
+    void ILPSolverDecorator::interrupt()
+    {
+        std::lock_guard<std::mutex> lock(d_running_mutex);
+        for (auto* backend: d_running_backends)
+            backend->interrupt();
+    }
+
+
+    // The backend is only registered while it is solving, so that interrupt never reaches a destroyed backend.
+    ILPSolutionData ILPSolverDecorator::optimize_backend(ILPSolverInterface* v_backend, ObjectiveSense p_sense)
+    {
+        struct Registration
+        {
+            Registration(ILPSolverDecorator* v_decorator, ILPSolverInterface* v_backend)
+                : decorator(v_decorator), backend(v_backend)
+            {
+                std::lock_guard<std::mutex> lock(decorator->d_running_mutex);
+                decorator->d_running_backends.push_back(backend);
+            }
+
+            ~Registration()
+            {
+                std::lock_guard<std::mutex> lock(decorator->d_running_mutex);
+                auto& running_backends = decorator->d_running_backends;
+                running_backends.erase(std::find(running_backends.begin(), running_backends.end(), backend));
+            }
+
+            ILPSolverDecorator* decorator;
+            ILPSolverInterface* backend;
+        } registration(this, v_backend);
+
+        return optimize(v_backend, p_sense);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ilp_data.hpp"
+#include "ilp_solver_collect.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ilp_solver
+{
+    // Creates the solver a decorator passes its model on to.
+    // The decorator takes ownership of the created solver.
+    using BackendFactory = std::function<ILPSolverInterface*()>;
+
+
+    // Base class for solvers that collect the model, possibly transform it, and solve it with another solver.
+    // Every solve creates a new backend via the factory, transfers the model and the parameters to it,
+    // and stores the result in form of ILPSolutionData.
+    class ILPSolverDecorator : public ILPSolverCollect
+    {
+        public:
+            std::vector<double>       get_solution  () const override;
+            double                    get_objective () const override;
+            SolutionStatus            get_status    () const override;
+
+            void                      reset_solution()       override;
+
+            // Interrupts the backends that are solving for this decorator at the moment.
+            void                      interrupt     ()       override;
+
+        protected:
+            explicit ILPSolverDecorator(BackendFactory p_backend_factory);
+
+            ILPSolutionData d_ilp_solution_data;
+
+            // Throws if the factory does not create a solver.
+            std::unique_ptr<ILPSolverInterface> create_backend();
+
+            // Solves p_data with a newly created backend.
+            // Only if p_data is the model of the decorator, the backend reports to the callbacks (see relay_callbacks).
+            ILPSolutionData solve_with_backend(const ILPData& p_data);
+
+            // Passes the reports of v_backend on to the observer of the running solve of this decorator,
+            // or removes the callbacks of v_backend if there is none. Only for backends solving the model of the decorator,
+            // since the solutions of a transformed model (e.g. presolved or scaled) do not fit the callbacks.
+            void relay_callbacks(ILPSolverInterface* v_backend);
+
+            // Like optimize, but interrupt reaches v_backend while it is solving.
+            // May be called from several threads at once.
+            ILPSolutionData optimize_backend(ILPSolverInterface* v_backend, ObjectiveSense p_sense);
+
+        private:
+            BackendFactory d_backend_factory;
+
+            std::mutex                        d_running_mutex;
+            std::vector<ILPSolverInterface*>  d_running_backends;
+    };
+
+
+    // Adds the variables and constraints of p_data to a solver without any variables.
+    // The indices of the variables and constraints in the solver are those in p_data.
+    void transfer_model(ILPSolverInterface* v_solver, const ILPData& p_data);
+
+    void set_solver_parameters(ILPSolverInterface* v_solver, const ILPData& p_data);
+
+    // Adds the model, the start solution and the parameters of p_data to a solver without any variables.
+    void transfer_ilp_data(ILPSolverInterface* v_solver, const ILPData& p_data);
+
+    // Minimizes or maximizes and returns the result.
+    ILPSolutionData optimize(ILPSolverInterface* v_solver, ObjectiveSense p_sense);
+}
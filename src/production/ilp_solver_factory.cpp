@@ -1,8 +1,17 @@
 #include "ilp_solver_factory.hpp"
 
+#include "ilp_async_solve.hpp"
+#include "ilp_batch_solver.hpp"
+#include "ilp_solver_cache.hpp"
 #include "ilp_solver_cbc.hpp"
+#include "ilp_solver_collect.hpp"
+#include "ilp_solver_decompose.hpp"
 #include "ilp_solver_gurobi.hpp"
+#include "ilp_solver_portfolio.hpp"
+#include "ilp_solver_presolve.hpp"
+#include "ilp_solver_scaling.hpp"
 #include "ilp_solver_scip.hpp"
+#include "ilp_solver_structure_cache.hpp"
 #include "ilp_solver_stub.hpp"
 
 
@@ -18,6 +27,46 @@ namespace ilp_solver
     }
 
 
+    extern "C" ILPSolverInterface* __stdcall create_solver_cbc_profile([[maybe_unused]] CbcProfile p_profile)
+    {
+#if WITH_CBC == 1
+        return new ILPSolverCbc(p_profile);
+#else
+        return nullptr;
+#endif
+    }
+
+
+    extern "C" bool __stdcall get_cbc_num_nodes([[maybe_unused]] const ILPSolverInterface* p_solver, [[maybe_unused]] int* r_num_nodes)
+    {
+#if WITH_CBC == 1
+        const auto cbc_solver = dynamic_cast<const ILPSolverCbc*>(p_solver);
+        if (!cbc_solver)
+            return false;
+
+        *r_num_nodes = cbc_solver->get_num_nodes();
+        return true;
+#else
+        return false;
+#endif
+    }
+
+
+    extern "C" bool __stdcall set_cbc_warm_start([[maybe_unused]] ILPSolverInterface* p_solver, [[maybe_unused]] bool p_keep_root_basis, [[maybe_unused]] bool p_reset_branch_and_bound_only)
+    {
+#if WITH_CBC == 1
+        const auto cbc_solver = dynamic_cast<ILPSolverCbc*>(p_solver);
+        if (!cbc_solver)
+            return false;
+
+        cbc_solver->set_warm_start(p_keep_root_basis, p_reset_branch_and_bound_only);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+
     extern "C" ILPSolverInterface* __stdcall create_solver_gurobi()
     {
 #if (WITH_GUROBI == 1) && (_WIN64 == 1)
@@ -38,12 +87,297 @@ namespace ilp_solver
     }
 
 
+    extern "C" bool __stdcall set_scip_reoptimization([[maybe_unused]] ILPSolverInterface* p_solver, [[maybe_unused]] bool p_reoptimize)
+    {
+#if WITH_SCIP == 1
+        const auto scip_solver = dynamic_cast<ILPSolverSCIP*>(p_solver);
+        if (!scip_solver)
+            return false;
+
+        scip_solver->set_reoptimization(p_reoptimize);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+
+    extern "C" ILPSolverInterface* __stdcall create_solver_scip_pooled()
+    {
+#if WITH_SCIP == 1
+        return new ILPSolverSCIP(default_scip_pool());
+#else
+        return nullptr;
+#endif
+    }
+
+
+    extern "C" void __stdcall configure_scip_pool([[maybe_unused]] std::size_t p_capacity)
+    {
+#if WITH_SCIP == 1
+        default_scip_pool()->configure(p_capacity);
+#endif
+    }
+
+
+    extern "C" void __stdcall warm_up_scip_pool([[maybe_unused]] std::size_t p_num_environments)
+    {
+#if WITH_SCIP == 1
+        default_scip_pool()->warm_up(p_num_environments);
+#endif
+    }
+
+
+    extern "C" bool __stdcall get_scip_pool_statistics([[maybe_unused]] long long* r_num_created, [[maybe_unused]] long long* r_num_reused,
+                                                       [[maybe_unused]] double* r_creation_seconds, [[maybe_unused]] double* r_reset_seconds)
+    {
+#if WITH_SCIP == 1
+        const auto pool = default_scip_pool();
+        *r_num_created      = pool->num_created();
+        *r_num_reused       = pool->num_reused();
+        *r_creation_seconds = pool->creation_seconds();
+        *r_reset_seconds    = pool->reset_seconds();
+        return true;
+#else
+        return false;
+#endif
+    }
+
+
     extern "C" ILPSolverInterface* __stdcall create_solver_stub(const char* p_executable_basename)
     {
         return new ILPSolverStub(p_executable_basename);
     }
 
 
+    extern "C" ILPSolverInterface* __stdcall create_solver_stub_file_backed(const char* p_executable_basename, std::size_t p_max_shared_memory_bytes)
+    {
+        return new ILPSolverStub(p_executable_basename, p_max_shared_memory_bytes);
+    }
+
+
+    extern "C" ILPSolverInterface* __stdcall create_solver_cache(ILPSolverInterface* (__stdcall* p_create_backend)())
+    {
+        return new ILPSolverCache(p_create_backend);
+    }
+
+
+    extern "C" void __stdcall configure_solution_cache(std::size_t p_capacity, const char* p_directory)
+    {
+        default_solution_cache()->configure(p_capacity, p_directory ? p_directory : "");
+    }
+
+
+    extern "C" void __stdcall get_solution_cache_statistics(long long* r_num_hits, long long* r_num_misses)
+    {
+        const auto cache = default_solution_cache();
+        *r_num_hits   = cache->num_hits();
+        *r_num_misses = cache->num_misses();
+    }
+
+
+    extern "C" ILPSolverInterface* __stdcall create_solver_structure_cache(ILPSolverInterface* (__stdcall* p_create_backend)())
+    {
+        return new ILPSolverStructureCache(p_create_backend, reinterpret_cast<const void*>(p_create_backend));
+    }
+
+
+    extern "C" void __stdcall configure_structure_cache(std::size_t p_capacity)
+    {
+        default_structure_cache()->configure(p_capacity);
+    }
+
+
+    extern "C" void __stdcall get_structure_cache_statistics(long long* r_num_hits, long long* r_num_misses)
+    {
+        const auto cache = default_structure_cache();
+        *r_num_hits   = cache->num_hits();
+        *r_num_misses = cache->num_misses();
+    }
+
+
+    extern "C" ILPSolverInterface* __stdcall create_solver_presolve(ILPSolverInterface* (__stdcall* p_create_backend)())
+    {
+        return new ILPSolverPresolve(p_create_backend);
+    }
+
+
+    extern "C" bool __stdcall get_presolve_statistics(const ILPSolverInterface* p_solver, PresolveStatistics* r_statistics)
+    {
+        const auto presolve_solver = dynamic_cast<const ILPSolverPresolve*>(p_solver);
+        if (!presolve_solver)
+            return false;
+
+        *r_statistics = presolve_solver->get_statistics();
+        return true;
+    }
+
+
+    extern "C" ILPSolverInterface* __stdcall create_solver_decompose(ILPSolverInterface* (__stdcall* p_create_backend)())
+    {
+        return new ILPSolverDecompose(p_create_backend);
+    }
+
+
+    extern "C" ILPSolverInterface* __stdcall create_solver_scaling(ILPSolverInterface* (__stdcall* p_create_backend)(), bool p_geometric)
+    {
+        return new ILPSolverScaling(p_create_backend, p_geometric ? ScalingMethod::GEOMETRIC : ScalingMethod::EQUILIBRATION);
+    }
+
+
+    extern "C" ILPSolverInterface* __stdcall create_solver_portfolio(ILPSolverInterface* (__stdcall* const* p_create_backends)(), int p_num_backends)
+    {
+        return new ILPSolverPortfolio(std::vector<BackendFactory>(p_create_backends, p_create_backends + p_num_backends));
+    }
+
+
+    extern "C" bool __stdcall get_portfolio_winner(const ILPSolverInterface* p_solver, int* r_winner)
+    {
+        const auto portfolio_solver = dynamic_cast<const ILPSolverPortfolio*>(p_solver);
+        if (!portfolio_solver)
+            return false;
+
+        *r_winner = portfolio_solver->get_winner();
+        return true;
+    }
+
+
+    extern "C" bool __stdcall set_portfolio_incumbent_sharing(ILPSolverInterface* p_solver, bool p_share)
+    {
+        const auto portfolio_solver = dynamic_cast<ILPSolverPortfolio*>(p_solver);
+        if (!portfolio_solver)
+            return false;
+
+        portfolio_solver->set_incumbent_sharing(p_share);
+        return true;
+    }
+
+
+    extern "C" ILPSolverInterface* __stdcall create_batch_model(ILPSolverInterface* (__stdcall* p_create_backend)())
+    {
+        return new ILPSolverBatchModel(p_create_backend);
+    }
+
+
+    extern "C" bool __stdcall solve_batch(ILPSolverInterface* const* v_models, int p_num_models, bool p_maximize,
+                                          ILPSolverInterface* (__stdcall* p_create_backend)(), int p_num_threads, double* r_models_per_second)
+    {
+        // No exception may leave this function. Failures are reported by the return value and the failed models.
+        const auto                        sense = p_maximize ? ObjectiveSense::MAXIMIZE : ObjectiveSense::MINIMIZE;
+        std::vector<ILPSolverBatchModel*> models;
+        std::vector<ILPSolutionData>      results;
+        std::vector<std::exception_ptr>   exceptions;
+        *r_models_per_second = 0.;
+        try
+        {
+            models.resize(p_num_models);
+            for (auto k = 0; k < p_num_models; ++k)
+            {
+                models[k] = dynamic_cast<ILPSolverBatchModel*>(v_models[k]);
+                if (!models[k])
+                    return false;
+            }
+
+            std::vector<const ILPData*> data(p_num_models);
+            for (auto k = 0; k < p_num_models; ++k)
+                data[k] = &models[k]->prepare_batch(sense);
+
+            ILPBatchSolver batch_solver(p_create_backend, p_num_threads);
+            batch_solver.solve(data, &results, &exceptions);
+            *r_models_per_second = batch_solver.get_statistics().models_per_second;
+        }
+        catch (...)
+        {
+            // Without the models, no failure can be reported to them.
+            if (static_cast<int>(models.size()) != p_num_models)
+                return false;
+
+            results.clear();
+            for (auto k = 0; k < p_num_models; ++k)
+                results.emplace_back(sense);
+            exceptions.assign(p_num_models, std::current_exception());
+        }
+
+        auto all_solved{ true };
+        for (auto k = 0; k < p_num_models; ++k)
+        {
+            models[k]->set_result(std::move(results[k]), exceptions[k] != nullptr);
+            all_solved = all_solved && !exceptions[k];
+        }
+        return all_solved;
+    }
+
+
+    extern "C" bool __stdcall get_batch_model_failed(const ILPSolverInterface* p_model, bool* r_failed)
+    {
+        const auto* model = dynamic_cast<const ILPSolverBatchModel*>(p_model);
+        if (!model)
+            return false;
+        *r_failed = model->has_failed();
+        return true;
+    }
+
+
+    extern "C" AsyncSolve* __stdcall solve_async(ILPSolverInterface* p_solver, bool p_maximize)
+    {
+        return new AsyncSolve(p_solver, p_maximize ? ObjectiveSense::MAXIMIZE : ObjectiveSense::MINIMIZE);
+    }
+
+
+    extern "C" void __stdcall cancel_solve(AsyncSolve* p_solve)
+    {
+        p_solve->cancel();
+    }
+
+
+    extern "C" bool __stdcall wait_for_solve(AsyncSolve* p_solve, double p_seconds)
+    {
+        return p_solve->wait_for(p_seconds);
+    }
+
+
+    extern "C" bool __stdcall get_solve_incumbent(const AsyncSolve* p_solve, std::vector<double>* r_solution, double* r_objective)
+    {
+        const auto incumbent = p_solve->get_incumbent();
+        if (!incumbent)
+            return false;
+
+        *r_solution  = incumbent->solution;
+        *r_objective = incumbent->objective;
+        return true;
+    }
+
+
+    // The handle is destroyed even if the solve has failed.
+    extern "C" void __stdcall finish_solve(AsyncSolve* p_solve)
+    {
+        const std::unique_ptr<AsyncSolve> solve(p_solve);
+        solve->finish();
+    }
+
+
+    extern "C" bool __stdcall get_model_statistics(const ILPSolverInterface* p_solver, ModelStatistics* r_statistics)
+    {
+        const auto collect_solver = dynamic_cast<const ILPSolverCollect*>(p_solver);
+        if (!collect_solver)
+            return false;
+
+        *r_statistics = collect_solver->get_model_statistics();
+        return true;
+    }
+
+
+    extern "C" bool __stdcall check_solution(const ILPSolverInterface* p_solver, const std::vector<double>& p_solution, double p_tolerance, ViolationReport* r_report)
+    {
+        const auto collect_solver = dynamic_cast<const ILPSolverCollect*>(p_solver);
+        if (!collect_solver)
+            return false;
+
+        *r_report = collect_solver->verify_solution(p_solution, p_tolerance);
+        return true;
+    }
+
+
     extern "C" void __stdcall destroy_solver(ILPSolverInterface* p_solver)
     {
         delete p_solver;
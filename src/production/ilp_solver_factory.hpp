@@ -1,12 +1,21 @@
 #pragma once
 
+#include "ilp_cbc_profile.hpp"
+#include "ilp_model_statistics.hpp"
+#include "ilp_presolve.hpp"
+#include "ilp_solution_verifier.hpp"
 #include "ilp_solver_interface.hpp"
 
+#include <cstddef>
+
 // List of all solvers usable from the .dll.
 // For new solvers, please follow the declarations below.
 
 namespace ilp_solver
 {
+    class AsyncSolve;
+
+
     extern "C"
 #if (WITH_CBC == 1)
     __declspec (dllexport)
@@ -14,6 +23,34 @@ namespace ilp_solver
     ILPSolverInterface* __stdcall create_solver_cbc();
 
 
+    // Like create_solver_cbc, which uses CbcProfile::DEFAULT, but with the given cut generators and heuristics.
+    extern "C"
+#if (WITH_CBC == 1)
+    __declspec (dllexport)
+#endif
+    ILPSolverInterface* __stdcall create_solver_cbc_profile(CbcProfile p_profile);
+
+
+    // Number of branch and bound nodes of the last solve of a solver created by create_solver_cbc[_profile].
+    // Returns false for all other solvers.
+    extern "C"
+#if (WITH_CBC == 1)
+    __declspec (dllexport)
+#endif
+    bool __stdcall get_cbc_num_nodes(const ILPSolverInterface* p_solver, int* r_num_nodes);
+
+
+    // Speeds up re-solving modified models with a solver created by create_solver_cbc[_profile].
+    // If p_keep_root_basis is set, the next solve starts from the basis of the last root LP.
+    // If p_reset_branch_and_bound_only is set, reset_solution keeps the model loaded in the LP solver.
+    // Returns false for all other solvers.
+    extern "C"
+#if (WITH_CBC == 1)
+    __declspec (dllexport)
+#endif
+    bool __stdcall set_cbc_warm_start(ILPSolverInterface* p_solver, bool p_keep_root_basis, bool p_reset_branch_and_bound_only);
+
+
     extern "C"
 #if (WITH_SCIP == 1)
     __declspec (dllexport)
@@ -21,6 +58,53 @@ namespace ilp_solver
     ILPSolverInterface* __stdcall create_solver_scip();
 
 
+    // Enables or disables reoptimization for a solver created by create_solver_scip.
+    // Speeds up re-solving a model after changing only its objective, see ILPSolverSCIP::set_reoptimization.
+    // Returns false for all other solvers.
+    extern "C"
+#if (WITH_SCIP == 1)
+    __declspec (dllexport)
+#endif
+    bool __stdcall set_scip_reoptimization(ILPSolverInterface* p_solver, bool p_reoptimize);
+
+
+    // Like create_solver_scip, but takes a SCIP environment from a pool shared by all solvers created this way
+    // and returns it to the pool on destruction. Avoids including the SCIP plugins for every solver.
+    extern "C"
+#if (WITH_SCIP == 1)
+    __declspec (dllexport)
+#endif
+    ILPSolverInterface* __stdcall create_solver_scip_pooled();
+
+
+    // Sets the maximum number of unused SCIP environments kept by the pool (default: 16).
+    // Does nothing without SCIP.
+    extern "C"
+#if (WITH_SCIP == 1)
+    __declspec (dllexport)
+#endif
+    void __stdcall configure_scip_pool(std::size_t p_capacity);
+
+
+    // Creates SCIP environments until the pool contains p_num_environments, but at most its capacity.
+    // Call this on startup to avoid the creation latency for the first solvers. Does nothing without SCIP.
+    extern "C"
+#if (WITH_SCIP == 1)
+    __declspec (dllexport)
+#endif
+    void __stdcall warm_up_scip_pool(std::size_t p_num_environments);
+
+
+    // Number of SCIP environments created and reused by the pool,
+    // and the total time spent for creating them and for resetting them for reuse.
+    // Returns false without SCIP.
+    extern "C"
+#if (WITH_SCIP == 1)
+    __declspec (dllexport)
+#endif
+    bool __stdcall get_scip_pool_statistics(long long* r_num_created, long long* r_num_reused, double* r_creation_seconds, double* r_reset_seconds);
+
+
     extern "C"
 #if (WITH_GUROBI == 1) && (_WIN64 == 1)
     __declspec (dllexport)
@@ -35,6 +119,174 @@ namespace ilp_solver
     ILPSolverInterface* __stdcall create_solver_stub(const char* p_executable_basename);
 
 
+    // Like create_solver_stub, but models that need more than p_max_shared_memory_bytes
+    // are handed to the solver executable via a temporary file instead of shared memory.
+    extern "C"
+#if (WITH_CBC == 1)
+    __declspec (dllexport)
+#endif
+    ILPSolverInterface* __stdcall create_solver_stub_file_backed(const char* p_executable_basename, std::size_t p_max_shared_memory_bytes);
+
+
+    // Solver that looks up proven solutions of identical models in a cache shared by all such solvers,
+    // and solves the model with a solver created by p_create_backend otherwise, e.g. create_solver_cbc.
+    extern "C"
+    __declspec (dllexport)
+    ILPSolverInterface* __stdcall create_solver_cache(ILPSolverInterface* (__stdcall* p_create_backend)());
+
+
+    // Sets the number of solutions kept in memory by the cache of create_solver_cache.
+    // If p_directory is neither nullptr nor empty, solutions are also stored in and looked up from this directory.
+    extern "C"
+    __declspec (dllexport)
+    void __stdcall configure_solution_cache(std::size_t p_capacity, const char* p_directory);
+
+
+    extern "C"
+    __declspec (dllexport)
+    void __stdcall get_solution_cache_statistics(long long* r_num_hits, long long* r_num_misses);
+
+
+    // Solver that reuses solvers created by p_create_backend for models with the same matrix and variable types.
+    // Only the bounds, right-hand sides and objective coefficients that differ are transferred to a reused solver.
+    extern "C"
+    __declspec (dllexport)
+    ILPSolverInterface* __stdcall create_solver_structure_cache(ILPSolverInterface* (__stdcall* p_create_backend)());
+
+
+    // Sets the number of solvers kept by the cache of create_solver_structure_cache.
+    extern "C"
+    __declspec (dllexport)
+    void __stdcall configure_structure_cache(std::size_t p_capacity);
+
+
+    extern "C"
+    __declspec (dllexport)
+    void __stdcall get_structure_cache_statistics(long long* r_num_hits, long long* r_num_misses);
+
+
+    // Solver that removes fixed variables and simple constraints before passing the model
+    // to a solver created by p_create_backend.
+    extern "C"
+    __declspec (dllexport)
+    ILPSolverInterface* __stdcall create_solver_presolve(ILPSolverInterface* (__stdcall* p_create_backend)());
+
+
+    // Reductions and bound propagation of the last solve of a solver created by create_solver_presolve,
+    // all zero if presolve was switched off. Returns false for all other solvers.
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall get_presolve_statistics(const ILPSolverInterface* p_solver, PresolveStatistics* r_statistics);
+
+
+    // Solver that splits the model into independent components and solves them in parallel
+    // (up to set_num_threads at once), each with its own solver created by p_create_backend.
+    extern "C"
+    __declspec (dllexport)
+    ILPSolverInterface* __stdcall create_solver_decompose(ILPSolverInterface* (__stdcall* p_create_backend)());
+
+
+    // Solver that scales rows and continuous columns before passing the model to a solver created by p_create_backend.
+    // If p_geometric is set, geometric mean scaling is applied before the equilibration.
+    extern "C"
+    __declspec (dllexport)
+    ILPSolverInterface* __stdcall create_solver_scaling(ILPSolverInterface* (__stdcall* p_create_backend)(), bool p_geometric);
+
+
+    // Solver that solves the model with p_num_backends solvers at once, one created by each of p_create_backends,
+    // e.g. create_solver_cbc and create_solver_scip. The first one proving optimality (or infeasibility) wins
+    // and the others are interrupted. Otherwise, the best solution found within the limits is returned.
+    extern "C"
+    __declspec (dllexport)
+    ILPSolverInterface* __stdcall create_solver_portfolio(ILPSolverInterface* (__stdcall* const* p_create_backends)(), int p_num_backends);
+
+
+    // Index into p_create_backends of the solver whose result was returned by the last solve of a solver
+    // created by create_solver_portfolio, or -1. Returns false for all other solvers.
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall get_portfolio_winner(const ILPSolverInterface* p_solver, int* r_winner);
+
+
+    // Whether the backends of a solver created by create_solver_portfolio share their solutions while solving,
+    // which is the default. Returns false for all other solvers.
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall set_portfolio_incumbent_sharing(ILPSolverInterface* p_solver, bool p_share);
+
+
+    // Collects a model for solve_batch. Solving it on its own solves it with a new solver created by p_create_backend.
+    extern "C"
+    __declspec (dllexport)
+    ILPSolverInterface* __stdcall create_batch_model(ILPSolverInterface* (__stdcall* p_create_backend)());
+
+
+    // [Minimizes | Maximizes] the p_num_models models created by create_batch_model on p_num_threads threads
+    // (0: one per core), each model with a single thread. Every thread reuses one solver created by p_create_backend
+    // for all its models. Afterwards, get_solution, get_objective and get_status of each model return its result.
+    // If a model fails, the others are solved nonetheless. The failed models have no solution (see get_batch_model_failed).
+    // Returns false if some model has failed, or without solving if any of the models has not been created by create_batch_model.
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall solve_batch(ILPSolverInterface* const* v_models, int p_num_models, bool p_maximize,
+                               ILPSolverInterface* (__stdcall* p_create_backend)(), int p_num_threads, double* r_models_per_second);
+
+
+    // Whether the last solve_batch has failed for p_model.
+    // Returns false for all solvers not created by create_batch_model.
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall get_batch_model_failed(const ILPSolverInterface* p_model, bool* r_failed);
+
+
+    // Starts to [minimize | maximize] p_solver on a separate thread and returns immediately.
+    // p_solver must not be used otherwise until finish_solve has been called. Afterwards, it holds the result as usual.
+    extern "C"
+    __declspec (dllexport)
+    AsyncSolve* __stdcall solve_async(ILPSolverInterface* p_solver, bool p_maximize);
+
+
+    // Asks the solve to stop as soon as possible with the best solution found so far, via interrupt. Does not wait.
+    extern "C"
+    __declspec (dllexport)
+    void __stdcall cancel_solve(AsyncSolve* p_solve);
+
+
+    // Waits at most p_seconds (0: not at all) and returns whether the solve has finished.
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall wait_for_solve(AsyncSolve* p_solve, double p_seconds);
+
+
+    // The best solution found so far by the solve. Returns false if none has been found yet
+    // or the solver does not support shared incumbents (see ILPSolverImpl::set_shared_incumbent).
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall get_solve_incumbent(const AsyncSolve* p_solve, std::vector<double>* r_solution, double* r_objective);
+
+
+    // Waits for the solve, destroys p_solve and rethrows the exception of the solve, if any.
+    extern "C"
+    __declspec (dllexport)
+    void __stdcall finish_solve(AsyncSolve* p_solve);
+
+
+    // Statistics of the model held by p_solver: counts, non-zero histograms and magnitude ranges.
+    // Only available for solvers that collect the model themselves (stubs and the solvers
+    // created with a backend factory above). Returns false for all other solvers.
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall get_model_statistics(const ILPSolverInterface* p_solver, ModelStatistics* r_statistics);
+
+
+    // Checks constraints, bounds and integrality of p_solution against the model held by p_solver
+    // and computes its objective. Use it on get_solution() or before set_start_solution().
+    // Like get_model_statistics, only available for solvers that collect the model themselves.
+    extern "C"
+    __declspec (dllexport)
+    bool __stdcall check_solution(const ILPSolverInterface* p_solver, const std::vector<double>& p_solution, double p_tolerance, ViolationReport* r_report);
+
+
     extern "C"
     __declspec (dllexport)
     void __stdcall destroy_solver(ILPSolverInterface* p_solver);
@@ -2,8 +2,11 @@
 
 #include "ilp_solver_gurobi.hpp"
 
+#include "ilp_solve_observer.hpp"
+
 #include <cassert>
 #include <algorithm>
+#include <vector>
 
 
 namespace ilp_solver
@@ -36,6 +39,63 @@ namespace ilp_solver
                 for (int i = old_size; i < p_size; ++i) p_vec.push_back(i);
             }
         }
+
+
+        // What the callback needs to know during a solve, see solve_impl.
+        struct CallbackData
+        {
+            SolveObserver* observer;
+            int            num_vars;
+        };
+
+
+        // Exceptions must not pass Gurobi, which is written in C.
+        // A request to stop of the observer terminates the solve like interrupt.
+        int __stdcall solve_callback(GRBmodel* p_model, void* p_cbdata, int p_where, void* p_usrdata)
+        {
+            const auto* data = static_cast<const CallbackData*>(p_usrdata);
+            auto stop{ false };
+            try
+            {
+                if (p_where == GRB_CB_MIPSOL)
+                {
+                    std::vector<double> solution(data->num_vars);
+                    double objective{ 0. };
+                    auto retcode = GRBcbget(p_cbdata, p_where, GRB_CB_MIPSOL_SOL, solution.data());
+                    if (retcode == 0)
+                        retcode = GRBcbget(p_cbdata, p_where, GRB_CB_MIPSOL_OBJ, &objective);
+                    if (retcode != 0)
+                        return retcode;
+                    stop = data->observer->report_incumbent(solution.data(), data->num_vars, objective);
+                }
+                else if (p_where == GRB_CB_MIP)
+                {
+                    double objective{ 0. };
+                    double bound    { 0. };
+                    double num_nodes{ 0. };
+                    int    num_sols { 0 };
+                    auto retcode = GRBcbget(p_cbdata, p_where, GRB_CB_MIP_OBJBST, &objective);
+                    if (retcode == 0) retcode = GRBcbget(p_cbdata, p_where, GRB_CB_MIP_OBJBND, &bound);
+                    if (retcode == 0) retcode = GRBcbget(p_cbdata, p_where, GRB_CB_MIP_NODCNT, &num_nodes);
+                    if (retcode == 0) retcode = GRBcbget(p_cbdata, p_where, GRB_CB_MIP_SOLCNT, &num_sols);
+                    if (retcode != 0)
+                        return retcode;
+
+                    // Without a solution, the objective is GRB_INFINITY in the direction of the objective sense.
+                    if (num_sols == 0)
+                        objective = (objective > 0.) ? c_pos_inf : c_neg_inf;
+                    stop = data->observer->report_progress(objective, bound, static_cast<long long>(num_nodes));
+                }
+            }
+            catch (...)
+            {
+                return GRB_ERROR_OUT_OF_MEMORY;
+            }
+
+            if (stop)
+                GRBterminate(p_model);
+            return 0;
+        }
     }
 
 
@@ -139,6 +199,13 @@ namespace ilp_solver
     }
 
 
+    // Gurobi allows this from another thread.
+    void ILPSolverGurobi::interrupt()
+    {
+        GRBterminate(d_model);
+    }
+
+
     void ILPSolverGurobi::set_num_threads(int p_num_threads)
     {
         assert( p_num_threads >= 0 );
@@ -284,31 +351,165 @@ namespace ilp_solver
         {
             call_gurobi( d_model, GRBaddconstr, d_model, num, indices, values, GRB_EQUAL, p_lower_bound, p_name.c_str() );
             ++d_num_cons;
+            d_is_range_constraint.push_back(false);
         }
         else
         {
             if (p_lower_bound >= c_neg_inf_bound)
             {
-                if (p_upper_bound <= c_pos_inf_bound)
+                const auto is_range = (p_upper_bound <= c_pos_inf_bound);
+                if (is_range)
                     call_gurobi( d_model, GRBaddrangeconstr, d_model, num, indices, values, p_lower_bound, p_upper_bound, p_name.c_str() );
                 else
                     call_gurobi( d_model, GRBaddconstr, d_model, num, indices, values, GRB_GREATER_EQUAL, p_lower_bound, p_name.c_str() );
                 ++d_num_cons;
+                d_is_range_constraint.push_back(is_range);
             }
             else
             {
-                if (p_upper_bound <= c_pos_inf_bound)
-                {
-                    call_gurobi( d_model, GRBaddconstr, d_model, num, indices, values, GRB_LESS_EQUAL, p_upper_bound, p_name.c_str() );
-                    ++d_num_cons;
-                }
+                // A constraint without bounds is kept as well, so that the constraint indices match those of the caller.
+                call_gurobi( d_model, GRBaddconstr, d_model, num, indices, values, GRB_LESS_EQUAL, std::min(p_upper_bound, GRB_INFINITY), p_name.c_str() );
+                ++d_num_cons;
+                d_is_range_constraint.push_back(false);
             }
         }
     }
 
 
+    void ILPSolverGurobi::set_variable_bounds_impl(int p_variable_index, double p_lower_bound, double p_upper_bound)
+    {
+        call_gurobi( d_model, GRBsetdblattrelement, d_model, GRB_DBL_ATTR_LB, p_variable_index, p_lower_bound );
+        call_gurobi( d_model, GRBsetdblattrelement, d_model, GRB_DBL_ATTR_UB, p_variable_index, p_upper_bound );
+    }
+
+
+    // A range constraint keeps its range variable. Other constraints get one when they become a range.
+    void ILPSolverGurobi::set_constraint_bounds_impl(int p_constraint_index, double p_lower_bound, double p_upper_bound)
+    {
+        const auto has_lower = (p_lower_bound >= c_neg_inf_bound);
+        const auto has_upper = (p_upper_bound <= c_pos_inf_bound);
+        if (d_is_range_constraint[p_constraint_index] || (has_lower && has_upper && p_lower_bound != p_upper_bound))
+        {
+            set_range_bounds(p_constraint_index, p_lower_bound, p_upper_bound);
+            return;
+        }
+
+        // A constraint without bounds becomes a <= constraint with infinite right-hand side.
+        const char   sense = (p_lower_bound == p_upper_bound) ? GRB_EQUAL : (has_lower ? GRB_GREATER_EQUAL : GRB_LESS_EQUAL);
+        const double rhs   = has_lower ? p_lower_bound : std::min(p_upper_bound, GRB_INFINITY);
+        call_gurobi( d_model, GRBsetcharattrelement, d_model, GRB_CHAR_ATTR_SENSE, p_constraint_index, sense );
+        call_gurobi( d_model, GRBsetdblattrelement,  d_model, GRB_DBL_ATTR_RHS,    p_constraint_index, rhs   );
+    }
+
+
+    // Gurobi stores a range constraint as the equality a*x + c*r = rhs with a range variable r, which is appended behind the variables
+    // (see GRBaddrangeconstr). With rhs = 0, the bounds of the constraint become bounds of r, whatever the sign of c.
+    void ILPSolverGurobi::set_range_bounds(int p_constraint_index, double p_lower_bound, double p_upper_bound)
+    {
+        const auto lower = std::max(p_lower_bound, -GRB_INFINITY);
+        const auto upper = std::min(p_upper_bound,  GRB_INFINITY);
+
+        if (!d_is_range_constraint[p_constraint_index])
+        {
+            auto index{ p_constraint_index };
+            auto value{ -1. };
+            call_gurobi( d_model, GRBaddvar, d_model, 1, &index, &value, 0., lower, upper, GRB_CONTINUOUS, nullptr );
+            call_gurobi( d_model, GRBsetcharattrelement, d_model, GRB_CHAR_ATTR_SENSE, p_constraint_index, GRB_EQUAL );
+            call_gurobi( d_model, GRBsetdblattrelement,  d_model, GRB_DBL_ATTR_RHS,    p_constraint_index, 0. );
+            d_is_range_constraint[p_constraint_index] = true;
+            return;
+        }
+
+        // The range variable is the only variable of the row behind the variables of the model.
+        call_gurobi( d_model, GRBupdatemodel, d_model );
+        auto num_non_zeros{ 0 };
+        call_gurobi( d_model, GRBgetconstrs, d_model, &num_non_zeros, nullptr, nullptr, nullptr, p_constraint_index, 1 );
+        std::vector<int>    begin(1);
+        std::vector<int>    indices(num_non_zeros);
+        std::vector<double> values (num_non_zeros);
+        call_gurobi( d_model, GRBgetconstrs, d_model, &num_non_zeros, begin.data(), indices.data(), values.data(), p_constraint_index, 1 );
+
+        const auto position = std::find_if(indices.begin(), indices.end(), [this](int p_index) { return p_index >= d_num_vars; });
+        if (position == indices.end())
+            throw std::exception("Gurobi Error: \"The range variable of a range constraint is missing.\"");
+        const auto range_variable = *position;
+        const auto coefficient    = values[position - indices.begin()];
+
+        call_gurobi( d_model, GRBsetdblattrelement, d_model, GRB_DBL_ATTR_RHS, p_constraint_index, 0. );
+        call_gurobi( d_model, GRBsetdblattrelement, d_model, GRB_DBL_ATTR_LB,  range_variable, (coefficient < 0.) ? lower : -upper );
+        call_gurobi( d_model, GRBsetdblattrelement, d_model, GRB_DBL_ATTR_UB,  range_variable, (coefficient < 0.) ? upper : -lower );
+    }
+
+
+    void ILPSolverGurobi::set_objective_coefficient_impl(int p_variable_index, double p_objective)
+    {
+        call_gurobi( d_model, GRBsetdblattrelement, d_model, GRB_DBL_ATTR_OBJ, p_variable_index, p_objective );
+    }
+
+
+    void ILPSolverGurobi::set_coefficient_impl(int p_constraint_index, int p_variable_index, double p_value)
+    {
+        call_gurobi( d_model, GRBchgcoeffs, d_model, 1, &p_constraint_index, &p_variable_index, &p_value );
+    }
+
+
+    // Gurobi is not const-correct, thus the const_casts.
+    void ILPSolverGurobi::set_variable_bounds_batch_impl(const std::vector<int>& p_variable_indices, const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds)
+    {
+        const auto num     = static_cast<int>(p_variable_indices.size());
+        auto*      indices = const_cast<int*>(p_variable_indices.data());
+        call_gurobi( d_model, GRBsetdblattrlist, d_model, GRB_DBL_ATTR_LB, num, indices, const_cast<double*>(p_lower_bounds.data()) );
+        call_gurobi( d_model, GRBsetdblattrlist, d_model, GRB_DBL_ATTR_UB, num, indices, const_cast<double*>(p_upper_bounds.data()) );
+    }
+
+
+    void ILPSolverGurobi::set_objective_coefficient_batch_impl(const std::vector<int>& p_variable_indices, const std::vector<double>& p_objectives)
+    {
+        call_gurobi( d_model, GRBsetdblattrlist, d_model, GRB_DBL_ATTR_OBJ, static_cast<int>(p_variable_indices.size()),
+                     const_cast<int*>(p_variable_indices.data()), const_cast<double*>(p_objectives.data()) );
+    }
+
+
+    void ILPSolverGurobi::set_coefficient_batch_impl(const std::vector<int>& p_constraint_indices, const std::vector<int>& p_variable_indices, const std::vector<double>& p_values)
+    {
+        call_gurobi( d_model, GRBchgcoeffs, d_model, static_cast<int>(p_values.size()), const_cast<int*>(p_constraint_indices.data()),
+                     const_cast<int*>(p_variable_indices.data()), const_cast<double*>(p_values.data()) );
+    }
+
+
+    void ILPSolverGurobi::delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping)
+    {
+        call_gurobi( d_model, GRBdelconstrs, d_model, static_cast<int>(p_deleted_indices.size()), const_cast<int*>(p_deleted_indices.data()) );
+        d_num_cons -= static_cast<int>(p_deleted_indices.size());
+        compact(&d_is_range_constraint, p_index_mapping);
+    }
+
+
+    void ILPSolverGurobi::delete_variables_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& /* p_index_mapping */)
+    {
+        call_gurobi( d_model, GRBdelvars, d_model, static_cast<int>(p_deleted_indices.size()), const_cast<int*>(p_deleted_indices.data()) );
+        d_num_vars -= static_cast<int>(p_deleted_indices.size());
+    }
+
+
     void ILPSolverGurobi::solve_impl()
     {
+        if (!d_observer)
+        {
+            call_gurobi( d_model, GRBoptimize, d_model );
+            return;
+        }
+
+        // The callback is removed even if the solve fails, since the data only lives during the solve.
+        CallbackData data{ d_observer.get(), d_num_vars };
+        call_gurobi( d_model, GRBsetcallbackfunc, d_model, solve_callback, &data );
+        struct CallbackRemover
+        {
+            ~CallbackRemover() { GRBsetcallbackfunc(model, nullptr, nullptr); }
+
+            GRBmodel* model;
+        } callback_remover{ d_model };
+
         call_gurobi( d_model, GRBoptimize, d_model );
     }
 
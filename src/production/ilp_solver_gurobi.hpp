@@ -32,6 +32,7 @@ namespace ilp_solver
 
             void set_start_solution(const std::vector<double>& p_solution) override;
             void reset_solution    ()                                      override;
+            void interrupt         ()                                      override;
 
             void set_num_threads       (int p_num_threads)    override;
             void set_deterministic_mode(bool p_deterministic) override;
@@ -54,6 +55,10 @@ namespace ilp_solver
             int              d_num_vars{ 0 };
             int              d_num_cons{ 0 };
 
+            // Gurobi models range constraints by an additional variable behind the variables of the model.
+            // Their bounds are changed via the bounds of that variable (see set_range_bounds).
+            std::vector<bool> d_is_range_constraint;
+
             void add_variable_impl (VariableType p_type, double p_objective, double p_lower_bound, double p_upper_bound,
                 const std::string& p_name = "", const std::vector<double>* p_row_values = nullptr,
                 const std::vector<int>* p_row_indices = nullptr) override;
@@ -63,6 +68,20 @@ namespace ilp_solver
                 const std::vector<double>& p_col_values, const std::string& p_name = "",
                 const std::vector<int>* p_col_indices = nullptr) override;
 
+            void set_variable_bounds_impl      (int p_variable_index,   double p_lower_bound, double p_upper_bound) override;
+            void set_constraint_bounds_impl    (int p_constraint_index, double p_lower_bound, double p_upper_bound) override;
+            void set_objective_coefficient_impl(int p_variable_index,   double p_objective)                         override;
+            void set_coefficient_impl          (int p_constraint_index, int p_variable_index, double p_value)       override;
+
+            void set_variable_bounds_batch_impl      (const std::vector<int>& p_variable_indices,   const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds) override;
+            void set_objective_coefficient_batch_impl(const std::vector<int>& p_variable_indices,   const std::vector<double>& p_objectives)                                             override;
+            void set_coefficient_batch_impl          (const std::vector<int>& p_constraint_indices, const std::vector<int>& p_variable_indices, const std::vector<double>& p_values)      override;
+
+            void delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
+            void delete_variables_impl  (const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
+
+            void set_range_bounds(int p_constraint_index, double p_lower_bound, double p_upper_bound);
+
             void solve_impl() override;
             void set_objective_sense_impl(ObjectiveSense p_sense) override;
     };
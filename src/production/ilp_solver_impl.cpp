@@ -1,7 +1,11 @@
 #include "ilp_solver_impl.hpp"
 
+#include "ilp_solve_observer.hpp"
+
 #include <cassert>
 #include <limits>
+#include <memory>
+#include <stdexcept>
 
 using std::string;
 using std::vector;
@@ -138,11 +142,15 @@ namespace ilp_solver
     { }
 
 
+    void ILPSolverImpl::interrupt()
+    { }
+
+
     void ILPSolverImpl::minimize()
     {
         prepare_impl();
         set_objective_sense_impl(ObjectiveSense::MINIMIZE);
-        solve_impl();
+        observe_solve(ObjectiveSense::MINIMIZE);
     }
 
 
@@ -150,6 +158,199 @@ namespace ilp_solver
     {
         prepare_impl();
         set_objective_sense_impl(ObjectiveSense::MAXIMIZE);
+        observe_solve(ObjectiveSense::MAXIMIZE);
+    }
+
+
+    void ILPSolverImpl::set_incumbent_callback(IncumbentCallback p_callback)
+    {
+        d_incumbent_callback = std::move(p_callback);
+    }
+
+
+    void ILPSolverImpl::set_progress_callback(ProgressCallback p_callback, double p_interval_seconds)
+    {
+        d_progress_callback         = std::move(p_callback);
+        d_progress_interval_seconds = p_interval_seconds;
+    }
+
+
+    // A new observer for every solve, so that the time, the best solution and a request to stop start afresh.
+    void ILPSolverImpl::observe_solve(ObjectiveSense p_sense)
+    {
+        if (!d_incumbent_callback && !d_progress_callback)
+        {
+            solve_impl();
+            return;
+        }
+
+        const auto observer = std::make_shared<SolveObserver>(p_sense, d_incumbent_callback, d_progress_callback, d_progress_interval_seconds);
+        struct ObserverScope
+        {
+            ObserverScope(ILPSolverImpl* v_solver, std::shared_ptr<SolveObserver> p_observer) : solver(v_solver) { solver->d_observer = std::move(p_observer); }
+            ~ObserverScope()                                                                                    { solver->d_observer = nullptr; }
+
+            ILPSolverImpl* solver;
+        } observer_scope(this, observer);
+
         solve_impl();
+        observer->rethrow_callback_exception();
+    }
+
+
+    static void check_index(int p_index, int p_size, const char* p_message)
+    {
+        if (p_index < 0 || p_index >= p_size)
+            throw std::exception(p_message);
+    }
+
+
+    static void check_indices(const vector<int>& p_indices, int p_size, const char* p_message)
+    {
+        for (auto index: p_indices)
+            check_index(index, p_size, p_message);
+    }
+
+
+    static void check_sizes(std::size_t p_num_indices, std::size_t p_num_values)
+    {
+        if (p_num_indices != p_num_values)
+            throw std::exception("Numbers of indices and values differ.");
+    }
+
+
+    void ILPSolverImpl::set_variable_bounds(int p_variable_index, double p_lower_bound, double p_upper_bound)
+    {
+        check_index(p_variable_index, get_num_variables(), "Variable index out of range.");
+        set_variable_bounds_impl(p_variable_index, p_lower_bound, p_upper_bound);
+    }
+
+
+    void ILPSolverImpl::set_variable_bounds(const vector<int>& p_variable_indices, const vector<double>& p_lower_bounds, const vector<double>& p_upper_bounds)
+    {
+        check_sizes(p_variable_indices.size(), p_lower_bounds.size());
+        check_sizes(p_variable_indices.size(), p_upper_bounds.size());
+        check_indices(p_variable_indices, get_num_variables(), "Variable index out of range.");
+        set_variable_bounds_batch_impl(p_variable_indices, p_lower_bounds, p_upper_bounds);
+    }
+
+
+    void ILPSolverImpl::set_constraint_bounds(int p_constraint_index, double p_lower_bound, double p_upper_bound)
+    {
+        check_index(p_constraint_index, get_num_constraints(), "Constraint index out of range.");
+        set_constraint_bounds_impl(p_constraint_index, p_lower_bound, p_upper_bound);
+    }
+
+
+    void ILPSolverImpl::set_constraint_bounds(const vector<int>& p_constraint_indices, const vector<double>& p_lower_bounds, const vector<double>& p_upper_bounds)
+    {
+        check_sizes(p_constraint_indices.size(), p_lower_bounds.size());
+        check_sizes(p_constraint_indices.size(), p_upper_bounds.size());
+        check_indices(p_constraint_indices, get_num_constraints(), "Constraint index out of range.");
+        set_constraint_bounds_batch_impl(p_constraint_indices, p_lower_bounds, p_upper_bounds);
+    }
+
+
+    void ILPSolverImpl::set_objective_coefficient(int p_variable_index, double p_objective)
+    {
+        check_index(p_variable_index, get_num_variables(), "Variable index out of range.");
+        set_objective_coefficient_impl(p_variable_index, p_objective);
+    }
+
+
+    void ILPSolverImpl::set_objective_coefficient(const vector<int>& p_variable_indices, const vector<double>& p_objectives)
+    {
+        check_sizes(p_variable_indices.size(), p_objectives.size());
+        check_indices(p_variable_indices, get_num_variables(), "Variable index out of range.");
+        set_objective_coefficient_batch_impl(p_variable_indices, p_objectives);
+    }
+
+
+    void ILPSolverImpl::set_coefficient(int p_constraint_index, int p_variable_index, double p_value)
+    {
+        check_index(p_constraint_index, get_num_constraints(), "Constraint index out of range.");
+        check_index(p_variable_index,   get_num_variables(),   "Variable index out of range.");
+        set_coefficient_impl(p_constraint_index, p_variable_index, p_value);
+    }
+
+
+    void ILPSolverImpl::set_coefficient(const vector<int>& p_constraint_indices, const vector<int>& p_variable_indices, const vector<double>& p_values)
+    {
+        check_sizes(p_constraint_indices.size(), p_values.size());
+        check_sizes(p_variable_indices.size(),   p_values.size());
+        check_indices(p_constraint_indices, get_num_constraints(), "Constraint index out of range.");
+        check_indices(p_variable_indices,   get_num_variables(),   "Variable index out of range.");
+        set_coefficient_batch_impl(p_constraint_indices, p_variable_indices, p_values);
+    }
+
+
+    // Returns the new index of every old index, or -1 for deleted ones, and the sorted deleted indices without duplicates.
+    static vector<int> index_mapping(const vector<int>& p_deleted_indices, int p_size, vector<int>* r_sorted_deleted_indices)
+    {
+        vector<int> mapping(p_size, 0);
+        for (auto index: p_deleted_indices)
+            mapping[index] = -1;
+
+        auto new_index = 0;
+        for (auto i = 0; i < p_size; ++i)
+        {
+            if (mapping[i] < 0)
+                r_sorted_deleted_indices->push_back(i);
+            else
+                mapping[i] = new_index++;
+        }
+        return mapping;
+    }
+
+
+    vector<int> ILPSolverImpl::delete_constraints(const vector<int>& p_constraint_indices)
+    {
+        check_indices(p_constraint_indices, get_num_constraints(), "Constraint index out of range.");
+
+        vector<int> deleted_indices;
+        auto mapping = index_mapping(p_constraint_indices, get_num_constraints(), &deleted_indices);
+        if (!deleted_indices.empty())
+            delete_constraints_impl(deleted_indices, mapping);
+        return mapping;
+    }
+
+
+    vector<int> ILPSolverImpl::delete_variables(const vector<int>& p_variable_indices)
+    {
+        check_indices(p_variable_indices, get_num_variables(), "Variable index out of range.");
+
+        vector<int> deleted_indices;
+        auto mapping = index_mapping(p_variable_indices, get_num_variables(), &deleted_indices);
+        if (!deleted_indices.empty())
+            delete_variables_impl(deleted_indices, mapping);
+        return mapping;
+    }
+
+
+    void ILPSolverImpl::set_variable_bounds_batch_impl(const vector<int>& p_variable_indices, const vector<double>& p_lower_bounds, const vector<double>& p_upper_bounds)
+    {
+        for (auto k = 0; k < static_cast<int>(p_variable_indices.size()); ++k)
+            set_variable_bounds_impl(p_variable_indices[k], p_lower_bounds[k], p_upper_bounds[k]);
+    }
+
+
+    void ILPSolverImpl::set_constraint_bounds_batch_impl(const vector<int>& p_constraint_indices, const vector<double>& p_lower_bounds, const vector<double>& p_upper_bounds)
+    {
+        for (auto k = 0; k < static_cast<int>(p_constraint_indices.size()); ++k)
+            set_constraint_bounds_impl(p_constraint_indices[k], p_lower_bounds[k], p_upper_bounds[k]);
+    }
+
+
+    void ILPSolverImpl::set_objective_coefficient_batch_impl(const vector<int>& p_variable_indices, const vector<double>& p_objectives)
+    {
+        for (auto k = 0; k < static_cast<int>(p_variable_indices.size()); ++k)
+            set_objective_coefficient_impl(p_variable_indices[k], p_objectives[k]);
+    }
+
+
+    void ILPSolverImpl::set_coefficient_batch_impl(const vector<int>& p_constraint_indices, const vector<int>& p_variable_indices, const vector<double>& p_values)
+    {
+        for (auto k = 0; k < static_cast<int>(p_values.size()); ++k)
+            set_coefficient_impl(p_constraint_indices[k], p_variable_indices[k], p_values[k]);
     }
 }
@@ -2,6 +2,10 @@
 
 #include "ilp_solver_interface.hpp"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 
 // The implementation serves to avoid redundant code duplication.
 namespace ilp_solver
@@ -9,6 +13,9 @@ namespace ilp_solver
     enum class VariableType   { INTEGER, CONTINUOUS, BINARY };
     enum class ObjectiveSense { MINIMIZE, MAXIMIZE };
 
+    class SharedIncumbent;
+    class SolveObserver;
+
 
     // You may call this free function in the constructor of your fully implemented class.
     // Can not be called in the constructor of ILPSolverImpl since the virtual functions are not yet overridden.
@@ -42,10 +49,53 @@ namespace ilp_solver
             void minimize() override;
             void maximize() override;
 
+            // The default version does nothing.
+            void interrupt() override;
+
+            // Shares solutions with other solvers solving the same model at the same time, e.g. in a portfolio.
+            // Solvers supporting it (CBC, SCIP, the stub and the portfolio) publish their solutions into p_incumbent
+            // and import better ones while solving. All others, including the other decorators, ignore it.
+            // SCIP solves single-threaded while sharing, since its concurrent solve does not copy the plugins that share the incumbent.
+            // nullptr stops sharing. Defined here, since the solver process sets it without linking this class.
+            void set_shared_incumbent(std::shared_ptr<SharedIncumbent> p_incumbent) { d_shared_incumbent = std::move(p_incumbent); }
+            const std::shared_ptr<SharedIncumbent>& get_shared_incumbent() const { return d_shared_incumbent; }
+
+            // Kept for the following solves. Solvers supporting callbacks (CBC, SCIP, Gurobi, the stub and the decorators
+            // solving their model unchanged) report to d_observer. SCIP solves single-threaded while there are callbacks,
+            // like while sharing the incumbent.
+            void set_incumbent_callback(IncumbentCallback p_callback)                           override;
+            void set_progress_callback (ProgressCallback p_callback, double p_interval_seconds) override;
+
+            // Check the indices (and the sizes of the vectors) before calling the corresponding private methods.
+            void set_variable_bounds       (int p_variable_index,                            double p_lower_bound, double p_upper_bound)                                          override;
+            void set_variable_bounds       (const std::vector<int>& p_variable_indices,      const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds) override;
+            void set_constraint_bounds     (int p_constraint_index,                          double p_lower_bound, double p_upper_bound)                                          override;
+            void set_constraint_bounds     (const std::vector<int>& p_constraint_indices,    const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds) override;
+            void set_objective_coefficient (int p_variable_index,                            double p_objective)                                                                  override;
+            void set_objective_coefficient (const std::vector<int>& p_variable_indices,      const std::vector<double>& p_objectives)                                             override;
+            void set_coefficient           (int p_constraint_index,                       int p_variable_index,                       double p_value)                      override;
+            void set_coefficient           (const std::vector<int>& p_constraint_indices, const std::vector<int>& p_variable_indices, const std::vector<double>& p_values) override;
+
+            // Check the indices and compute the index mapping before calling the corresponding private methods.
+            std::vector<int> delete_constraints(const std::vector<int>& p_constraint_indices) override;
+            std::vector<int> delete_variables  (const std::vector<int>& p_variable_indices)   override;
+
         protected:
             ILPSolverImpl() = default;
 
+            std::shared_ptr<SharedIncumbent> d_shared_incumbent;
+
+            // Only set during a solve with callbacks.
+            std::shared_ptr<SolveObserver>   d_observer;
+
         private:
+            IncumbentCallback d_incumbent_callback;
+            ProgressCallback  d_progress_callback;
+            double            d_progress_interval_seconds{ 0. };
+
+            // Calls solve_impl, observed by d_observer if there are callbacks.
+            void observe_solve(ObjectiveSense p_sense);
+
             // If there is anything that needs to be done before a solve, overwrite prepare_impl.
             // It will be called before set_objective_sense_impl and solve_impl.
             // Useful e.g. for cached problems etc.
@@ -59,5 +109,45 @@ namespace ilp_solver
                                                                    const std::vector<int>* p_col_indices = nullptr) = 0;
             virtual void                      solve_impl() = 0;
             virtual void                      set_objective_sense_impl(ObjectiveSense p_sense) = 0;
+
+            // The indices are checked before these are called.
+            virtual void                      set_variable_bounds_impl      (int p_variable_index,   double p_lower_bound, double p_upper_bound) = 0;
+            virtual void                      set_constraint_bounds_impl    (int p_constraint_index, double p_lower_bound, double p_upper_bound) = 0;
+            virtual void                      set_objective_coefficient_impl(int p_variable_index,   double p_objective) = 0;
+            virtual void                      set_coefficient_impl          (int p_constraint_index, int p_variable_index, double p_value) = 0;
+
+            // Overwrite these if the solver can change several entries at once.
+            // The default versions call the methods above for each entry.
+            virtual void                      set_variable_bounds_batch_impl      (const std::vector<int>& p_variable_indices,   const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds);
+            virtual void                      set_constraint_bounds_batch_impl    (const std::vector<int>& p_constraint_indices, const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds);
+            virtual void                      set_objective_coefficient_batch_impl(const std::vector<int>& p_variable_indices,   const std::vector<double>& p_objectives);
+            virtual void                      set_coefficient_batch_impl          (const std::vector<int>& p_constraint_indices, const std::vector<int>& p_variable_indices, const std::vector<double>& p_values);
+
+            // p_deleted_indices are sorted, unique and not empty.
+            // p_index_mapping is the result of the public method, i.e. the new index of every old index or -1.
+            virtual void                      delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) = 0;
+            virtual void                      delete_variables_impl  (const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) = 0;
     };
+
+
+    // Removes the entries mapped to -1 by p_index_mapping (as returned by delete_constraints and delete_variables)
+    // and moves the others to their new index. Vectors of a different size (e.g. empty ones) are not changed.
+    template <typename T>
+    void compact(std::vector<T>* v_values, const std::vector<int>& p_index_mapping)
+    {
+        if (v_values->size() != p_index_mapping.size())
+            return;
+
+        // The mapping preserves the order, so every entry is moved to the front or stays.
+        std::size_t size = 0;
+        for (auto i = 0; i < static_cast<int>(p_index_mapping.size()); ++i)
+        {
+            if (p_index_mapping[i] < 0)
+                continue;
+            if (p_index_mapping[i] != i)
+                (*v_values)[p_index_mapping[i]] = std::move((*v_values)[i]);
+            ++size;
+        }
+        v_values->resize(size);
+    }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,34 @@ namespace ilp_solver
     constexpr double c_neg_inf      { std::numeric_limits<double>::lowest() };
 
 
+    // Passed to the callback of a running solve whenever it has found a better solution (see set_incumbent_callback).
+    // The objective refers to the objective sense of the solve.
+    struct IncumbentEvent
+    {
+        const double* solution;         // Only valid during the callback.
+        int           num_variables;
+        double        objective;
+        double        seconds;          // Since the start of the solve.
+    };
+
+
+    // Passed to the callback of a running solve regularly (see set_progress_callback).
+    struct ProgressEvent
+    {
+        double        objective;        // Of the best solution, c_pos_inf (minimize) or c_neg_inf (maximize) if there is none.
+        double        best_bound;       // No solution is better.
+        double        gap;              // |objective - best_bound| / |objective|, c_pos_inf if there is no solution.
+        long long     num_nodes;
+        double        seconds;          // Since the start of the solve.
+    };
+
+
+    enum class ProgressAction { CONTINUE, STOP };
+
+    using IncumbentCallback = std::function<void(const IncumbentEvent&)>;
+    using ProgressCallback  = std::function<ProgressAction(const ProgressEvent&)>;
+
+
     class SolverExeException : public std::runtime_error
     {
     public:
@@ -148,9 +177,54 @@ namespace ilp_solver
 
             // Print a mps-formatted file of the current model.
             // p_path must be valid path to a file with write-permission.
-            // Not const because some solvers may apply their caches, e.g. CoinModel.writeMps is not const.
+            // Not const because some solvers may apply their caches first.
             virtual void print_mps_file         (const std::string& p_path)   = 0;
 
             virtual ~ILPSolverInterface() noexcept {}
+
+            // The following methods are declared behind the destructor, so that the virtual function table
+            // of the previous versions of this interface stays a prefix of the current one.
+
+            // Change the model in place, e.g. to solve a sequence of similar models with the same solver.
+            // Variables and constraints are indexed in the order in which they were added.
+            // The second version of each method changes several entries at once, which is faster for some solvers.
+            // Some solvers lose the information about previous solutions (as in reset_solution).
+            virtual void set_variable_bounds       (int p_variable_index,                            double p_lower_bound, double p_upper_bound)                                          = 0;
+            virtual void set_variable_bounds       (const std::vector<int>& p_variable_indices,      const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds) = 0;
+            virtual void set_constraint_bounds     (int p_constraint_index,                          double p_lower_bound, double p_upper_bound)                                          = 0;
+            virtual void set_constraint_bounds     (const std::vector<int>& p_constraint_indices,    const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds) = 0;
+            virtual void set_objective_coefficient (int p_variable_index,                            double p_objective)                                                                  = 0;
+            virtual void set_objective_coefficient (const std::vector<int>& p_variable_indices,      const std::vector<double>& p_objectives)                                             = 0;
+
+            // Set the coefficient of variable p_variable_index in constraint p_constraint_index.
+            // Changing a zero coefficient adds a non-zero to the matrix, which is more expensive than changing a non-zero.
+            virtual void set_coefficient           (int p_constraint_index,                       int p_variable_index,                       double p_value)                      = 0;
+            virtual void set_coefficient           (const std::vector<int>& p_constraint_indices, const std::vector<int>& p_variable_indices, const std::vector<double>& p_values) = 0;
+
+            // Delete the given [constraints | variables] from the model. Indices may be given in any order and more than once.
+            // The remaining ones keep their order and are renumbered consecutively.
+            // Returns the new index of every old [constraint | variable], or -1 if it has been deleted.
+            // A solution of a previous solve refers to the old indices, so solve again before obtaining it.
+            virtual std::vector<int> delete_constraints(const std::vector<int>& p_constraint_indices) = 0;
+            virtual std::vector<int> delete_variables  (const std::vector<int>& p_variable_indices)   = 0;
+
+            // Ask a running minimize or maximize to stop as soon as possible, which then returns the best solution found.
+            // May be called from any thread, also while another thread is solving. Has no effect if no solve is running,
+            // and may be missed by a solve that is just starting.
+            // May be unsupported by some solvers.
+            virtual void                      interrupt     ()       = 0;
+
+            // Observe the following solves, e.g. to stop by a rule of your own once the solution is good enough.
+            // The callbacks are called on a solving thread, one at a time, and must not use the solver.
+            // An exception thrown by a callback stops the solve and is rethrown by minimize or maximize.
+            // An empty function removes the callback.
+            // May be unsupported by some solvers.
+
+            // p_callback is called whenever the solve has found a better solution.
+            virtual void set_incumbent_callback (IncumbentCallback p_callback)                              = 0;
+
+            // p_callback is called regularly while solving, at most every p_interval_seconds.
+            // Returning STOP stops the solve like interrupt, which then returns the best solution found.
+            virtual void set_progress_callback  (ProgressCallback p_callback, double p_interval_seconds)    = 0;
     };
 }
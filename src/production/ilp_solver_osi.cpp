@@ -59,8 +59,7 @@ namespace ilp_solver
 
     void ILPSolverOsi::reset_solution()
     {
-        get_solver_osi_model()->loadFromCoinModel(d_cache, false);
-        d_cache_changed = false;
+        load_cache(false);
     }
 
 
@@ -15,17 +15,10 @@
 #include <optional>
 #include <cassert>
 #include <algorithm>
-#include <numeric>
 
 using std::string;
 using std::vector;
 
-// States whether consecutive elements of each column are contiguous in memory.
-// (If not, consecutive elements of each row are contiguous in memory.)
-constexpr auto c_column_ordered = false;
-
-constexpr auto c_test_for_duplicate_index = false;
-
 namespace ilp_solver
 {
     namespace
@@ -34,135 +27,141 @@ namespace ilp_solver
         // Prune zeros before constructing a coin-packed vector.
         // Takes pointers to the vectors or nullptrs as parameters.
         // If p_values is a nullptr, does nothing and returns 0, nullptr and nullptr.
-        // If p_values is valid,
-        //     prunes all zeros from it and constructs a new value array if there were any,
-        //     and a new index array if there are any zeros or if p_indices == nullptr.
+        // If p_values is valid, copies all non-zeros and their indices to the buffers
+        // (the current index if p_indices == nullptr) in a single pass.
+        // The buffers belong to the solver and only grow, so that no allocation is necessary after the first calls.
+        // The returned pointers are valid until the buffers are used by the next pruner.
         class ZeroPruner
         {
         public:
-            ZeroPruner (const std::vector<int>* p_indices, const std::vector<double>* p_values);
-            ~ZeroPruner();
+            ZeroPruner (const std::vector<int>* p_indices, const std::vector<double>* p_values,
+                        std::vector<double>* v_value_buffer, std::vector<int>* v_index_buffer);
 
             int           size()    const { return d_num_indices; }
             const double* values()  const { return d_values; }
             const int*    indices() const { return d_indices; }
         private:
-            static constexpr int c_owns_values{2};
-            static constexpr int c_owns_indices{1};
-
-            double* d_values      {nullptr};
-            int*    d_indices     {nullptr};
-            int     d_num_indices {0};
-            int     d_owns        {0};
+            const double* d_values     {nullptr};
+            const int*    d_indices    {nullptr};
+            int           d_num_indices{0};
         };
 
-        ZeroPruner::ZeroPruner(const std::vector<int>* p_indices, const std::vector<double>* p_values)
-        {
-            if (p_values != nullptr) {
-                assert ((p_indices == nullptr) || (p_indices->size() == p_values->size()));
 
-                int num_zeros{ static_cast<int>(std::count(p_values->begin(), p_values->end(), 0.)) };
+        ZeroPruner::ZeroPruner(const std::vector<int>* p_indices, const std::vector<double>* p_values,
+                               std::vector<double>* v_value_buffer, std::vector<int>* v_index_buffer)
+        {
+            if (p_values == nullptr)
+                return;
+            assert ((p_indices == nullptr) || (p_indices->size() == p_values->size()));
+
+            const auto size = static_cast<int>(p_values->size());
+            if (static_cast<int>(v_value_buffer->size()) < size)
+            {
+                v_value_buffer->resize(size);
+                v_index_buffer->resize(size);
+            }
 
-                if (num_zeros > 0)
+            const auto* values        = p_values->data();
+            const auto* indices       = (p_indices != nullptr) ? p_indices->data() : nullptr;
+            auto*       value_buffer  = v_value_buffer->data();
+            auto*       index_buffer  = v_index_buffer->data();
+            auto        num_non_zeros = 0;
+
+            // Every value is written, but the position only advances for non-zeros.
+            // This avoids a hard to predict branch. There is no SIMD variant: the build does not enable AVX2,
+            // so it would need a dispatch at runtime, and the loop is a small part of building the model.
+            if (indices != nullptr)
+            {
+                for (auto i = 0; i < size; ++i)
                 {
-                    d_num_indices = static_cast<int>(p_values->size()) - num_zeros;
-                    d_owns        = c_owns_values | c_owns_indices;
-                    d_values      = new double[d_num_indices];
-                    d_indices     = new int   [d_num_indices];
-
-                    for (int i = 0, j = 0; i < static_cast<int>(p_values->size()); i++)
-                    {
-                        auto value = (*p_values)[i];
-                        // Construct the new arrays. If we have no indices, use the current index.
-                        if (value != 0.)
-                        {
-                            d_values [j]   = value;
-                            d_indices[j++] = (p_indices != nullptr) ? (*p_indices)[i] : i;
-                        }
-                    }
+                    value_buffer[num_non_zeros] = values[i];
+                    index_buffer[num_non_zeros] = indices[i];
+                    num_non_zeros += (values[i] != 0.);
                 }
-                else
+            }
+            else
+            {
+                for (auto i = 0; i < size; ++i)
                 {
-                    // const_cast is valid since we do not ever manipulate this data
-                    // and the getter-methods return const pointers again.
-                    d_values      = const_cast<double*>(p_values->data());
-                    d_num_indices = static_cast<int>(p_values->size());
-
-                    if (p_indices == nullptr)
-                    {
-                        d_owns    = c_owns_indices;
-                        d_indices = new int[d_num_indices];
-                        std::iota(d_indices, d_indices + d_num_indices, 0);
-                    }
-                    else
-                    {
-                        d_owns    = 0;
-                        d_indices = const_cast<int*>(p_indices->data());
-                    }
+                    value_buffer[num_non_zeros] = values[i];
+                    index_buffer[num_non_zeros] = i;
+                    num_non_zeros += (values[i] != 0.);
                 }
             }
-        }
 
-        ZeroPruner::~ZeroPruner() noexcept
-        {
-            if (d_owns & c_owns_values)  delete[] d_values;
-            if (d_owns & c_owns_indices) delete[] d_indices;
+            d_values      = value_buffer;
+            d_indices     = index_buffer;
+            d_num_indices = num_non_zeros;
         }
     }
 
 
     int ILPSolverOsiModel::get_num_constraints() const
     {
-        return d_cache.numberRows();
+        return d_cache.num_rows();
     }
 
 
     int ILPSolverOsiModel::get_num_variables() const
     {
-        return d_cache.numberColumns();
+        return d_cache.num_columns();
     }
 
 
     void ILPSolverOsiModel::print_mps_file(const std::string& p_filename)
     {
-        // path,
-        // compression (off),
-        // format (extra precision),
-        // number of values per dataline (1 or 2),
-        // keepStrings (no idea what it does, false is default).
-        if( d_cache.writeMps(p_filename.c_str(), 0, 1, 1, false) )
-            throw std::exception("Could not write mps file.");
+        d_cache.write_mps(p_filename);
     }
 
 
     void ILPSolverOsiModel::prepare_impl()
     {
-        auto* solver{ get_solver_osi_model() };
-        if (d_cache_changed && (d_cache.numberColumns() > 0 || d_cache.numberRows() > 0))
+        if (!d_cache_changed)
+            return;
+
+        auto*      solver        = get_solver_osi_model();
+        const auto rows_added    = (d_cache.num_rows()    > d_num_loaded_rows);
+        const auto columns_added = (d_cache.num_columns() > d_num_loaded_columns);
+        const auto solver_empty  = (d_num_loaded_rows == 0 && d_num_loaded_columns == 0);
+
+        if (solver_empty || d_reload_required || (rows_added && columns_added))
         {
-            solver->loadFromCoinModel(d_cache, true);
-            d_cache_changed = false;
+            load_cache(true);
+            return;
         }
+
+        if (rows_added)
+            d_cache.append_rows(solver, d_num_loaded_rows);
+        else
+            d_cache.append_columns(solver, d_num_loaded_columns);
+
+        d_num_loaded_rows    = d_cache.num_rows();
+        d_num_loaded_columns = d_cache.num_columns();
+        d_cache_changed      = false;
+    }
+
+
+    void ILPSolverOsiModel::load_cache(bool p_keep_solution)
+    {
+        if (d_cache.num_columns() > 0 || d_cache.num_rows() > 0)
+            d_cache.load(get_solver_osi_model(), p_keep_solution);
+
+        d_num_loaded_rows    = d_cache.num_rows();
+        d_num_loaded_columns = d_cache.num_columns();
+        d_cache_changed      = false;
+        d_reload_required    = false;
     }
 
 
     void ILPSolverOsiModel::add_variable_impl (VariableType p_type, double p_objective, double p_lower_bound, double p_upper_bound,
                                                const std::string& p_name, const std::vector<double>* p_row_values, const std::vector<int>* p_row_indices)
     {
-        ZeroPruner pruner{p_row_indices, p_row_values};
+        ZeroPruner pruner{p_row_indices, p_row_values, &d_pruned_values, &d_pruned_indices};
         assert (pruner.size() <= get_num_constraints());
 
         // OSI has no special case for binary variables.
         bool is_integer_or_binary{ (p_type == VariableType::CONTINUOUS) ? false : true };
-        if (!p_name.empty())
-        {
-            // Spaces are problematic when printing to mps.
-            auto name = p_name;
-            std::replace(name.begin(), name.end(), ' ', '_');
-            d_cache.addCol(pruner.size(), pruner.indices(), pruner.values(), p_lower_bound, p_upper_bound, p_objective, name.c_str(), is_integer_or_binary);
-        }
-        else
-            d_cache.addCol(pruner.size(), pruner.indices(), pruner.values(), p_lower_bound, p_upper_bound, p_objective, nullptr, is_integer_or_binary);
+        d_cache.add_column(pruner.size(), pruner.indices(), pruner.values(), p_lower_bound, p_upper_bound, p_objective, is_integer_or_binary, p_name);
         d_cache_changed = true;
     }
 
@@ -170,18 +169,144 @@ namespace ilp_solver
     void ILPSolverOsiModel::add_constraint_impl (double p_lower_bound, double p_upper_bound, const std::vector<double>& p_col_values,
                                                  const std::string& p_name, const std::vector<int>* p_col_indices)
     {
-        ZeroPruner pruner{p_col_indices, &p_col_values};
+        ZeroPruner pruner{p_col_indices, &p_col_values, &d_pruned_values, &d_pruned_indices};
+        d_cache.add_row(pruner.size(), pruner.indices(), pruner.values(), p_lower_bound, p_upper_bound, p_name);
+        d_cache_changed = true;
+    }
+
+
+    // The cache is changed as well, since reset_solution reloads the solver from it.
+    // If the variable (constraint) is loaded into the solver already, the solver is changed directly.
+    void ILPSolverOsiModel::set_variable_bounds_impl(int p_variable_index, double p_lower_bound, double p_upper_bound)
+    {
+        d_cache.set_column_bounds(p_variable_index, p_lower_bound, p_upper_bound);
+        if (p_variable_index < d_num_loaded_columns)
+            get_solver_osi_model()->setColBounds(p_variable_index, p_lower_bound, p_upper_bound);
+    }
+
+
+    void ILPSolverOsiModel::set_constraint_bounds_impl(int p_constraint_index, double p_lower_bound, double p_upper_bound)
+    {
+        d_cache.set_row_bounds(p_constraint_index, p_lower_bound, p_upper_bound);
+        if (p_constraint_index < d_num_loaded_rows)
+            get_solver_osi_model()->setRowBounds(p_constraint_index, p_lower_bound, p_upper_bound);
+    }
+
+
+    void ILPSolverOsiModel::set_objective_coefficient_impl(int p_variable_index, double p_objective)
+    {
+        d_cache.set_column_objective(p_variable_index, p_objective);
+        if (p_variable_index < d_num_loaded_columns)
+            get_solver_osi_model()->setObjCoeff(p_variable_index, p_objective);
+    }
+
 
-        if (!p_name.empty())
+    void ILPSolverOsiModel::set_coefficient_impl(int p_constraint_index, int p_variable_index, double p_value)
+    {
+        // A new non-zero in a row that is not loaded yet must be stored with the row, so that it is appended with it.
+        // A new non-zero in a loaded row can be stored with the column, which is appended if it is not loaded yet.
+        const auto row_loaded = (p_constraint_index < d_num_loaded_rows);
+        d_cache.set_coefficient(p_constraint_index, p_variable_index, p_value, !row_loaded);
+
+        if (row_loaded && p_variable_index < d_num_loaded_columns && !modify_loaded_coefficient(p_constraint_index, p_variable_index, p_value))
         {
-            // Spaces are problematic when printing to mps.
-            auto name = p_name;
-            std::replace(name.begin(), name.end(), ' ', '_');
-            d_cache.addRow(pruner.size(), pruner.indices(), pruner.values(), p_lower_bound, p_upper_bound, name.c_str());
+            d_reload_required = true;
+            d_cache_changed   = true;
         }
-        else
-            d_cache.addRow(pruner.size(), pruner.indices(), pruner.values(), p_lower_bound, p_upper_bound);
-        d_cache_changed = true;
+    }
+
+
+    // Osi can change sets of bounds and objective coefficients at once, but only of loaded rows and columns.
+    void ILPSolverOsiModel::set_variable_bounds_batch_impl(const vector<int>& p_variable_indices, const vector<double>& p_lower_bounds, const vector<double>& p_upper_bounds)
+    {
+        vector<int>    loaded_indices;
+        vector<double> bound_pairs;
+        for (auto k = 0; k < static_cast<int>(p_variable_indices.size()); ++k)
+        {
+            const auto j = p_variable_indices[k];
+            d_cache.set_column_bounds(j, p_lower_bounds[k], p_upper_bounds[k]);
+            if (j < d_num_loaded_columns)
+            {
+                loaded_indices.push_back(j);
+                bound_pairs.push_back(p_lower_bounds[k]);
+                bound_pairs.push_back(p_upper_bounds[k]);
+            }
+        }
+        if (!loaded_indices.empty())
+            get_solver_osi_model()->setColSetBounds(loaded_indices.data(), loaded_indices.data() + loaded_indices.size(), bound_pairs.data());
+    }
+
+
+    void ILPSolverOsiModel::set_constraint_bounds_batch_impl(const vector<int>& p_constraint_indices, const vector<double>& p_lower_bounds, const vector<double>& p_upper_bounds)
+    {
+        vector<int>    loaded_indices;
+        vector<double> bound_pairs;
+        for (auto k = 0; k < static_cast<int>(p_constraint_indices.size()); ++k)
+        {
+            const auto i = p_constraint_indices[k];
+            d_cache.set_row_bounds(i, p_lower_bounds[k], p_upper_bounds[k]);
+            if (i < d_num_loaded_rows)
+            {
+                loaded_indices.push_back(i);
+                bound_pairs.push_back(p_lower_bounds[k]);
+                bound_pairs.push_back(p_upper_bounds[k]);
+            }
+        }
+        if (!loaded_indices.empty())
+            get_solver_osi_model()->setRowSetBounds(loaded_indices.data(), loaded_indices.data() + loaded_indices.size(), bound_pairs.data());
+    }
+
+
+    void ILPSolverOsiModel::set_objective_coefficient_batch_impl(const vector<int>& p_variable_indices, const vector<double>& p_objectives)
+    {
+        vector<int>    loaded_indices;
+        vector<double> loaded_objectives;
+        for (auto k = 0; k < static_cast<int>(p_variable_indices.size()); ++k)
+        {
+            const auto j = p_variable_indices[k];
+            d_cache.set_column_objective(j, p_objectives[k]);
+            if (j < d_num_loaded_columns)
+            {
+                loaded_indices.push_back(j);
+                loaded_objectives.push_back(p_objectives[k]);
+            }
+        }
+        if (!loaded_indices.empty())
+            get_solver_osi_model()->setObjCoeffSet(loaded_indices.data(), loaded_indices.data() + loaded_indices.size(), loaded_objectives.data());
+    }
+
+
+    // The loaded rows (columns) are the first ones, and they stay the first ones after the deletion.
+    // Thus, the loaded deleted ones are a prefix of the sorted p_deleted_indices.
+    void ILPSolverOsiModel::delete_constraints_impl(const vector<int>& p_deleted_indices, const vector<int>& p_index_mapping)
+    {
+        d_cache.delete_rows(p_index_mapping);
+
+        const auto num_loaded = static_cast<int>(std::lower_bound(p_deleted_indices.begin(), p_deleted_indices.end(), d_num_loaded_rows) - p_deleted_indices.begin());
+        if (num_loaded > 0)
+        {
+            get_solver_osi_model()->deleteRows(num_loaded, p_deleted_indices.data());
+            d_num_loaded_rows -= num_loaded;
+        }
+    }
+
+
+    void ILPSolverOsiModel::delete_variables_impl(const vector<int>& p_deleted_indices, const vector<int>& p_index_mapping)
+    {
+        d_cache.delete_columns(p_index_mapping);
+
+        const auto num_loaded = static_cast<int>(std::lower_bound(p_deleted_indices.begin(), p_deleted_indices.end(), d_num_loaded_columns) - p_deleted_indices.begin());
+        if (num_loaded > 0)
+        {
+            get_solver_osi_model()->deleteCols(num_loaded, p_deleted_indices.data());
+            d_num_loaded_columns -= num_loaded;
+        }
+    }
+
+
+    bool ILPSolverOsiModel::modify_loaded_coefficient(int /* p_row_index */, int /* p_column_index */, double /* p_value */)
+    {
+        return false;
     }
 }
 
@@ -2,10 +2,9 @@
 
 #if WITH_OSI == 1
 
+#include "ilp_osi_model_cache.hpp"
 #include "ilp_solver_impl.hpp"
 
-#include "CoinModel.hpp"
-
 #include <string>
 #include <vector>
 
@@ -29,14 +28,39 @@ namespace ilp_solver
         protected:
             ILPSolverOsiModel() = default;
 
+            // Loads the rows and columns added since the last call into the solver.
+            // Appends them if only rows or only columns have been added, otherwise reloads the whole model.
             void prepare_impl() override;
 
-            CoinModel d_cache{};
-            bool      d_cache_changed{ false };
+            // Replaces the model of the solver by the cached one.
+            void load_cache(bool p_keep_solution);
+
+            // Delete the rows (columns) from the cache and, if they are loaded, from the solver.
+            // Protected, so that derived classes can adapt their own data first.
+            void delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
+            void delete_variables_impl  (const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
+
+            OsiModelCache d_cache{};
+            bool          d_cache_changed{ false };
         private:
+            // Number of rows and columns of the cache the solver contains.
+            int d_num_loaded_rows   { 0 };
+            int d_num_loaded_columns{ 0 };
+
+            // Set if the solver could not be changed directly, so that the whole model must be loaded again.
+            bool d_reload_required{ false };
+
+            // Scratch buffers for pruning zeros from added rows and columns. Reused to avoid allocations.
+            std::vector<double> d_pruned_values;
+            std::vector<int>    d_pruned_indices;
+
             // Obtain a pointer to a solver fulfilling the OsiSolverInterface.
             virtual OsiSolverInterface* get_solver_osi_model() = 0;
 
+            // The OsiSolverInterface can not change single coefficients, but many of the actual solvers can.
+            // Returns whether the coefficient has been changed in the solver. The default version returns false.
+            virtual bool modify_loaded_coefficient(int p_row_index, int p_column_index, double p_value);
+
             void add_variable_impl (VariableType p_type, double p_objective, double p_lower_bound, double p_upper_bound,
                 [[maybe_unused]] const std::string& p_name = "", const std::vector<double>* p_row_values = nullptr,
                 const std::vector<int>* p_row_indices = nullptr) override;
@@ -44,6 +68,15 @@ namespace ilp_solver
             void add_constraint_impl (double p_lower_bound, double p_upper_bound,
                 const std::vector<double>& p_col_values, [[maybe_unused]] const std::string& p_name = "",
                 const std::vector<int>* p_col_indices = nullptr) override;
+
+            void set_variable_bounds_impl      (int p_variable_index,   double p_lower_bound, double p_upper_bound) override;
+            void set_constraint_bounds_impl    (int p_constraint_index, double p_lower_bound, double p_upper_bound) override;
+            void set_objective_coefficient_impl(int p_variable_index,   double p_objective)                         override;
+            void set_coefficient_impl          (int p_constraint_index, int p_variable_index, double p_value)       override;
+
+            void set_variable_bounds_batch_impl      (const std::vector<int>& p_variable_indices,   const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds) override;
+            void set_constraint_bounds_batch_impl    (const std::vector<int>& p_constraint_indices, const std::vector<double>& p_lower_bounds, const std::vector<double>& p_upper_bounds) override;
+            void set_objective_coefficient_batch_impl(const std::vector<int>& p_variable_indices,   const std::vector<double>& p_objectives)                                             override;
     };
 }
 
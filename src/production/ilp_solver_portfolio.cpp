@@ -0,0 +1,200 @@
+#include "ilp_solver_portfolio.hpp"
+
+#include "ilp_shared_incumbent.hpp"
+#include "ilp_solve_observer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    // How often the backends are interrupted again. An interrupt arriving before a backend has started solving may be missed.
+    static constexpr std::chrono::milliseconds c_interrupt_interval{ 10 };
+
+
+    static bool is_proven(SolutionStatus p_status)
+    {
+        return p_status == SolutionStatus::PROVEN_OPTIMAL
+            || p_status == SolutionStatus::PROVEN_INFEASIBLE
+            || p_status == SolutionStatus::PROVEN_UNBOUNDED;
+    }
+
+
+    static bool is_better(const ILPSolutionData& p_result, const ILPSolutionData& p_best, ObjectiveSense p_sense)
+    {
+        if (p_result.solution.empty())
+            return false;
+        if (p_best.solution.empty())
+            return true;
+        return (p_sense == ObjectiveSense::MINIMIZE) ? p_result.objective < p_best.objective
+                                                     : p_result.objective > p_best.objective;
+    }
+
+
+    // The base class only needs a factory for solve_with_backend, which is not used.
+    ILPSolverPortfolio::ILPSolverPortfolio(std::vector<BackendFactory> p_backend_factories)
+        : ILPSolverDecorator(p_backend_factories.empty() ? BackendFactory() : p_backend_factories.front()),
+          d_backend_factories(std::move(p_backend_factories))
+    { }
+
+
+    int ILPSolverPortfolio::get_winner() const
+    {
+        return d_winner;
+    }
+
+
+    void ILPSolverPortfolio::interrupt()
+    {
+        d_interrupt_requested = true;
+        ILPSolverDecorator::interrupt();
+    }
+
+
+    void ILPSolverPortfolio::set_incumbent_sharing(bool p_share)
+    {
+        d_share_incumbent = p_share;
+    }
+
+
+    void ILPSolverPortfolio::solve_impl()
+    {
+        d_ilp_solution_data = ILPSolutionData(d_ilp_data.objective_sense);
+        d_winner            = -1;
+
+        // The request is cleared after the solve, so that an interrupt arriving while the backends are created is not lost.
+        struct InterruptReset
+        {
+            ~InterruptReset() { interrupt_requested = false; }
+            std::atomic<bool>& interrupt_requested;
+        } interrupt_reset{ d_interrupt_requested };
+
+        vector<std::unique_ptr<ILPSolverInterface>> backends;
+        vector<int>                                 factory_indices;
+        for (auto k = 0; k < static_cast<int>(d_backend_factories.size()); ++k)
+        {
+            std::unique_ptr<ILPSolverInterface> backend{ d_backend_factories[k]() };
+            if (!backend)
+                continue;
+            backends.push_back(std::move(backend));
+            factory_indices.push_back(k);
+        }
+        if (backends.empty())
+            throw std::exception("Could not create any backend solver.");
+
+        // A new incumbent for every solve, since the model may have changed. One set on the portfolio
+        // (e.g. by AsyncSolve to poll the solutions) is used instead.
+        auto incumbent = d_shared_incumbent;
+        if (!d_share_incumbent)
+            incumbent = nullptr;
+        else if (!incumbent)
+            incumbent = std::make_shared<SharedIncumbent>(d_ilp_data.objective_sense);
+        const auto num_backends = static_cast<int>(backends.size());
+        for (auto& backend: backends)
+        {
+            transfer_ilp_data(backend.get(), d_ilp_data);
+            backend->set_num_threads(std::max(1, d_ilp_data.num_threads / num_backends));
+            if (auto* backend_impl = dynamic_cast<ILPSolverImpl*>(backend.get()))
+                backend_impl->set_shared_incumbent(incumbent);
+            relay_callbacks(backend.get());
+        }
+
+        vector<ILPSolutionData>    results   (num_backends);
+        vector<std::exception_ptr> exceptions(num_backends);
+        auto                       num_finished{ 0 };
+        auto                       winner      { -1 };
+        std::mutex                 mutex;
+        std::condition_variable    finished_condition;
+
+        auto work = [&](int p_k)
+        {
+            try
+            {
+                results[p_k] = optimize_backend(backends[p_k].get(), d_ilp_data.objective_sense);
+            }
+            catch (...)
+            {
+                exceptions[p_k] = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ++num_finished;
+            if (winner < 0 && !exceptions[p_k] && is_proven(results[p_k].solution_status))
+                winner = p_k;
+            finished_condition.notify_all();
+        };
+
+        // Interrupts the started workers until they have stopped, and joins them, also if starting another one throws.
+        // An interrupt only reaches a backend that is solving, so it is repeated.
+        auto num_started{ 0 };
+        auto stop_workers = [&]()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (num_finished < num_started)
+            {
+                ILPSolverDecorator::interrupt();
+                finished_condition.wait_for(lock, c_interrupt_interval);
+            }
+        };
+        struct Workers
+        {
+            ~Workers()
+            {
+                stop();
+                for (auto& thread: threads)
+                    thread.join();
+            }
+            std::function<void()>    stop;
+            std::vector<std::thread> threads;
+        };
+
+        {
+            Workers workers{ stop_workers, {} };
+            workers.threads.reserve(num_backends);
+            for (auto k = 0; k < num_backends; ++k)
+            {
+                workers.threads.emplace_back(work, k);
+                ++num_started;
+            }
+
+            // The interrupt request and a request to stop of the callbacks are checked regularly,
+            // since some backends may not report to the callbacks.
+            std::unique_lock<std::mutex> lock(mutex);
+            while (winner < 0 && num_finished < num_backends && !d_interrupt_requested && !(d_observer && d_observer->stop_requested()))
+                finished_condition.wait_for(lock, c_interrupt_interval);
+        }
+
+        if (winner < 0)
+        {
+            // The best solution found by any backend, if none has proven anything.
+            for (auto k = 0; k < num_backends; ++k)
+                if (!exceptions[k] && is_better(results[k], (winner < 0) ? ILPSolutionData() : results[winner], d_ilp_data.objective_sense))
+                    winner = k;
+        }
+        if (winner < 0)
+        {
+            // A backend failing is only an error if no backend has a result.
+            for (auto k = 0; k < num_backends; ++k)
+            {
+                if (!exceptions[k])
+                {
+                    d_ilp_solution_data = results[k];
+                    return;
+                }
+            }
+            std::rethrow_exception(exceptions.front());
+        }
+
+        d_winner            = factory_indices[winner];
+        d_ilp_solution_data = std::move(results[winner]);
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ilp_solver_decorator.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace ilp_solver
+{
+    // Solves the collected model with several backends at once, each on its own thread,
+    // e.g. CBC and SCIP, or the same solver with different parameters.
+    // The first backend proving optimality, infeasibility or unboundedness wins and the others are interrupted.
+    // If no backend proves anything within the limits, the best solution found by any of them is taken.
+    // The backends are created, filled and destroyed on the calling thread and only solve in parallel,
+    // since not every solver library supports creating or configuring instances concurrently.
+    // Each backend gets an equal share of num_threads, but at least one thread.
+    // By default, the backends share their solutions while solving (see set_shared_incumbent),
+    // so that a solution found by one backend serves the others as a cutoff.
+    class ILPSolverPortfolio : public ILPSolverDecorator
+    {
+        public:
+            // Factories returning no solver are skipped, e.g. create_solver_scip in a build without SCIP.
+            explicit ILPSolverPortfolio(std::vector<BackendFactory> p_backend_factories);
+
+            // Index of the backend whose result was taken by the last solve, or -1 if there was none.
+            int  get_winner() const;
+
+            // Interrupts all backends of a running solve.
+            void interrupt () override;
+
+            void set_incumbent_sharing(bool p_share);
+
+        private:
+            std::vector<BackendFactory> d_backend_factories;
+            int                         d_winner{ -1 };
+            bool                        d_share_incumbent{ true };
+            std::atomic<bool>           d_interrupt_requested{ false };
+
+            void solve_impl() override;
+    };
+}
@@ -0,0 +1,46 @@
+#include "ilp_solver_presolve.hpp"
+
+namespace ilp_solver
+{
+    ILPSolverPresolve::ILPSolverPresolve(BackendFactory p_backend_factory)
+        : ILPSolverDecorator(std::move(p_backend_factory))
+    { }
+
+
+    void ILPSolverPresolve::solve_impl()
+    {
+        d_ilp_solution_data = ILPSolutionData(d_ilp_data.objective_sense);
+        d_statistics        = PresolveStatistics();
+
+        // set_presolve(false) switches off these reductions as well.
+        if (!d_ilp_data.presolve)
+        {
+            d_ilp_solution_data = solve_with_backend(d_ilp_data);
+            return;
+        }
+
+        const auto presolved_model = presolve(d_ilp_data);
+        d_statistics = presolved_model.statistics;
+        if (presolved_model.infeasible)
+        {
+            d_ilp_solution_data.solution_status = SolutionStatus::PROVEN_INFEASIBLE;
+            return;
+        }
+
+        // Presolve may have removed all variables. Then, the fixed values are the optimal solution.
+        if (presolved_model.kept_variables.empty())
+        {
+            d_ilp_solution_data.solution        = presolved_model.fixed_values;
+            d_ilp_solution_data.objective       = presolved_model.objective_offset;
+            d_ilp_solution_data.solution_status = SolutionStatus::PROVEN_OPTIMAL;
+            return;
+        }
+
+        const auto reduced_solution_data = solve_with_backend(presolved_model.reduced_data);
+
+        d_ilp_solution_data.solution_status = reduced_solution_data.solution_status;
+        d_ilp_solution_data.solution        = postsolve(presolved_model, reduced_solution_data.solution);
+        if (!d_ilp_solution_data.solution.empty())
+            d_ilp_solution_data.objective = reduced_solution_data.objective + presolved_model.objective_offset;
+    }
+}
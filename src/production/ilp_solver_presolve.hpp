@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ilp_presolve.hpp"
+#include "ilp_solver_decorator.hpp"
+
+namespace ilp_solver
+{
+    // Applies cheap reductions (see ilp_presolve.hpp) to the collected model before handing it to the backend.
+    // The solution of the reduced model is mapped back to the original variables.
+    // Thus, less data is passed to the backend (and to the solver process of a stub).
+    // If presolve is switched off via set_presolve, the model is passed on unchanged.
+    class ILPSolverPresolve : public ILPSolverDecorator
+    {
+        public:
+            explicit ILPSolverPresolve(BackendFactory p_backend_factory);
+
+            // Of the last solve. All zero if presolve is switched off.
+            const PresolveStatistics& get_statistics() const { return d_statistics; }
+
+        private:
+            PresolveStatistics d_statistics;
+
+            void solve_impl() override;
+    };
+}
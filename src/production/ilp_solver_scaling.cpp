@@ -0,0 +1,22 @@
+#include "ilp_solver_scaling.hpp"
+
+namespace ilp_solver
+{
+    ILPSolverScaling::ILPSolverScaling(BackendFactory p_backend_factory, ScalingMethod p_method)
+        : ILPSolverDecorator(std::move(p_backend_factory)),
+          d_method(p_method)
+    { }
+
+
+    void ILPSolverScaling::solve_impl()
+    {
+        const auto scaled_model         = scale_model(d_ilp_data, d_method);
+        const auto scaled_solution_data = solve_with_backend(scaled_model.scaled_data);
+
+        d_ilp_solution_data                 = ILPSolutionData(d_ilp_data.objective_sense);
+        d_ilp_solution_data.solution_status = scaled_solution_data.solution_status;
+        d_ilp_solution_data.solution        = unscale_solution(scaled_model, scaled_solution_data.solution);
+        if (!d_ilp_solution_data.solution.empty())
+            d_ilp_solution_data.objective = scaled_solution_data.objective;
+    }
+}
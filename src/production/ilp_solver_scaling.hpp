@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ilp_scaling.hpp"
+#include "ilp_solver_decorator.hpp"
+
+namespace ilp_solver
+{
+    // Scales the rows and continuous columns of the collected model (see ilp_scaling.hpp) before handing it
+    // to the backend, and unscales the solution. The objective value is not affected by the scaling.
+    // Useful for backends that have numerical trouble with coefficients of very different magnitude.
+    class ILPSolverScaling : public ILPSolverDecorator
+    {
+        public:
+            ILPSolverScaling(BackendFactory p_backend_factory, ScalingMethod p_method);
+
+        private:
+            ScalingMethod d_method;
+
+            void solve_impl() override;
+    };
+}
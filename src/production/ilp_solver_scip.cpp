@@ -2,8 +2,14 @@
 
 #include "ilp_solver_scip.hpp"
 
+#include "ilp_shared_incumbent.hpp"
+#include "ilp_solve_observer.hpp"
+
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <unordered_set>
+#include <utility>
 
 
 namespace ilp_solver
@@ -46,10 +52,230 @@ namespace ilp_solver
     }
 
 
+    /******************************************************************************
+    * Plugins sharing the incumbent and reporting to the observer, see solve_impl *
+    ******************************************************************************/
+    // The plugins are included once per environment, which may be reused by several solvers via the pool.
+    // Thus, they only know the shared incumbent, the observer and the variables during a solve.
+    struct SCIP_EventhdlrData
+    {
+        SharedIncumbent*        incumbent{ nullptr };
+        SolveObserver*          observer { nullptr };
+        std::vector<SCIP_VAR*>* cols     { nullptr };
+    };
+
+
+    struct SCIP_HeurData
+    {
+        SharedIncumbent*        incumbent{ nullptr };
+        std::vector<SCIP_VAR*>* cols     { nullptr };
+        long long               version  { 0 };
+    };
+
+
+    namespace
+    {
+        constexpr auto c_solve_events_name        = "scai_solve_events";
+        constexpr auto c_solve_events             = SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_NODESOLVED;
+        constexpr auto c_incumbent_import_name    = "scai_incumbent_import";
+        constexpr auto c_incumbent_import_freq    = "heuristics/scai_incumbent_import/freq";
+
+
+        SCIP_DECL_EVENTINITSOL(solve_events_initsol)
+        {
+            return SCIPcatchEvent(scip, c_solve_events, eventhdlr, nullptr, nullptr);
+        }
+
+
+        SCIP_DECL_EVENTEXITSOL(solve_events_exitsol)
+        {
+            return SCIPdropEvent(scip, c_solve_events, eventhdlr, nullptr, -1);
+        }
+
+
+        SCIP_DECL_EVENTFREE(solve_events_free)
+        {
+            (void) scip;
+            delete SCIPeventhdlrGetData(eventhdlr);
+            return SCIP_OKAY;
+        }
+
+
+        SCIP_RETCODE publish_best_solution(SCIP* p_scip, SCIP_EVENT* p_event, const SCIP_EventhdlrData& p_data, bool* r_stop)
+        {
+            auto* sol = SCIPeventGetSol(p_event);
+            std::vector<double> solution(p_data.cols->size());
+            const auto retcode = SCIPgetSolVals(p_scip, sol, static_cast<int>(solution.size()), p_data.cols->data(), solution.data());
+            if (retcode != SCIP_OKAY)
+                return retcode;
+
+            const auto objective = SCIPgetSolOrigObj(p_scip, sol);
+            if (p_data.incumbent)
+                p_data.incumbent->publish(solution, objective);
+            if (p_data.observer)
+                *r_stop = p_data.observer->report_incumbent(solution.data(), static_cast<int>(solution.size()), objective);
+            return SCIP_OKAY;
+        }
+
+
+        // The bounds refer to the original problem.
+        bool report_progress(SCIP* p_scip, SolveObserver* v_observer)
+        {
+            const auto no_solution = (SCIPgetObjsense(p_scip) == SCIP_OBJSENSE_MINIMIZE) ? c_pos_inf : c_neg_inf;
+            const auto objective   = (SCIPgetNSols(p_scip) > 0) ? SCIPgetPrimalbound(p_scip) : no_solution;
+            return v_observer->report_progress(objective, SCIPgetDualbound(p_scip), SCIPgetNTotalNodes(p_scip));
+        }
+
+
+        // Exceptions must not pass SCIP, which is written in C.
+        // A request to stop of the observer interrupts the solve.
+        SCIP_DECL_EVENTEXEC(solve_events_exec)
+        {
+            (void) eventdata;
+            const auto* data = SCIPeventhdlrGetData(eventhdlr);
+            if (!data->incumbent && !data->observer)
+                return SCIP_OKAY;
+
+            auto stop{ false };
+            try
+            {
+                if (SCIPeventGetType(event) & SCIP_EVENTTYPE_BESTSOLFOUND)
+                {
+                    const auto retcode = publish_best_solution(scip, event, *data, &stop);
+                    if (retcode != SCIP_OKAY)
+                        return retcode;
+                }
+                else if (data->observer)
+                    stop = report_progress(scip, data->observer);
+            }
+            catch (...)
+            {
+                return SCIP_NOMEMORY;
+            }
+
+            if (stop)
+                return SCIPinterruptSolve(scip);
+            return SCIP_OKAY;
+        }
+
+
+        SCIP_DECL_HEURFREE(incumbent_import_free)
+        {
+            (void) scip;
+            delete SCIPheurGetData(heur);
+            return SCIP_OKAY;
+        }
+
+
+        // Tries the shared incumbent whenever it has been improved by another solver.
+        SCIP_DECL_HEUREXEC(incumbent_import_exec)
+        {
+            (void) heurtiming;
+            (void) nodeinfeasible;
+            *result = SCIP_DIDNOTRUN;
+            auto* data = SCIPheurGetData(heur);
+            if (!data->incumbent || data->incumbent->version() == data->version)
+                return SCIP_OKAY;
+            data->version = data->incumbent->version();
+
+            const auto incumbent = data->incumbent->get();
+            if (!incumbent || incumbent->solution.size() != data->cols->size())
+                return SCIP_OKAY;
+
+            *result = SCIP_DIDNOTFIND;
+            if (!data->incumbent->is_better(incumbent->objective, SCIPgetPrimalbound(scip)))
+                return SCIP_OKAY;
+
+            SCIP_SOL* sol;
+            auto retcode = SCIPcreateOrigSol(scip, &sol, heur);
+            if (retcode != SCIP_OKAY)
+                return retcode;
+            // See set_start_solution for the const_cast.
+            retcode = SCIPsetSolVals(scip, sol, static_cast<int>(data->cols->size()), data->cols->data(), const_cast<double*>(incumbent->solution.data()));
+            if (retcode != SCIP_OKAY)
+                return retcode;
+
+            SCIP_Bool stored{ FALSE };
+            retcode = SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored);
+            if (retcode != SCIP_OKAY)
+                return retcode;
+            if (stored)
+                *result = SCIP_FOUNDSOL;
+            return SCIP_OKAY;
+        }
+
+
+        // Must be called before the problem is created.
+        void include_solve_plugins(SCIP* p_scip)
+        {
+            if (!SCIPfindEventhdlr(p_scip, c_solve_events_name))
+            {
+                SCIP_EVENTHDLR* eventhdlr;
+                auto data = std::make_unique<SCIP_EventhdlrData>();
+                call_scip(SCIPincludeEventhdlrBasic, p_scip, &eventhdlr, c_solve_events_name,
+                          "publishes the best solution into the shared incumbent and reports to the observer", solve_events_exec, data.get());
+                data.release();
+                call_scip(SCIPsetEventhdlrFree,    p_scip, eventhdlr, solve_events_free);
+                call_scip(SCIPsetEventhdlrInitsol, p_scip, eventhdlr, solve_events_initsol);
+                call_scip(SCIPsetEventhdlrExitsol, p_scip, eventhdlr, solve_events_exitsol);
+            }
+            if (!SCIPfindHeur(p_scip, c_incumbent_import_name))
+            {
+                // Runs after every node, at any depth, with a high priority, since it is cheap if there is nothing new.
+                SCIP_HEUR* heur;
+                auto data = std::make_unique<SCIP_HeurData>();
+                call_scip(SCIPincludeHeurBasic, p_scip, &heur, c_incumbent_import_name,
+                          "tries the shared incumbent of other solvers", 'I', 1000000, 1, 0, -1,
+                          SCIP_HEURTIMING_AFTERNODE, FALSE, incumbent_import_exec, data.get());
+                data.release();
+                call_scip(SCIPsetHeurFree, p_scip, heur, incumbent_import_free);
+            }
+        }
+
+
+        // Tells the plugins about the shared incumbent and the observer during a solve.
+        class SolveScope
+        {
+            public:
+                SolveScope(SCIP* p_scip, SharedIncumbent* p_incumbent, SolveObserver* p_observer, std::vector<SCIP_VAR*>* p_cols)
+                    : d_event_data(SCIPeventhdlrGetData(SCIPfindEventhdlr(p_scip, c_solve_events_name))),
+                      d_heur_data (SCIPheurGetData     (SCIPfindHeur     (p_scip, c_incumbent_import_name)))
+                {
+                    *d_event_data = SCIP_EventhdlrData{ p_incumbent, p_observer, p_cols };
+                    *d_heur_data  = SCIP_HeurData     { p_incumbent, p_cols, 0 };
+                }
+
+                ~SolveScope()
+                {
+                    *d_event_data = SCIP_EventhdlrData();
+                    *d_heur_data  = SCIP_HeurData();
+                }
+
+            private:
+                SCIP_EventhdlrData* d_event_data;
+                SCIP_HeurData*      d_heur_data;
+        };
+    }
+
+
     ILPSolverSCIP::ILPSolverSCIP()
     {
         call_scip(SCIPcreate, &d_scip);
         call_scip(SCIPincludeDefaultPlugins, d_scip);
+        create_problem();
+    }
+
+
+    ILPSolverSCIP::ILPSolverSCIP(std::shared_ptr<SCIPPool> p_pool)
+        : d_scip(p_pool->acquire()), d_pool(std::move(p_pool))
+    {
+        create_problem();
+    }
+
+
+    void ILPSolverSCIP::create_problem()
+    {
+        include_solve_plugins(d_scip);
 
         // All the nullptr's are possible User-data.
         call_scip(SCIPcreateProb, d_scip, "problem", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
@@ -65,19 +291,23 @@ namespace ilp_solver
             call_scip(SCIPreleaseVar, d_scip, &p);
         for (auto& p : d_rows)
             call_scip(SCIPreleaseCons, d_scip, &p);
-        call_scip(SCIPfree, &d_scip);
+
+        if (d_pool)
+            d_pool->release(d_scip);
+        else
+            call_scip(SCIPfree, &d_scip);
     }
 
 
     int ILPSolverSCIP::get_num_constraints() const
     {
-        return static_cast<int>(d_rows.size());
+        return static_cast<int>(d_rows.size()) + d_pending.num_constraints();
     }
 
 
     int ILPSolverSCIP::get_num_variables() const
     {
-        return static_cast<int>(d_cols.size());
+        return static_cast<int>(d_cols.size()) + d_pending.num_variables();
     }
 
 
@@ -107,6 +337,9 @@ namespace ilp_solver
 
     SolutionStatus ILPSolverSCIP::get_status() const
     {
+        if (d_solution_reset)
+            return SolutionStatus::NO_SOLUTION;
+
         int n = 0; // There are null-pointer accesses if called in the wrong stage, which happens if resetted.
         switch (SCIPgetStage(d_scip))
         {
@@ -149,6 +382,22 @@ namespace ilp_solver
 
 
     void ILPSolverSCIP::reset_solution()
+    {
+        // With reoptimization, only the solving data is freed. The transformed problem is kept for the next solve.
+        // A solve stopped by a limit or an interrupt stays in the solving stage, and its data can not be reused,
+        // so then the transformed problem is freed as without reoptimization.
+        if (d_reoptimize && SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM && SCIPgetStage(d_scip) != SCIP_STAGE_SOLVING)
+        {
+            if (SCIPgetStage(d_scip) != SCIP_STAGE_PRESOLVED)
+                call_scip(SCIPfreeReoptSolve, d_scip);
+            d_solution_reset = true;
+            return;
+        }
+        free_transform();
+    }
+
+
+    void ILPSolverSCIP::free_transform()
     {
         // freeTransform does keep the found solutions in the starting solution storage.
         // To hack this, we set the number of stored solutions to 0 before we free, then reset it.
@@ -159,24 +408,51 @@ namespace ilp_solver
         // "frees all solution process data including presolving and transformed problem,
         //  only original problem is kept"
         // This may be overkill, but I have not found another method that actually resetted solution data.
-        // Seems unnecessarily slow though.
+        // Seems unnecessarily slow though, see set_reoptimization.
         call_scip(SCIPfreeTransform, d_scip);
 
         call_scip(SCIPsetIntParam, d_scip, "limits/maxorigsol", tmp);
+        d_solution_reset = false;
+
+        // The objective changed for reoptimization is transferred to the original problem.
+        for (auto j = 0; j < static_cast<int>(d_reopt_objective.size()); ++j)
+            call_scip(SCIPchgVarObj, d_scip, d_cols[j], d_reopt_objective[j]);
+        d_reopt_objective.clear();
+    }
+
+
+    // SCIP checks the flag regularly while solving. The return code is ignored,
+    // since SCIP refuses to set it in stages without a solve to interrupt.
+    void ILPSolverSCIP::interrupt()
+    {
+        SCIPinterruptSolve(d_scip);
+    }
+
+
+    void ILPSolverSCIP::set_reoptimization(bool p_reoptimize)
+    {
+        // Can only be changed for the original problem.
+        if (SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            free_transform();
+
+        call_scip(SCIPenableReoptimization, d_scip, p_reoptimize);
+        d_reoptimize = p_reoptimize;
     }
 
 
     void ILPSolverSCIP::set_start_solution(const std::vector<double>& p_solution)
     {
+        create_pending();
         assert(p_solution.size() == d_cols.size());
 
         // May not be able to set the solution after the problem has been solved or transformed.
         if (SCIPgetStage(d_scip) == SCIP_STAGE_SOLVED)
             reset_solution();
 
+        // An original solution can also be added if the transformed problem is kept for reoptimization.
         SCIP_SOL* sol;
         SCIP_Bool ignored{ false };
-        call_scip(SCIPcreateSol, d_scip, &sol, nullptr);
+        call_scip(SCIPcreateOrigSol, d_scip, &sol, nullptr);
 
         // SCIP uses a double*, not a const double*, but ScaiILP demands a const std::vector<double>&.
         // Internally, SCIP calls a single-variable setter for every variable with a by-value pass of the corresponding double,
@@ -189,8 +465,10 @@ namespace ilp_solver
 
     void ILPSolverSCIP::set_num_threads(int p_num_threads)
     {
-        // Possibly does nothing if not using FiberSCIP or some other parallelization method.
-        call_scip(SCIPsetIntParam, d_scip, "parallel/maxnthreads", p_num_threads);
+        // A plain SCIPsolve is sequential, so for more than one thread, solve_impl runs concurrent solvers
+        // with different settings, which share their solutions. This uses at most parallel/maxnthreads threads.
+        d_num_threads = std::max(p_num_threads, 1);
+        call_scip(SCIPsetIntParam, d_scip, "parallel/maxnthreads", d_num_threads);
 
         // Number of threads for solving the LP, 0 is automatic.
         // 64 is the explicit maximal number.
@@ -201,8 +479,8 @@ namespace ilp_solver
 
     void ILPSolverSCIP::set_deterministic_mode(bool p_deterministic)
     {
-        // Possibly does nothing if not using FiberSCIP or some other parallelization method.
-        call_scip(SCIPsetIntParam, d_scip, "parallel/mode", p_deterministic);
+        // Only affects the concurrent solve. 0 is opportunistic, 1 is deterministic.
+        call_scip(SCIPsetIntParam, d_scip, "parallel/mode", p_deterministic ? 1 : 0);
     }
 
 
@@ -231,6 +509,10 @@ namespace ilp_solver
         // Disable/Enable Heuristics.
         if (p_presolve) call_scip(SCIPsetHeuristics, d_scip, SCIP_PARAMSETTING_DEFAULT, TRUE);
         else            call_scip(SCIPsetHeuristics, d_scip, SCIP_PARAMSETTING_OFF,     TRUE);
+
+        // Solutions of other solvers are always welcome.
+        if (!p_presolve)
+            call_scip(SCIPsetIntParam, d_scip, c_incumbent_import_freq, 1);
     }
 
 
@@ -273,6 +555,9 @@ namespace ilp_solver
     {
         // uses the extension of p_path, so this has to be ".mps".
         assert ( p_path.substr(p_path.rfind('.'), std::string::npos) == ".mps" );
+        create_pending();
+        if (!d_reopt_objective.empty())
+            free_transform(); // Transfers the objective changed for reoptimization to the original problem.
         call_scip(SCIPwriteOrigProblem, d_scip, p_path.c_str(), nullptr, FALSE); // The bool is "generic names"
     }
 
@@ -280,109 +565,338 @@ namespace ilp_solver
     void ILPSolverSCIP::set_objective_sense_impl(ObjectiveSense p_sense)
     {
         auto sense{ (p_sense == ObjectiveSense::MINIMIZE) ? SCIP_OBJSENSE_MINIMIZE : SCIP_OBJSENSE_MAXIMIZE };
-        call_scip(SCIPsetObjsense, d_scip, sense);
+        if (d_reoptimize && SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            reset_solution(); // May free the transformed problem, see there.
+        if (!d_reoptimize || SCIPgetStage(d_scip) == SCIP_STAGE_PROBLEM)
+        {
+            call_scip(SCIPsetObjsense, d_scip, sense);
+            return;
+        }
+
+        // The transformed problem is kept, so the sense and objective are changed for reoptimization.
+        if (d_reopt_objective.empty())
+            for (auto* var: d_cols)
+                d_reopt_objective.push_back(SCIPvarGetObj(var));
+        call_scip(SCIPchgReoptObjective, d_scip, sense, d_cols.data(), d_reopt_objective.data(), static_cast<int>(d_cols.size()));
     }
 
 
     void ILPSolverSCIP::solve_impl()
     {
-        call_scip(SCIPsolve, d_scip);
+        d_solution_reset = false;
+        SolveScope solve_scope(d_scip, d_shared_incumbent.get(), d_observer.get(), &d_cols);
+
+        // SCIP does not support reoptimization for the concurrent solve.
+        // If SCIP has been built without parallelization, SCIPsolveConcurrent falls back to SCIPsolve.
+        // The concurrent solvers only share their solutions among themselves, since the plugins sharing
+        // the incumbent with other solvers and reporting to the observer are not copied to them.
+        // So a shared incumbent and callbacks take precedence over the threads.
+        if (d_num_threads > 1 && !d_reoptimize && !d_shared_incumbent && !d_observer)
+            call_scip(SCIPsolveConcurrent, d_scip);
+        else
+            call_scip(SCIPsolve, d_scip);
     }
 
 
+    // Only buffers the variable. Zeros are dropped.
     void ILPSolverSCIP::add_variable_impl (VariableType p_type, double p_objective, double p_lower_bound, double p_upper_bound,
         const std::string& p_name, const std::vector<double>* p_row_values, const std::vector<int>* p_row_indices)
     {
-        SCIP_VAR* var;
-        const char* name = p_name.c_str();
-
-        SCIP_VARTYPE type = (p_type == VariableType::INTEGER)    ? SCIP_VARTYPE_INTEGER
-                          : (p_type == VariableType::CONTINUOUS) ? SCIP_VARTYPE_CONTINUOUS : SCIP_VARTYPE_BINARY;
-        // Creates a variable of type p_type with corresponding objectives and bounds.
-        // The parameters after p_type are:
-        //     initial:   true  (the column belonging to var is present in the initial root LP.)
-        //     removable: false (the column belonging to var is not removable from the LP.)
-        //     User Data pointers.
-        call_scip( SCIPcreateVar, d_scip, &var, name, p_lower_bound, p_upper_bound, p_objective, type, TRUE, FALSE, nullptr, nullptr, nullptr, nullptr, nullptr );
-        call_scip( SCIPaddVar, d_scip, var );
-        d_cols.push_back(var); // We need to store the variables seperately to access them later on.
-
-        auto n = static_cast<int>(d_rows.size()); // num_constraints.
-
         if (p_row_values) // If we have coefficients given...
         {
-            if (p_row_indices) // and indices...
+            if (p_row_indices) // for the indexed constraints...
             {
                 assert( p_row_values->size() == p_row_indices->size() );
-                // Add the corresponding coefficient to every constraint indexed.
-                for (auto i : *p_row_indices)
+                for (auto k = 0; k < static_cast<int>(p_row_indices->size()); ++k)
                 {
-                    assert( i < n );
-                    call_scip( SCIPaddCoefLinear, d_scip, d_rows[i], var, (*p_row_values)[i] );
+                    assert( (*p_row_indices)[k] < get_num_constraints() );
+                    if ((*p_row_values)[k] != 0.)
+                    {
+                        d_pending.column_indices.push_back((*p_row_indices)[k]);
+                        d_pending.column_values .push_back((*p_row_values)[k]);
+                    }
                 }
             }
-            else
+            else // or for every constraint in the problem...
             {
-                assert( p_row_values->size() >= d_rows.size() );
-                // Add the corresponding coefficient to every constraint in the problem.
-                for (int i = 0; i < n; i++)
+                assert( static_cast<int>(p_row_values->size()) >= get_num_constraints() );
+                for (auto i = 0; i < get_num_constraints(); ++i)
                 {
-                    call_scip( SCIPaddCoefLinear, d_scip, d_rows[i], var, (*p_row_values)[i] );
+                    if ((*p_row_values)[i] != 0.)
+                    {
+                        d_pending.column_indices.push_back(i);
+                        d_pending.column_values .push_back((*p_row_values)[i]);
+                    }
                 }
             }
         }
+        d_pending.column_starts.push_back(static_cast<int>(d_pending.column_values.size()));
+
+        d_pending.variable_type .push_back(p_type);
+        d_pending.objective     .push_back(p_objective);
+        d_pending.variable_lower.push_back(p_lower_bound);
+        d_pending.variable_upper.push_back(p_upper_bound);
+        d_pending.variable_name .push_back(p_name);
     }
 
 
+    // Only buffers the constraint. Zeros are dropped.
     void ILPSolverSCIP::add_constraint_impl (double p_lower_bound, double p_upper_bound,
         const std::vector<double>& p_col_values, const std::string& p_name, const std::vector<int>* p_col_indices)
     {
-        SCIP_CONS* cons;
-        SCIP_VAR**  vars;
-        std::vector<SCIP_VAR*> tmp;
-        int size{0};
-
-        const char* name = p_name.c_str();
-
         // If we have no indices given, we need to have a coefficient for every variable in the problem.
         if (!p_col_indices)
         {
-            assert(p_col_values.size() >= d_cols.size());
-            vars = d_cols.data();
-            size = get_num_variables();
+            assert( static_cast<int>(p_col_values.size()) >= get_num_variables() );
+            for (auto j = 0; j < get_num_variables(); ++j)
+            {
+                if (p_col_values[j] != 0.)
+                {
+                    d_pending.row_indices.push_back(j);
+                    d_pending.row_values .push_back(p_col_values[j]);
+                }
+            }
         }
         else
         {
-            // Otherwise we need to create a vector of the correct variables given by their indices.
-            assert(p_col_values.size() >= p_col_indices->size());
-            tmp.reserve(p_col_indices->size());
-            for (int i : *p_col_indices)
+            assert( p_col_values.size() >= p_col_indices->size() );
+            for (auto k = 0; k < static_cast<int>(p_col_indices->size()); ++k)
             {
-                assert(i < get_num_variables());
-                tmp.push_back(d_cols[i]);
+                assert( (*p_col_indices)[k] < get_num_variables() );
+                if (p_col_values[k] != 0.)
+                {
+                    d_pending.row_indices.push_back((*p_col_indices)[k]);
+                    d_pending.row_values .push_back(p_col_values[k]);
+                }
             }
-            vars = tmp.data();
-            size = static_cast<int>(tmp.size());
         }
+        d_pending.row_starts.push_back(static_cast<int>(d_pending.row_values.size()));
 
-        // SCIP uses a double*, not a const double*, but ScaiILP demands a const std::vector<double>&.
-        // Internally, SCIP copies the buffer, so the const_cast should not violate actual const-ness.
-        // Sadly, it is not avoidable since SCIP is not const-correct. (SCIP 6.0)
-        // The parameters after p_rhs are:
-        //    initial:        true  (the relaxed constraint is in the initial LP.)
-        //    separate:       true  (the constraint should be separated during LP processing.)
-        //    enforce:        true  (the constraint is enforced during node processing.)
-        //    check:          true  (the constraint is checked for feasibility.)
-        //    propagate:      true  (the constraint is propagated during node processing.)
-        //    local:          false (the constraint is valid globally.)
-        //    modifiable:     false (the constraint is not subject to column generation.)
-        //    dynamic:        false (the constraint is not subject to aging.)
-        //    removable:      false (the constraint may not be removed during aging or cleanup.)
-        //    stickingatnode: false (the constraint should not be kept at the node where it was added.)
-        call_scip( SCIPcreateConsLinear, d_scip, &cons, name, size, vars, const_cast<double*>(p_col_values.data()),
-                p_lower_bound, p_upper_bound, TRUE, TRUE, TRUE, TRUE, TRUE, FALSE, FALSE, FALSE, FALSE, FALSE );
-        call_scip( SCIPaddCons, d_scip, cons );
-        d_rows.push_back(cons);
+        d_pending.constraint_lower.push_back(p_lower_bound);
+        d_pending.constraint_upper.push_back(p_upper_bound);
+        d_pending.constraint_name .push_back(p_name);
+    }
+
+
+    void ILPSolverSCIP::prepare_impl()
+    {
+        create_pending();
+    }
+
+
+    void ILPSolverSCIP::create_pending()
+    {
+        if (d_pending.empty())
+            return;
+
+        // Variables and constraints can only be added to the original problem before it is transformed.
+        if (SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            free_transform();
+
+        const auto first_col = static_cast<int>(d_cols.size());
+        const auto first_row = static_cast<int>(d_rows.size());
+        const auto num_rows  = d_pending.num_constraints();
+
+        d_cols.reserve(d_cols.size() + d_pending.num_variables());
+        for (auto j = 0; j < d_pending.num_variables(); ++j)
+        {
+            SCIP_VAR* var;
+            const auto type = d_pending.variable_type[j];
+            SCIP_VARTYPE scip_type = (type == VariableType::INTEGER)    ? SCIP_VARTYPE_INTEGER
+                                   : (type == VariableType::CONTINUOUS) ? SCIP_VARTYPE_CONTINUOUS : SCIP_VARTYPE_BINARY;
+            // The column belonging to var is present in the initial root LP and not removable from it.
+            call_scip( SCIPcreateVarBasic, d_scip, &var, d_pending.variable_name[j].c_str(),
+                       d_pending.variable_lower[j], d_pending.variable_upper[j], d_pending.objective[j], scip_type );
+            // Allows delete_variables to remove the variable from the problem. Only possible before it is added.
+            SCIPvarMarkDeletable(var);
+            call_scip( SCIPaddVar, d_scip, var );
+            d_cols.push_back(var); // We need to store the variables seperately to access them later on.
+        }
+
+        // The non-zeros of the new variables in new constraints are sorted by constraint (a transposition),
+        // so that every new constraint can be created with all its non-zeros at once.
+        std::vector<int> transposed_starts(num_rows + 1, 0);
+        for (auto i: d_pending.column_indices)
+            if (i >= first_row)
+                ++transposed_starts[i - first_row + 1];
+        for (auto i = 0; i < num_rows; ++i)
+            transposed_starts[i + 1] += transposed_starts[i];
+
+        std::vector<SCIP_VAR*> transposed_vars  (transposed_starts.back());
+        std::vector<double>    transposed_values(transposed_starts.back());
+        std::vector<int>       position(transposed_starts.begin(), transposed_starts.end() - 1);
+        for (auto j = 0; j < d_pending.num_variables(); ++j)
+        {
+            for (auto k = d_pending.column_starts[j]; k < d_pending.column_starts[j + 1]; ++k)
+            {
+                const auto i = d_pending.column_indices[k];
+                if (i < first_row)
+                    continue;
+                transposed_vars  [position[i - first_row]  ] = d_cols[first_col + j];
+                transposed_values[position[i - first_row]++] = d_pending.column_values[k];
+            }
+        }
+
+        std::vector<SCIP_VAR*> vars;
+        std::vector<double>    values;
+        d_rows.reserve(d_rows.size() + num_rows);
+        for (auto i = 0; i < num_rows; ++i)
+        {
+            vars  .clear();
+            values.clear();
+            for (auto k = d_pending.row_starts[i]; k < d_pending.row_starts[i + 1]; ++k)
+            {
+                vars  .push_back(d_cols[d_pending.row_indices[k]]);
+                values.push_back(d_pending.row_values[k]);
+            }
+            vars  .insert(vars  .end(), transposed_vars  .begin() + transposed_starts[i], transposed_vars  .begin() + transposed_starts[i + 1]);
+            values.insert(values.end(), transposed_values.begin() + transposed_starts[i], transposed_values.begin() + transposed_starts[i + 1]);
+
+            // Like SCIPcreateConsLinear with initial, separate, enforce, check and propagate set,
+            // and local, modifiable, dynamic, removable and stickingatnode not set.
+            SCIP_CONS* cons;
+            call_scip( SCIPcreateConsBasicLinear, d_scip, &cons, d_pending.constraint_name[i].c_str(), static_cast<int>(vars.size()),
+                       vars.data(), values.data(), d_pending.constraint_lower[i], d_pending.constraint_upper[i] );
+            call_scip( SCIPaddCons, d_scip, cons );
+            d_rows.push_back(cons);
+        }
+
+        // Only the non-zeros of new variables in existing constraints must be added one by one.
+        for (auto j = 0; j < d_pending.num_variables(); ++j)
+            for (auto k = d_pending.column_starts[j]; k < d_pending.column_starts[j + 1]; ++k)
+                if (d_pending.column_indices[k] < first_row)
+                    call_scip( SCIPaddCoefLinear, d_scip, d_rows[d_pending.column_indices[k]], d_cols[first_col + j], d_pending.column_values[k] );
+
+        d_pending = PendingModel();
+    }
+
+
+    // The original problem can only be changed before it is transformed.
+    // Since the transformed problem depends on the changed data, it must be freed anyway.
+    void ILPSolverSCIP::set_variable_bounds_impl(int p_variable_index, double p_lower_bound, double p_upper_bound)
+    {
+        create_pending();
+        if (SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            free_transform();
+
+        // SCIP rejects a lower bound above the current upper bound and vice versa.
+        auto* var = d_cols[p_variable_index];
+        if (p_lower_bound > SCIPvarGetUbOriginal(var))
+        {
+            call_scip(SCIPchgVarUb, d_scip, var, p_upper_bound);
+            call_scip(SCIPchgVarLb, d_scip, var, p_lower_bound);
+        }
+        else
+        {
+            call_scip(SCIPchgVarLb, d_scip, var, p_lower_bound);
+            call_scip(SCIPchgVarUb, d_scip, var, p_upper_bound);
+        }
+    }
+
+
+    void ILPSolverSCIP::set_constraint_bounds_impl(int p_constraint_index, double p_lower_bound, double p_upper_bound)
+    {
+        create_pending();
+        if (SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            free_transform();
+
+        auto* cons = d_rows[p_constraint_index];
+        if (p_lower_bound > SCIPgetRhsLinear(d_scip, cons))
+        {
+            call_scip(SCIPchgRhsLinear, d_scip, cons, p_upper_bound);
+            call_scip(SCIPchgLhsLinear, d_scip, cons, p_lower_bound);
+        }
+        else
+        {
+            call_scip(SCIPchgLhsLinear, d_scip, cons, p_lower_bound);
+            call_scip(SCIPchgRhsLinear, d_scip, cons, p_upper_bound);
+        }
+    }
+
+
+    // With reoptimization, the objective is only changed before the next solve, see set_objective_sense_impl.
+    void ILPSolverSCIP::set_objective_coefficient_impl(int p_variable_index, double p_objective)
+    {
+        create_pending();
+        if (d_reoptimize && SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            reset_solution(); // May free the transformed problem, see there.
+        if (d_reoptimize && SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+        {
+            if (d_reopt_objective.empty())
+                for (auto* var: d_cols)
+                    d_reopt_objective.push_back(SCIPvarGetObj(var));
+            d_reopt_objective[p_variable_index] = p_objective;
+            return;
+        }
+
+        if (SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            free_transform();
+
+        call_scip(SCIPchgVarObj, d_scip, d_cols[p_variable_index], p_objective);
+    }
+
+
+    // Adds the variable to the constraint if its coefficient was zero.
+    void ILPSolverSCIP::set_coefficient_impl(int p_constraint_index, int p_variable_index, double p_value)
+    {
+        create_pending();
+        if (SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            free_transform();
+
+        call_scip(SCIPchgCoefLinear, d_scip, d_rows[p_constraint_index], d_cols[p_variable_index], p_value);
+    }
+
+
+    void ILPSolverSCIP::delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping)
+    {
+        create_pending();
+        if (SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            free_transform();
+
+        for (auto i: p_deleted_indices)
+        {
+            call_scip(SCIPdelCons, d_scip, d_rows[i]);
+            call_scip(SCIPreleaseCons, d_scip, &d_rows[i]);
+        }
+        compact(&d_rows, p_index_mapping);
+    }
+
+
+    // In the problem stage, SCIPdelVar does not remove the variable from the constraints, this must be done before.
+    // Every constraint is scanned once, which takes time linear in the number of non-zeros.
+    void ILPSolverSCIP::delete_variables_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping)
+    {
+        create_pending();
+        if (SCIPgetStage(d_scip) != SCIP_STAGE_PROBLEM)
+            free_transform();
+
+        std::unordered_set<SCIP_VAR*> deleted_vars;
+        for (auto j: p_deleted_indices)
+            deleted_vars.insert(d_cols[j]);
+
+        std::vector<SCIP_VAR*> vars_to_remove;
+        for (auto* cons: d_rows)
+        {
+            const auto  num_vars = SCIPgetNVarsLinear(d_scip, cons);
+            const auto* vars     = SCIPgetVarsLinear (d_scip, cons);
+            vars_to_remove.clear();
+            for (auto k = 0; k < num_vars; ++k)
+                if (deleted_vars.count(vars[k]) > 0)
+                    vars_to_remove.push_back(vars[k]);
+            for (auto* var: vars_to_remove)
+                call_scip(SCIPdelCoefLinear, d_scip, cons, var);
+        }
+
+        for (auto j: p_deleted_indices)
+        {
+            // If SCIP refuses to delete the variable, it stays in the problem, but without any effect on it.
+            SCIP_Bool deleted{ FALSE };
+            call_scip(SCIPdelVar, d_scip, d_cols[j], &deleted);
+            if (!deleted)
+                call_scip(SCIPchgVarObj, d_scip, d_cols[j], 0.);
+            call_scip(SCIPreleaseVar, d_scip, &d_cols[j]);
+        }
+        compact(&d_cols, p_index_mapping);
     }
 }
 
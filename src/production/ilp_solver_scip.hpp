@@ -2,16 +2,19 @@
 
 #if WITH_SCIP == 1
 
+#include "ilp_scip_pool.hpp"
 #include "ilp_solver_impl.hpp"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #pragma comment(lib, "scip.lib")
 
 
 namespace ilp_solver
 {
     // Necessary forward declarations of structs and typedefs.
-    struct  Scip;
-    typedef Scip SCIP;
     struct  SCIP_Cons;
     typedef SCIP_Cons SCIP_CONS;
     struct  SCIP_Var;
@@ -25,6 +28,8 @@ namespace ilp_solver
     public:
 
         ILPSolverSCIP();
+        // Takes the SCIP environment from p_pool and returns it on destruction.
+        explicit ILPSolverSCIP(std::shared_ptr<SCIPPool> p_pool);
         ~ILPSolverSCIP();
 
         int get_num_constraints() const override;
@@ -34,8 +39,17 @@ namespace ilp_solver
         double              get_objective() const override;
         SolutionStatus      get_status()    const override;
 
+        // With reoptimization, this keeps the transformed problem if possible.
         void                reset_solution()      override;
 
+        // Enables SCIP's reoptimization, which speeds up re-solving a model after changing only its objective.
+        // reset_solution and changes of objective coefficients then keep the transformed problem and the data
+        // of the previous solves. All other changes of the model still free the transformed problem.
+        // SCIP restricts presolve and propagation for reoptimization, which may slow down the first solve.
+        void set_reoptimization(bool p_reoptimize);
+
+        void                interrupt()           override;
+
         void set_start_solution(const std::vector<double>& p_solution) override;
 
         void set_num_threads(int p_num_threads)           override;
@@ -52,10 +66,59 @@ namespace ilp_solver
         void print_mps_file(const std::string& p_path)    override;
 
     private:
+        // Variables and constraints added since they were last created in SCIP.
+        // The non-zeros given with a variable are stored column-major, those given with a constraint row-major.
+        // Row indices of the columns and column indices of the rows count the created ones first.
+        struct PendingModel
+        {
+            std::vector<VariableType> variable_type;
+            std::vector<double>       objective;
+            std::vector<double>       variable_lower;
+            std::vector<double>       variable_upper;
+            std::vector<std::string>  variable_name;
+            std::vector<int>          column_starts{ 0 };
+            std::vector<int>          column_indices;
+            std::vector<double>       column_values;
+
+            std::vector<double>       constraint_lower;
+            std::vector<double>       constraint_upper;
+            std::vector<std::string>  constraint_name;
+            std::vector<int>          row_starts{ 0 };
+            std::vector<int>          row_indices;
+            std::vector<double>       row_values;
+
+            int  num_variables  () const { return static_cast<int>(objective.size()); }
+            int  num_constraints() const { return static_cast<int>(constraint_lower.size()); }
+            bool empty          () const { return num_variables() == 0 && num_constraints() == 0; }
+        };
+
         SCIP* d_scip;
+        std::shared_ptr<SCIPPool> d_pool;
 
         std::vector<SCIP_CONS*>   d_rows;
         std::vector<SCIP_VAR*>    d_cols;
+        PendingModel              d_pending;
+
+        // Several threads are used by solving concurrently with different settings.
+        int                       d_num_threads{ 1 };
+        bool                      d_reoptimize{ false };
+        // Set by reset_solution if it keeps the solution data of SCIP, which must not be reported then.
+        bool                      d_solution_reset{ false };
+        // The objective coefficients changed since the transformed problem was kept, or empty.
+        // Applied with the objective sense before the next solve.
+        std::vector<double>       d_reopt_objective;
+
+        // Creates the pending variables and constraints in SCIP, every constraint with a single call.
+        // Called before the solve and before anything that accesses the created ones.
+        void create_pending();
+
+        // Creates the empty problem in the new environment.
+        void create_problem();
+
+        // Frees the transformed problem and all solution data, so that the original problem can be changed.
+        void free_transform();
+
+        void prepare_impl() override;
 
         void set_objective_sense_impl(ObjectiveSense p_sense) override;
         void solve_impl() override;
@@ -67,6 +130,14 @@ namespace ilp_solver
         void add_constraint_impl (double p_lower_bound, double p_upper_bound,
             const std::vector<double>& p_col_values, const std::string& p_name = "",
             const std::vector<int>* p_col_indices = nullptr) override;
+
+        void set_variable_bounds_impl      (int p_variable_index,   double p_lower_bound, double p_upper_bound) override;
+        void set_constraint_bounds_impl    (int p_constraint_index, double p_lower_bound, double p_upper_bound) override;
+        void set_objective_coefficient_impl(int p_variable_index,   double p_objective)                         override;
+        void set_coefficient_impl          (int p_constraint_index, int p_variable_index, double p_value)       override;
+
+        void delete_constraints_impl(const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
+        void delete_variables_impl  (const std::vector<int>& p_deleted_indices, const std::vector<int>& p_index_mapping) override;
     };
 }
 
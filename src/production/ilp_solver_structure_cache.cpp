@@ -0,0 +1,48 @@
+#include "ilp_solver_structure_cache.hpp"
+
+#include "ilp_fingerprint.hpp"
+
+namespace ilp_solver
+{
+    ILPSolverStructureCache::ILPSolverStructureCache(BackendFactory p_backend_factory, const void* p_backend_id,
+                                                     std::shared_ptr<ILPStructureCache> p_cache)
+        : ILPSolverDecorator(std::move(p_backend_factory)),
+          d_backend_id(p_backend_id),
+          d_cache(std::move(p_cache))
+    { }
+
+
+    void ILPSolverStructureCache::solve_impl()
+    {
+        d_ilp_solution_data = ILPSolutionData(d_ilp_data.objective_sense);
+
+        const StructureKey key{ d_backend_id, structure_fingerprint(d_ilp_data) };
+        auto resident_solver = d_cache->acquire(key);
+
+        if (resident_solver && has_same_structure(*resident_solver, d_ilp_data))
+        {
+            resident_solver->solver->reset_solution();
+            update_resident_data(&*resident_solver, d_ilp_data);
+        }
+        else
+        {
+            resident_solver.emplace();
+            resident_solver->solver = create_backend();
+            transfer_model(resident_solver->solver.get(), d_ilp_data);
+            store_resident_data(&*resident_solver, d_ilp_data);
+        }
+
+        auto* solver = resident_solver->solver.get();
+        if (!d_ilp_data.start_solution.empty())
+            solver->set_start_solution(d_ilp_data.start_solution);
+        set_solver_parameters(solver, d_ilp_data);
+        relay_callbacks(solver);
+
+        d_ilp_solution_data = optimize_backend(solver, d_ilp_data.objective_sense);
+
+        // The cache must not keep the callbacks of this solve alive.
+        solver->set_incumbent_callback(IncumbentCallback());
+        solver->set_progress_callback (ProgressCallback(), 0.);
+        d_cache->release(key, std::move(*resident_solver));
+    }
+}
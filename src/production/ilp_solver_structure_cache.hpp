@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ilp_solver_decorator.hpp"
+#include "ilp_structure_cache.hpp"
+
+#include <memory>
+
+namespace ilp_solver
+{
+    // Reuses backends for models with the same matrix and variable types.
+    // A solve takes a backend that already contains a model of the same structure from an ILPStructureCache,
+    // transfers only the bounds, right-hand sides and objective coefficients that differ, and solves.
+    // Afterwards, the backend is returned to the cache for the next model of this structure.
+    // Only decorators with the same p_backend_id share backends. It must identify the backend factory, e.g. by its address.
+    class ILPSolverStructureCache : public ILPSolverDecorator
+    {
+        public:
+            ILPSolverStructureCache(BackendFactory p_backend_factory, const void* p_backend_id,
+                                    std::shared_ptr<ILPStructureCache> p_cache = default_structure_cache());
+
+        private:
+            const void*                        d_backend_id;
+            std::shared_ptr<ILPStructureCache> d_cache;
+
+            void solve_impl() override;
+    };
+}
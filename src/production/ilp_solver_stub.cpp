@@ -1,9 +1,14 @@
 #include "ilp_solver_stub.hpp"
 
+#include "ilp_model_delta.hpp"
+#include "ilp_shared_incumbent.hpp"
+#include "ilp_solve_observer.hpp"
 #include "shared_memory_communication.hpp"
 #include "solver_exit_code.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -14,6 +19,7 @@
 
 constexpr auto c_file_separator = L"\\";
 constexpr auto c_max_path_length = 1 << 16;
+constexpr auto c_incumbent_exchange_milliseconds = 50;
 
 using std::string;
 using std::wstring;
@@ -62,7 +68,7 @@ namespace ilp_solver
     }
 
 
-    static SolverExitCode execute_process(const string& p_executable_basename, const string& p_parameter, int p_wait_milliseconds)
+    static PROCESS_INFORMATION start_process(const string& p_executable_basename, const string& p_parameter)
     {
         // get and check executable path
         const auto executable = full_executable_name(p_executable_basename);
@@ -95,42 +101,108 @@ namespace ilp_solver
                             &process_info))
             throw SolverExeException(("Error starting " + p_executable_basename + ". Error code:" + std::to_string(GetLastError())).c_str());
 
-        // close handles via RAII
-        struct HandleCloser
-        {
-            explicit HandleCloser(PROCESS_INFORMATION* p_process_info) : process_info(p_process_info) {}
-            ~HandleCloser()
+        return process_info;
+    }
+
+
+    // A solver process that solves the requests of a session one after the other and keeps its model in between.
+    class SolverProcess
+    {
+        public:
+            explicit SolverProcess(const string& p_executable_basename)
+                : d_executable_basename(p_executable_basename),
+                  d_process_info(start_process(p_executable_basename, c_session_prefix + d_session.name()))
+            {}
+
+            // Asks the process to quit, unless it is still solving, e.g. after an exception while waiting for it.
+            ~SolverProcess()
             {
-                CloseHandle(process_info->hProcess);
-                CloseHandle(process_info->hThread);
+                if (d_running && !d_solving)
+                {
+                    d_session.post(SessionRequest::quit);
+                    if (WaitForSingleObject(d_process_info.hProcess, c_quit_milliseconds) != WAIT_OBJECT_0)
+                        TerminateProcess(d_process_info.hProcess, static_cast<DWORD>(SolverExitCode::forced_termination));
+                }
+                else if (d_running)
+                    TerminateProcess(d_process_info.hProcess, static_cast<DWORD>(SolverExitCode::forced_termination));
+
+                CloseHandle(d_process_info.hProcess);
+                CloseHandle(d_process_info.hThread);
             }
 
-            PROCESS_INFORMATION* process_info;
-        } handle_closer(&process_info);
+            SolverProcess(const SolverProcess&) = delete;
+            SolverProcess& operator= (const SolverProcess&) = delete;
 
-        // wait for the process to terminate
-        auto return_code = WaitForSingleObject(process_info.hProcess, p_wait_milliseconds);
-        switch (return_code) // according to https://msdn.microsoft.com/de-de/library/windows/desktop/ms687032%28v=vs.85%29.aspx, WaitForSingeObject can return the 4 values listed below
-        {
-        case WAIT_OBJECT_0:
-            break;
-        case WAIT_TIMEOUT:
-            TerminateProcess(process_info.hProcess, static_cast<DWORD>(SolverExitCode::forced_termination));
-            break;
-        case WAIT_ABANDONED:
-        case WAIT_FAILED:
-        default: // we also handle unexpected values, just in case
-            TerminateProcess(process_info.hProcess, static_cast<DWORD>(SolverExitCode::forced_termination));
-            throw std::exception (("Error running " + p_executable_basename + ". Unexpected return code of WaitForSingleObject.").c_str());
-        }
+            // Returns the exit code of the request, or the exit code of the process if it has terminated.
+            // Calls p_while_waiting (if given) every c_incumbent_exchange_milliseconds.
+            // The process keeps running only if the request has been solved.
+            SolverExitCode solve(SessionRequest p_request, const string& p_handoff_name, int p_wait_milliseconds,
+                                 const std::function<void()>& p_while_waiting)
+            {
+                d_session.post(p_request, p_handoff_name);
+                d_solving = true;
+
+                auto remaining_milliseconds = p_wait_milliseconds;
+                while (true)
+                {
+                    const auto interval = std::min(remaining_milliseconds, c_incumbent_exchange_milliseconds);
+                    if (d_session.wait_for_response(interval))
+                    {
+                        d_solving = false;
+                        d_running = (d_session.exit_code() == SolverExitCode::ok);
+                        return d_session.exit_code();
+                    }
+                    remaining_milliseconds -= interval;
+
+                    switch (WaitForSingleObject(d_process_info.hProcess, 0)) // according to https://msdn.microsoft.com/de-de/library/windows/desktop/ms687032%28v=vs.85%29.aspx, WaitForSingeObject can return the 4 values listed below
+                    {
+                    case WAIT_OBJECT_0:
+                        d_solving = false;
+                        d_running = false;
+                        return process_exit_code();
+                    case WAIT_TIMEOUT:
+                        break;
+                    case WAIT_ABANDONED:
+                    case WAIT_FAILED:
+                    default: // we also handle unexpected values, just in case
+                        throw std::exception (("Error running " + d_executable_basename + ". Unexpected return code of WaitForSingleObject.").c_str());
+                    }
+
+                    if (remaining_milliseconds <= 0)
+                    {
+                        TerminateProcess(d_process_info.hProcess, static_cast<DWORD>(SolverExitCode::forced_termination));
+                        d_solving = false;
+                        d_running = false;
+                        return SolverExitCode::forced_termination;
+                    }
+                    if (p_while_waiting)
+                        p_while_waiting();
+                }
+            }
 
-        // read process exit code
-        DWORD exit_code;
-        if (GetExitCodeProcess(process_info.hProcess, &exit_code))
-            return SolverExitCode(exit_code);
-        else
-            throw std::exception(("Error obtaining exit code from " + p_executable_basename + ". Error code: " + std::to_string(GetLastError())).c_str());
-    }
+            // The model of the process, as of its last solve.
+            const ILPData& model    () const                 { return d_model; }
+            void           set_model(const ILPData& p_model) { d_model = p_model; }
+
+        private:
+            static constexpr int c_quit_milliseconds{ 1000 };
+
+            string              d_executable_basename;
+            SessionParent       d_session;
+            PROCESS_INFORMATION d_process_info;
+            bool                d_running{ true };
+            bool                d_solving{ false };
+            ILPData             d_model;
+
+            SolverExitCode process_exit_code() const
+            {
+                DWORD exit_code;
+                if (GetExitCodeProcess(d_process_info.hProcess, &exit_code))
+                    return SolverExitCode(exit_code);
+                else
+                    throw std::exception(("Error obtaining exit code from " + d_executable_basename + ". Error code: " + std::to_string(GetLastError())).c_str());
+            }
+    };
 
 
     int seconds_to_milliseconds (double p_seconds)
@@ -200,12 +272,39 @@ namespace ilp_solver
             throw std::exception(("External ILP solver: " + exit_code_to_message(p_exit_code)).c_str());
     }
 
+    // Passes the new solutions and the progress of the solver process on to the callbacks, and a request to stop back.
+    static void relay_to_observer(IncumbentSlot* v_slot, const SharedIncumbent& p_incumbent, long long* v_reported_version, SolveObserver* v_observer)
+    {
+        const auto version = p_incumbent.version();
+        if (version != *v_reported_version)
+        {
+            *v_reported_version = version;
+            if (const auto best = p_incumbent.get())
+                v_observer->report_incumbent(best->solution.data(), static_cast<int>(best->solution.size()), best->objective);
+        }
+
+        double    objective;
+        double    best_bound;
+        long long num_nodes;
+        if (v_slot->read_progress(&objective, &best_bound, &num_nodes))
+            v_observer->report_progress(objective, best_bound, num_nodes);
+
+        if (v_observer->stop_requested())
+            v_slot->request_interrupt();
+    }
+
+
     // set_default_parameters is called in ILPSolverCollect.
-    ILPSolverStub::ILPSolverStub(const std::string& p_executable_basename)
-        : d_executable_basename(p_executable_basename)
+    ILPSolverStub::ILPSolverStub(const std::string& p_executable_basename, std::size_t p_max_shared_memory_bytes)
+        : d_executable_basename(p_executable_basename),
+          d_max_shared_memory_bytes(p_max_shared_memory_bytes)
     { }
 
 
+    // The solver process is asked to quit before the shared memory is released.
+    ILPSolverStub::~ILPSolverStub() = default;
+
+
     std::vector<double> ILPSolverStub::get_solution() const
     {
         return d_ilp_solution_data.solution;
@@ -232,17 +331,70 @@ namespace ilp_solver
 
 
 
-    void ILPSolverStub::solve_impl()
+    // Only sets a flag, which is passed on to the solver process while waiting for it.
+    void ILPSolverStub::interrupt()
     {
-        d_ilp_solution_data = ILPSolutionData(d_ilp_data.objective_sense);
+        d_interrupt_requested = true;
+    }
 
-        CommunicationParent communicator;
-        const auto shared_memory_name = communicator.write_ilp_data(d_ilp_data);
 
-        auto exit_code = execute_process(d_executable_basename, shared_memory_name, seconds_to_milliseconds (1.5 * d_ilp_data.max_seconds));
+    void ILPSolverStub::solve_impl()
+    {
+        d_ilp_solution_data   = ILPSolutionData(d_ilp_data.objective_sense);
+        d_interrupt_requested = false;
+
+        if (!d_communicator)
+            d_communicator = std::make_unique<CommunicationParent>(d_max_shared_memory_bytes);
+
+        // A running solver process has kept the model of the previous solve and only needs the changes.
+        ModelDelta delta;
+        const auto send_delta = d_process && compute_model_delta(d_process->model(), d_ilp_data, d_matrix_changed, &delta);
+        const auto handoff_name = send_delta ? d_communicator->write_model_delta(delta, d_ilp_data)
+                                             : d_communicator->write_ilp_data(d_ilp_data, d_matrix_changed);
+        d_matrix_changed = false;
+        if (!d_process)
+            d_process = std::make_unique<SolverProcess>(d_executable_basename);
+
+        // The solver process shares its solutions and its progress and receives interrupt requests through the incumbent slot,
+        // which is polled while waiting. Without a shared incumbent, the solutions for the callbacks arrive in one of their own.
+        auto incumbent = d_shared_incumbent;
+        if (!incumbent && d_observer)
+            incumbent = std::make_shared<SharedIncumbent>(d_ilp_data.objective_sense);
+
+        auto& incumbent_slot = d_communicator->incumbent_slot();
+        incumbent_slot.reset(incumbent != nullptr);
+        long long reported_version{ 0 };
+        auto exchange = [&incumbent_slot, &incumbent, &reported_version, this]()
+        {
+            if (incumbent)
+                incumbent_slot.exchange(incumbent.get());
+            if (d_observer)
+                relay_to_observer(&incumbent_slot, *incumbent, &reported_version, d_observer.get());
+            if (d_interrupt_requested)
+                incumbent_slot.request_interrupt();
+        };
+
+        SolverExitCode exit_code;
+        try
+        {
+            exit_code = d_process->solve(send_delta ? SessionRequest::solve_model_delta : SessionRequest::solve_model, handoff_name,
+                                         seconds_to_milliseconds (1.5 * d_ilp_data.max_seconds), exchange);
+        }
+        catch (...)
+        {
+            d_process.reset();
+            throw;
+        }
+
         if (exit_code != SolverExitCode::ok)
+        {
+            d_process.reset();
             handle_error(d_ilp_data.log_level, exit_code);
+        }
         else
-            communicator.read_solution_data(&d_ilp_solution_data);
+        {
+            d_process->set_model(d_ilp_data);
+            d_communicator->read_solution_data(&d_ilp_solution_data);
+        }
     }
 }
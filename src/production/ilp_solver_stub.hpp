@@ -3,16 +3,33 @@
 #include "ilp_data.hpp"
 #include "ilp_solver_collect.hpp"
 
+#include <atomic>
+#include <limits>
+#include <memory>
 #include <string>
 
 namespace ilp_solver
 {
+    class CommunicationParent;
+    class SolverProcess;
+
+
     // Receives data about the ILP, writes it into shared memory,
-    // and starts a new solver process that solves the ILP.
+    // and lets a solver process solve the ILP.
+    // Models whose serialization needs more than p_max_shared_memory_bytes are written to a temporary file instead,
+    // which the solver process maps read-only.
+    // The solver process is started by the first solve and keeps its model between solves. Later solves only write
+    // the changed bounds, objective and coefficients and the appended variables and constraints (see ModelDelta),
+    // which the solver process applies to its model. Thus, a re-solve costs as much as the change, not as the model.
+    // Only other changes, e.g. fewer variables, make the solver process build the whole model anew.
+    // A solver process that has failed or timed out is terminated, and the next solve starts a new one.
+    // A shared incumbent (see set_shared_incumbent) and interrupt requests are passed to the solver process
+    // through the shared memory. The solutions and the progress of the solver process come back for the callbacks.
     class ILPSolverStub : public ILPSolverCollect
     {
         public:
-            explicit ILPSolverStub(const std::string& p_executable_basename);
+            explicit ILPSolverStub(const std::string& p_executable_basename, std::size_t p_max_shared_memory_bytes = std::numeric_limits<std::size_t>::max());
+            ~ILPSolverStub();
 
             std::vector<double>       get_solution  () const override;
             double                    get_objective () const override;
@@ -20,11 +37,19 @@ namespace ilp_solver
 
             void                      reset_solution()       override;
 
+            void                      interrupt     ()       override;
+
         private:
             std::string d_executable_basename;
+            std::size_t d_max_shared_memory_bytes;
 
             ILPSolutionData d_ilp_solution_data;
 
+            std::unique_ptr<CommunicationParent> d_communicator;
+            std::unique_ptr<SolverProcess>       d_process;
+
+            std::atomic<bool> d_interrupt_requested{ false };
+
             void solve_impl() override;
     };
 }
@@ -0,0 +1,63 @@
+#include "ilp_sparse_matrix.hpp"
+
+namespace ilp_solver
+{
+    SparseMatrix column_major_copy(const ILPData& p_data)
+    {
+        SparseMatrix result;
+        result.num_rows    = static_cast<int>(p_data.matrix.size());
+        result.num_columns = static_cast<int>(p_data.variable_type.size());
+
+        // Count the non-zeros per column first, so that every array is allocated exactly once.
+        result.start.assign(result.num_columns + 1, 0);
+        for (const auto& row: p_data.matrix)
+            for (auto j = 0; j < result.num_columns; ++j)
+                if (row[j] != 0.)
+                    ++result.start[j + 1];
+        for (auto j = 0; j < result.num_columns; ++j)
+            result.start[j + 1] += result.start[j];
+
+        const auto num_non_zeros = result.start[result.num_columns];
+        result.index.resize(num_non_zeros);
+        result.value.resize(num_non_zeros);
+
+        auto position = std::vector<int>(result.start.begin(), result.start.end() - 1);
+        for (auto i = 0; i < result.num_rows; ++i)
+        {
+            const auto& row = p_data.matrix[i];
+            for (auto j = 0; j < result.num_columns; ++j)
+            {
+                if (row[j] == 0.)
+                    continue;
+                const auto k = position[j]++;
+                result.index[k] = i;
+                result.value[k] = row[j];
+            }
+        }
+        return result;
+    }
+
+
+    // A single pass, since the rows are stored one after the other.
+    SparseMatrix row_major_copy(const ILPData& p_data)
+    {
+        SparseMatrix result;
+        result.num_rows    = static_cast<int>(p_data.matrix.size());
+        result.num_columns = static_cast<int>(p_data.variable_type.size());
+
+        result.start.reserve(result.num_rows + 1);
+        result.start.push_back(0);
+        for (const auto& row: p_data.matrix)
+        {
+            for (auto j = 0; j < result.num_columns; ++j)
+            {
+                if (row[j] == 0.)
+                    continue;
+                result.index.push_back(j);
+                result.value.push_back(row[j]);
+            }
+            result.start.push_back(result.num_non_zeros());
+        }
+        return result;
+    }
+}
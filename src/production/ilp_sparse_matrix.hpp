@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ilp_data.hpp"
+
+#include <vector>
+
+namespace ilp_solver
+{
+    // Compressed sparse copy of a matrix.
+    // The non-zeros of major line k (a column for column-major, a row for row-major storage)
+    // are index[start[k]], ..., index[start[k+1]-1] with the values value[start[k]], ....
+    struct SparseMatrix
+    {
+        int num_rows   { 0 };
+        int num_columns{ 0 };
+
+        std::vector<int>    start;
+        std::vector<int>    index;
+        std::vector<double> value;
+
+        int num_non_zeros() const { return static_cast<int>(value.size()); }
+    };
+
+
+    // The number of columns is taken from the variables, so that models without constraints are handled.
+    SparseMatrix column_major_copy(const ILPData& p_data);
+
+    SparseMatrix row_major_copy   (const ILPData& p_data);
+}
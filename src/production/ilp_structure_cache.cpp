@@ -0,0 +1,162 @@
+#include "ilp_structure_cache.hpp"
+
+#include "ilp_data.hpp"
+
+#include <algorithm>
+
+using std::vector;
+
+namespace ilp_solver
+{
+    ILPStructureCache::ILPStructureCache(std::size_t p_capacity)
+        : d_capacity(p_capacity)
+    { }
+
+
+    std::optional<ResidentSolver> ILPStructureCache::acquire(const StructureKey& p_key)
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+
+        const auto position = std::find_if(d_entries.begin(), d_entries.end(),
+                                           [&p_key](const Entry& p_entry) { return p_entry.first == p_key; });
+        if (position == d_entries.end())
+        {
+            ++d_num_misses;
+            return std::nullopt;
+        }
+
+        ++d_num_hits;
+        auto resident_solver = std::move(position->second);
+        d_entries.erase(position);
+        return resident_solver;
+    }
+
+
+    // Destroying a solver may take a while. Thus, the evicted solvers are destroyed after the lock has been released.
+    void ILPStructureCache::release(const StructureKey& p_key, ResidentSolver p_resident_solver)
+    {
+        std::list<Entry> evicted;
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_entries.emplace_front(p_key, std::move(p_resident_solver));
+            evicted = shrink_to_capacity();
+        }
+    }
+
+
+    void ILPStructureCache::configure(std::size_t p_capacity)
+    {
+        std::list<Entry> evicted;
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_capacity = p_capacity;
+            evicted = shrink_to_capacity();
+        }
+    }
+
+
+    long long ILPStructureCache::num_hits() const
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_num_hits;
+    }
+
+
+    long long ILPStructureCache::num_misses() const
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        return d_num_misses;
+    }
+
+
+    std::list<ILPStructureCache::Entry> ILPStructureCache::shrink_to_capacity()
+    {
+        std::list<Entry> evicted;
+        if (d_entries.size() > d_capacity)
+            evicted.splice(evicted.begin(), d_entries, std::next(d_entries.begin(), d_capacity), d_entries.end());
+        return evicted;
+    }
+
+
+    std::shared_ptr<ILPStructureCache> default_structure_cache()
+    {
+        static const auto s_cache{ std::make_shared<ILPStructureCache>() };
+        return s_cache;
+    }
+
+
+    void store_resident_data(ResidentSolver* v_resident_solver, const ILPData& p_data)
+    {
+        v_resident_solver->matrix           = p_data.matrix;
+        v_resident_solver->variable_type    = p_data.variable_type;
+        v_resident_solver->objective        = p_data.objective;
+        v_resident_solver->variable_lower   = p_data.variable_lower;
+        v_resident_solver->variable_upper   = p_data.variable_upper;
+        v_resident_solver->constraint_lower = p_data.constraint_lower;
+        v_resident_solver->constraint_upper = p_data.constraint_upper;
+    }
+
+
+    // The sizes are compared first, as they tell most collisions apart without looking at the coefficients.
+    bool has_same_structure(const ResidentSolver& p_resident_solver, const ILPData& p_data)
+    {
+        return p_resident_solver.variable_type.size()    == p_data.variable_type.size()
+            && p_resident_solver.constraint_lower.size() == p_data.constraint_lower.size()
+            && p_resident_solver.variable_type           == p_data.variable_type
+            && p_resident_solver.matrix                  == p_data.matrix;
+    }
+
+
+    void update_resident_data(ResidentSolver* v_resident_solver, const ILPData& p_data)
+    {
+        auto* solver = v_resident_solver->solver.get();
+
+        vector<int>    indices;
+        vector<double> lower_bounds;
+        vector<double> upper_bounds;
+
+        const auto num_variables = static_cast<int>(p_data.objective.size());
+        for (auto j = 0; j < num_variables; ++j)
+        {
+            if (v_resident_solver->variable_lower[j] != p_data.variable_lower[j] || v_resident_solver->variable_upper[j] != p_data.variable_upper[j])
+            {
+                indices.push_back(j);
+                lower_bounds.push_back(p_data.variable_lower[j]);
+                upper_bounds.push_back(p_data.variable_upper[j]);
+            }
+        }
+        if (!indices.empty())
+            solver->set_variable_bounds(indices, lower_bounds, upper_bounds);
+
+        indices.clear();
+        vector<double> objective;
+        for (auto j = 0; j < num_variables; ++j)
+        {
+            if (v_resident_solver->objective[j] != p_data.objective[j])
+            {
+                indices.push_back(j);
+                objective.push_back(p_data.objective[j]);
+            }
+        }
+        if (!indices.empty())
+            solver->set_objective_coefficient(indices, objective);
+
+        indices.clear();
+        lower_bounds.clear();
+        upper_bounds.clear();
+        const auto num_constraints = static_cast<int>(p_data.constraint_lower.size());
+        for (auto i = 0; i < num_constraints; ++i)
+        {
+            if (v_resident_solver->constraint_lower[i] != p_data.constraint_lower[i] || v_resident_solver->constraint_upper[i] != p_data.constraint_upper[i])
+            {
+                indices.push_back(i);
+                lower_bounds.push_back(p_data.constraint_lower[i]);
+                upper_bounds.push_back(p_data.constraint_upper[i]);
+            }
+        }
+        if (!indices.empty())
+            solver->set_constraint_bounds(indices, lower_bounds, upper_bounds);
+
+        store_resident_data(v_resident_solver, p_data);
+    }
+}
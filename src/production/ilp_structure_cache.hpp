@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ilp_solver_impl.hpp"
+#include "ilp_solver_interface.hpp"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ilp_solver
+{
+    struct ILPData;
+
+
+    static constexpr std::size_t c_default_structure_cache_capacity{ 16 };
+
+
+    // A solver that already contains a model of some structure, together with the data that may differ
+    // between models of the same structure. Thus, only the differences need to be transferred for the next model.
+    // The structure itself is kept as well, so that a model whose fingerprint merely collides is not mistaken for it.
+    struct ResidentSolver
+    {
+        std::unique_ptr<ILPSolverInterface> solver;
+
+        std::vector<std::vector<double>> matrix;
+        std::vector<VariableType>        variable_type;
+
+        std::vector<double> objective;
+        std::vector<double> variable_lower;
+        std::vector<double> variable_upper;
+        std::vector<double> constraint_lower;
+        std::vector<double> constraint_upper;
+    };
+
+
+    // Solvers of different factories (e.g. CBC and SCIP, or differently configured ones) must not be exchanged.
+    // Thus, a solver is found by the structure fingerprint of its model (see ilp_fingerprint.hpp) and the factory that created it.
+    struct StructureKey
+    {
+        const void*   backend_id;
+        std::uint64_t fingerprint;
+
+        bool operator==(const StructureKey& p_other) const
+        {
+            return backend_id == p_other.backend_id && fingerprint == p_other.fingerprint;
+        }
+    };
+
+
+    // Thread-safe cache of solvers, keyed by StructureKey.
+    // Keeps the p_capacity most recently released solvers.
+    // A solver is removed from the cache while it is in use, so that no two threads use the same solver.
+    class ILPStructureCache
+    {
+        public:
+            explicit ILPStructureCache(std::size_t p_capacity = c_default_structure_cache_capacity);
+
+            // Returns a solver for p_key and removes it from the cache, if there is one.
+            std::optional<ResidentSolver> acquire(const StructureKey& p_key);
+            void                          release(const StructureKey& p_key, ResidentSolver p_resident_solver);
+
+            // Destroys the least recently released solvers if p_capacity is smaller than before.
+            void configure(std::size_t p_capacity);
+
+            long long num_hits  () const;
+            long long num_misses() const;
+
+        private:
+            using Entry = std::pair<StructureKey, ResidentSolver>;
+
+            mutable std::mutex d_mutex;
+
+            std::size_t d_capacity;
+
+            // Most recently released entries first.
+            std::list<Entry> d_entries;
+
+            long long d_num_hits  { 0 };
+            long long d_num_misses{ 0 };
+
+            // Returns the entries that do not fit into the capacity, so that they can be destroyed outside of the lock.
+            std::list<Entry> shrink_to_capacity();
+    };
+
+
+    // The cache shared by all solvers created via create_solver_structure_cache.
+    std::shared_ptr<ILPStructureCache> default_structure_cache();
+
+
+    // Stores the structure, the bounds and the objective of p_data as those of the model in the solver.
+    void store_resident_data (ResidentSolver* v_resident_solver, const ILPData& p_data);
+
+    // Guards against fingerprint collisions: compares matrix and variable types with those of the model in the solver.
+    bool has_same_structure  (const ResidentSolver& p_resident_solver, const ILPData& p_data);
+
+    // Transfers all bounds and objective coefficients that differ from those of the previous model,
+    // each kind in one batch, and stores them.
+    void update_resident_data(ResidentSolver* v_resident_solver, const ILPData& p_data);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ilp_solver_interface.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ilp_solver
+{
+    inline bool is_neg_inf(double p_bound) { return p_bound < c_neg_inf_bound; }
+    inline bool is_pos_inf(double p_bound) { return p_bound > c_pos_inf_bound; }
+
+
+    // Presolve and bound propagation only declare a model infeasible if a bound is violated by more than
+    // feasibility_tolerance of the bound. The tolerance is relative, since the rounding errors of large bounds are.
+    // It also serves as absolute tolerance for rounding integer bounds.
+    constexpr double c_feasibility_tolerance{ 1e-6 };
+
+    inline double feasibility_tolerance(double p_bound)
+    {
+        return c_feasibility_tolerance * std::max(1., std::abs(p_bound));
+    }
+}
@@ -1,13 +1,21 @@
 #include "ilp_data.hpp"
+#include "ilp_model_delta.hpp"
+#include "ilp_shared_incumbent.hpp"
 #include "ilp_solver_factory.hpp"
 #include "ilp_solver_interface.hpp"
 #include "shared_memory_communication.hpp"
 #include "solver_exit_code.hpp"
 
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
-#include <windows.h>    // for SetErrorMode
+#include <windows.h>    // for SetErrorMode, OpenProcess etc.
 
 using namespace ilp_solver;
 
@@ -16,6 +24,12 @@ class SolverException : public std::exception {};
 
 using ilp_solver::ILPSolverInterface;
 
+// As often as the stub polls the incumbent slot.
+static constexpr double c_progress_interval_seconds{ 0.05 };
+
+// How often a waiting session checks whether the stub is still running.
+static constexpr int c_parent_check_milliseconds{ 1000 };
+
 
 static void add_variables(ILPSolverInterface* v_solver, const ILPData& p_data)
 {
@@ -58,6 +72,40 @@ static void generate_ilp(ILPSolverInterface* v_solver, const ILPData& p_data)
 }
 
 
+// The variables and constraints of the delta are appended in the same way as in generate_ilp.
+static void apply_model_delta(ILPSolverInterface* v_solver, const ModelDelta& p_delta)
+{
+    const auto num_new_variables   = (int) p_delta.new_variable_type.size();
+    const auto num_new_constraints = (int) p_delta.new_constraint_lower.size();
+    if (v_solver->get_num_variables()   + num_new_variables   != p_delta.num_variables ||
+        v_solver->get_num_constraints() + num_new_constraints != p_delta.num_constraints)
+        throw ModelException();
+
+    v_solver->set_variable_bounds      (p_delta.variable_indices,   p_delta.variable_lower,   p_delta.variable_upper);
+    v_solver->set_objective_coefficient(p_delta.objective_indices,  p_delta.objective);
+    v_solver->set_constraint_bounds    (p_delta.constraint_indices, p_delta.constraint_lower, p_delta.constraint_upper);
+    v_solver->set_coefficient          (p_delta.coefficient_rows,   p_delta.coefficient_columns, p_delta.coefficients);
+
+    for (auto j = 0; j < num_new_variables; ++j)
+    {
+        const auto& rows      = p_delta.new_variable_rows[j];
+        const auto& values    = p_delta.new_variable_values[j];
+        const auto  objective = p_delta.new_variable_objective[j];
+        const auto  lower     = p_delta.new_variable_lower[j];
+        const auto  upper     = p_delta.new_variable_upper[j];
+
+        if (p_delta.new_variable_type[j] == VariableType::INTEGER)
+            v_solver->add_variable_integer(rows, values, objective, lower, upper);
+        else
+            v_solver->add_variable_continuous(rows, values, objective, lower, upper);
+    }
+
+    for (auto i = 0; i < num_new_constraints; ++i)
+        v_solver->add_constraint(p_delta.new_constraint_columns[i], p_delta.new_constraint_values[i],
+                                 p_delta.new_constraint_lower[i], p_delta.new_constraint_upper[i]);
+}
+
+
 static void set_solver_preparation_parameters(ILPSolverInterface* v_solver, const ILPData& p_data)
 {
     if (!p_data.start_solution.empty())
@@ -89,6 +137,59 @@ static void solve_ilp(ILPSolverInterface* v_solver, ObjectiveSense p_objective_s
 }
 
 
+// Exchanges the incumbent of the solver (if any) with the stub and passes interrupt requests of the stub on
+// to the solver on a separate thread, as long as it exists.
+class StubExchange
+{
+    public:
+        StubExchange(IncumbentSlot* v_slot, ILPSolverInterface* v_solver, std::shared_ptr<SharedIncumbent> p_incumbent)
+            : d_slot(v_slot), d_solver(v_solver), d_incumbent(std::move(p_incumbent)), d_thread([this]() { run(); })
+        {}
+
+        ~StubExchange()
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_stop = true;
+            }
+            d_stop_condition.notify_all();
+            d_thread.join();
+        }
+
+        StubExchange(const StubExchange&) = delete;
+        StubExchange& operator= (const StubExchange&) = delete;
+
+    private:
+        static constexpr std::chrono::milliseconds c_exchange_interval{ 50 };
+
+        IncumbentSlot*                   d_slot;
+        ILPSolverInterface*              d_solver;
+        std::shared_ptr<SharedIncumbent> d_incumbent;
+        std::mutex                       d_mutex;
+        std::condition_variable          d_stop_condition;
+        bool                             d_stop{ false };
+        std::thread                      d_thread;
+
+        // Sharing is only an optimization, so a failure just stops it.
+        // The interrupt is repeated at every exchange, since a solve that is just starting may miss it.
+        void run()
+        {
+            try
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                while (!d_stop_condition.wait_for(lock, c_exchange_interval, [this]() { return d_stop; }))
+                {
+                    if (d_incumbent)
+                        d_slot->exchange(d_incumbent.get());
+                    if (d_slot->interrupt_requested())
+                        d_solver->interrupt();
+                }
+            }
+            catch (...) {}
+        }
+};
+
+
 static ILPSolutionData solution_data(const ILPSolverInterface& p_solver)
 {
     ILPSolutionData solution_data;
@@ -101,51 +202,107 @@ static ILPSolutionData solution_data(const ILPSolverInterface& p_solver)
 }
 
 
-// Throws ModelException, SolverException or std::bad_alloc
-static ILPSolutionData solve_ilp(const ILPData& p_data)
+struct SolverDeleter
 {
-    auto solver = ilp_solver::create_solver_cbc();
+    void operator()(ILPSolverInterface* p_solver) const { ilp_solver::destroy_solver(p_solver); }
+};
 
+using SolverPointer = std::unique_ptr<ILPSolverInterface, SolverDeleter>;
 
-    // RAII for deleting solver
-    struct SolverDeleter
+
+// Throws ModelException or std::bad_alloc
+static SolverPointer create_solver(const ILPData& p_data)
+{
+    SolverPointer solver(ilp_solver::create_solver_cbc());
+    try
     {
-        explicit SolverDeleter(ILPSolverInterface* p_solver) : solver(p_solver) {}
-        ~SolverDeleter()                                               { ilp_solver::destroy_solver(solver); }
+        generate_ilp(solver.get(), p_data);
+    }
+    catch (const std::bad_alloc&) { throw; }
+    catch (...)                   { throw ModelException(); }
+    return solver;
+}
+
+
+// Throws ModelException or std::bad_alloc
+static void update_solver(ILPSolverInterface* v_solver, const ModelDelta& p_delta)
+{
+    try
+    {
+        apply_model_delta(v_solver, p_delta);
+    }
+    catch (const std::bad_alloc&) { throw; }
+    catch (...)                   { throw ModelException(); }
+}
 
-        ILPSolverInterface* solver;
-    } solver_deleter(solver);
 
+// The solver may have solved before, so everything of the previous solve is replaced.
+// Throws ModelException, SolverException or std::bad_alloc
+static ILPSolutionData solve_ilp(ILPSolverInterface* v_solver, const ILPData& p_settings, IncumbentSlot* v_incumbent_slot)
+{
     try
     {
-        generate_ilp(solver, p_data);
-        set_solver_preparation_parameters(solver, p_data);
-        set_solver_parameters(solver, p_data);
+        set_solver_preparation_parameters(v_solver, p_settings);
+        set_solver_parameters(v_solver, p_settings);
     }
     catch (const std::bad_alloc&) { throw; }
     catch (...)                   { throw ModelException(); }
 
+    std::shared_ptr<SharedIncumbent> incumbent;
+    if (v_incumbent_slot->enabled())
+        incumbent = std::make_shared<SharedIncumbent>(p_settings.objective_sense);
+    if (auto* solver_impl = dynamic_cast<ILPSolverImpl*>(v_solver))
+        solver_impl->set_shared_incumbent(incumbent);
+
+    ProgressCallback report_progress;
+    if (v_incumbent_slot->enabled())
+    {
+        // For the callbacks of the stub, which also passes a request to stop on as an interrupt.
+        report_progress = [v_incumbent_slot](const ProgressEvent& p_event)
+        {
+            v_incumbent_slot->write_progress(p_event.objective, p_event.best_bound, p_event.num_nodes);
+            return ProgressAction::CONTINUE;
+        };
+    }
+    v_solver->set_progress_callback(report_progress, c_progress_interval_seconds);
+
     try
     {
-        solve_ilp(solver, p_data.objective_sense);
+        const StubExchange stub_exchange(v_incumbent_slot, v_solver, incumbent);
+        solve_ilp(v_solver, p_settings.objective_sense);
 
-        return solution_data(*solver);
+        return solution_data(*v_solver);
     }
     catch (const std::bad_alloc&) { throw; }
     catch (...)                   { throw SolverException(); }
 }
 
 
-static SolverExitCode solve_ilp(const std::string& p_shared_memory_name)
+// p_handoff_name is either the name of a shared memory segment or a file (see CommunicationParent::write_ilp_data).
+// A model replaces the model of v_solver, a model delta is applied to it.
+static SolverExitCode solve_ilp(SessionRequest p_request, const std::string& p_handoff_name, SolverPointer* v_solver)
 {
     try
     {
         ILPData data;
 
-        CommunicationChild communicator(p_shared_memory_name);
-        communicator.read_ilp_data(&data);
+        CommunicationChild communicator(p_handoff_name);
+        if (p_request == SessionRequest::solve_model)
+        {
+            communicator.read_ilp_data(&data);
+            v_solver->reset();
+            *v_solver = create_solver(data);
+        }
+        else
+        {
+            ModelDelta delta;
+            communicator.read_model_delta(&delta, &data);
+            if (!*v_solver)
+                throw ModelException();
+            update_solver(v_solver->get(), delta);
+        }
 
-        auto solution_data = solve_ilp(data);
+        auto solution_data = solve_ilp(v_solver->get(), data, &communicator.incumbent_slot());
 
         communicator.write_solution_data(solution_data);
 
@@ -158,13 +315,69 @@ static SolverExitCode solve_ilp(const std::string& p_shared_memory_name)
 }
 
 
+static SolverExitCode solve_ilp(const std::string& p_handoff_name)
+{
+    SolverPointer solver;
+    return solve_ilp(SessionRequest::solve_model, p_handoff_name, &solver);
+}
+
+
+// Solves the requests of the stub one after the other and keeps the model in between (see ILPSolverStub).
+// Quits when asked to, after a failed request, or when the stub has terminated without asking.
+static SolverExitCode run_session(const std::string& p_session_name)
+{
+    try
+    {
+        SessionChild session(p_session_name);
+
+        const auto parent = OpenProcess(SYNCHRONIZE, false, static_cast<DWORD>(session.parent_process_id()));
+        struct HandleCloser
+        {
+            explicit HandleCloser(HANDLE p_handle) : handle(p_handle) {}
+            ~HandleCloser()                                          { if (handle) CloseHandle(handle); }
+
+            HANDLE handle;
+        } handle_closer(parent);
+
+        SolverPointer solver;
+        while (true)
+        {
+            while (!session.wait_for_request(c_parent_check_milliseconds))
+            {
+                if (parent && WaitForSingleObject(parent, 0) == WAIT_OBJECT_0)
+                    return SolverExitCode::ok;
+            }
+
+            const auto request = session.request();
+            if (request == SessionRequest::quit)
+                return SolverExitCode::ok;
+
+            const auto exit_code = solve_ilp(request, session.handoff_name(), &solver);
+            session.respond(exit_code);
+            if (exit_code != SolverExitCode::ok)
+                return exit_code;
+        }
+    }
+    catch (const std::bad_alloc&)   { return SolverExitCode::out_of_memory;       }
+    catch (...)                     { return SolverExitCode::shared_memory_error; }
+}
+
+
+static bool starts_with(const std::string& p_string, const std::string& p_prefix)
+{
+    return p_string.compare(0, p_prefix.size(), p_prefix) == 0;
+}
+
+
 SolverExitCode my_main (int argc, wchar_t* argv[])
 {
     SetErrorMode(SEM_FAILCRITICALERRORS | SEM_NOGPFAULTERRORBOX);
     if (argc != 2)
         return SolverExitCode::command_line_error;
-    const auto shared_memory_name = std::wstring(argv[1]);
-    return solve_ilp(utf16_to_utf8(shared_memory_name));
+    const auto argument = utf16_to_utf8(std::wstring(argv[1]));
+    if (starts_with(argument, c_session_prefix))
+        return run_session(argument.substr(std::strlen(c_session_prefix)));
+    return solve_ilp(argument);
 }
 
 
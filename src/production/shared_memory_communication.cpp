@@ -2,12 +2,21 @@
 
 #include "serialization.hpp"
 
+#include <atomic>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>    // for get_current_process_id
 #include <codecvt>      // for std::codecvt_utf8_utf16
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <new>
 
 
 using namespace boost::interprocess;
 
 constexpr auto c_shared_memory_base_name = "ScaiIlpSolver";
+constexpr auto c_session_base_name = "ScaiIlpSolverSession";
 constexpr auto c_num_shared_memory_name_trials = 10000;
 
 namespace ilp_solver
@@ -34,16 +43,17 @@ namespace ilp_solver
     /**********************************
     * (De-) Serialization of ILP data *
     **********************************/
-    static void* serialize_ilp_data(Serializer* v_serializer, const ILPData& p_data, const ILPSolutionData& p_solution_data)
+    // The matrix comes first, so that everything else can be rewritten without touching it.
+    static void serialize_matrix(Serializer* v_serializer, const ILPData& p_data)
     {
-        *v_serializer << p_data.matrix
-                      << p_data.objective
-                      << p_data.variable_lower
-                      << p_data.variable_upper
-                      << p_data.constraint_lower
-                      << p_data.constraint_upper
-                      << p_data.variable_type
-                      << p_data.objective_sense
+        *v_serializer << p_data.matrix;
+    }
+
+
+    // Everything that is not part of the model, see ModelDelta.
+    static void serialize_settings(Serializer* v_serializer, const ILPData& p_data)
+    {
+        *v_serializer << p_data.objective_sense
                       << p_data.start_solution
                       << p_data.num_threads
                       << p_data.deterministic
@@ -54,25 +64,12 @@ namespace ilp_solver
                       << p_data.max_solutions
                       << p_data.max_abs_gap
                       << p_data.max_rel_gap;
-
-        auto result_address = v_serializer->current_address();
-
-        serialize_result(v_serializer, p_solution_data);
-
-        return result_address;
     }
 
 
-    static void* deserialize_ilp_data(Deserializer* v_deserializer, ILPData* r_data)
+    static void deserialize_settings(Deserializer* v_deserializer, ILPData* r_data)
     {
-        *v_deserializer >> r_data->matrix
-                        >> r_data->objective
-                        >> r_data->variable_lower
-                        >> r_data->variable_upper
-                        >> r_data->constraint_lower
-                        >> r_data->constraint_upper
-                        >> r_data->variable_type
-                        >> r_data->objective_sense
+        *v_deserializer >> r_data->objective_sense
                         >> r_data->start_solution
                         >> r_data->num_threads
                         >> r_data->deterministic
@@ -83,44 +80,335 @@ namespace ilp_solver
                         >> r_data->max_solutions
                         >> r_data->max_abs_gap
                         >> r_data->max_rel_gap;
+    }
+
+
+    static void serialize_vectors_and_parameters(Serializer* v_serializer, const ILPData& p_data)
+    {
+        *v_serializer << p_data.objective
+                      << p_data.variable_lower
+                      << p_data.variable_upper
+                      << p_data.constraint_lower
+                      << p_data.constraint_upper
+                      << p_data.variable_type;
+        serialize_settings(v_serializer, p_data);
+    }
+
+
+    static void serialize_model(Serializer* v_serializer, const ILPData& p_data)
+    {
+        serialize_matrix(v_serializer, p_data);
+        serialize_vectors_and_parameters(v_serializer, p_data);
+    }
+
+
+    static void* deserialize_ilp_data(Deserializer* v_deserializer, ILPData* r_data)
+    {
+        *v_deserializer >> r_data->matrix
+                        >> r_data->objective
+                        >> r_data->variable_lower
+                        >> r_data->variable_upper
+                        >> r_data->constraint_lower
+                        >> r_data->constraint_upper
+                        >> r_data->variable_type;
+        deserialize_settings(v_deserializer, r_data);
 
         return v_deserializer->current_address();
     }
 
 
-    // To reserve space for the solution in the shared memory
-    static ILPSolutionData dummy_solution(const ILPData& p_data)
+    /*************************************
+    * (De-) Serialization of model delta *
+    *************************************/
+    static void serialize_model_delta(Serializer* v_serializer, const ModelDelta& p_delta, const ILPData& p_data)
+    {
+        *v_serializer << p_delta.num_variables
+                      << p_delta.num_constraints
+                      << p_delta.variable_indices
+                      << p_delta.variable_lower
+                      << p_delta.variable_upper
+                      << p_delta.objective_indices
+                      << p_delta.objective
+                      << p_delta.constraint_indices
+                      << p_delta.constraint_lower
+                      << p_delta.constraint_upper
+                      << p_delta.coefficient_rows
+                      << p_delta.coefficient_columns
+                      << p_delta.coefficients
+                      << p_delta.new_variable_type
+                      << p_delta.new_variable_objective
+                      << p_delta.new_variable_lower
+                      << p_delta.new_variable_upper
+                      << p_delta.new_variable_rows
+                      << p_delta.new_variable_values
+                      << p_delta.new_constraint_lower
+                      << p_delta.new_constraint_upper
+                      << p_delta.new_constraint_columns
+                      << p_delta.new_constraint_values;
+        serialize_settings(v_serializer, p_data);
+    }
+
+
+    static void* deserialize_model_delta(Deserializer* v_deserializer, ModelDelta* r_delta, ILPData* r_settings)
+    {
+        *v_deserializer >> r_delta->num_variables
+                        >> r_delta->num_constraints
+                        >> r_delta->variable_indices
+                        >> r_delta->variable_lower
+                        >> r_delta->variable_upper
+                        >> r_delta->objective_indices
+                        >> r_delta->objective
+                        >> r_delta->constraint_indices
+                        >> r_delta->constraint_lower
+                        >> r_delta->constraint_upper
+                        >> r_delta->coefficient_rows
+                        >> r_delta->coefficient_columns
+                        >> r_delta->coefficients
+                        >> r_delta->new_variable_type
+                        >> r_delta->new_variable_objective
+                        >> r_delta->new_variable_lower
+                        >> r_delta->new_variable_upper
+                        >> r_delta->new_variable_rows
+                        >> r_delta->new_variable_values
+                        >> r_delta->new_constraint_lower
+                        >> r_delta->new_constraint_upper
+                        >> r_delta->new_constraint_columns
+                        >> r_delta->new_constraint_values;
+        deserialize_settings(v_deserializer, r_settings);
+
+        return v_deserializer->current_address();
+    }
+
+
+    static int num_variables(const ILPData& p_data)
+    {
+        return static_cast<int>(p_data.variable_type.size());
+    }
+
+
+    static size_t determine_model_size(const ILPData& p_data)
+    {
+        Serializer serializer(nullptr);
+        serialize_model(&serializer, p_data);
+        return serializer.required_bytes();
+    }
+
+
+    static size_t determine_matrix_size(const ILPData& p_data)
     {
-        ILPSolutionData dummy_solution_data(p_data.objective_sense);
-        dummy_solution_data.solution.resize(p_data.variable_type.size());
-        return dummy_solution_data;
+        Serializer serializer(nullptr);
+        serialize_matrix(&serializer, p_data);
+        return serializer.required_bytes();
     }
 
 
-    static size_t determine_required_size(const ILPData& p_data)
+    // The space reserved for the solution in the shared memory
+    static size_t determine_result_size(int p_num_variables)
     {
+        ILPSolutionData dummy_solution_data;
+        dummy_solution_data.solution.resize(p_num_variables);
+
         Serializer serializer(nullptr);
-        serialize_ilp_data(&serializer, p_data, dummy_solution(p_data));
+        serialize_result(&serializer, dummy_solution_data);
         return serializer.required_bytes();
     }
 
 
-    static void* serialize_ilp_data(void* p_address, const ILPData& p_data)
+    // The result is followed by the incumbent slot at the next multiple of its alignment.
+    // Since regions are mapped at page boundaries, this offset is the same in both processes.
+    static size_t determine_result_region_size(int p_num_variables)
     {
-        Serializer serializer(p_address);
-        return serialize_ilp_data(&serializer, p_data, ILPSolutionData(p_data.objective_sense));
+        return determine_result_size(p_num_variables) + IncumbentSlot::c_incumbent_slot_alignment
+             + IncumbentSlot::required_bytes(p_num_variables);
+    }
+
+
+    static void* incumbent_slot_address(void* p_result_address, size_t p_result_size)
+    {
+        constexpr auto alignment = IncumbentSlot::c_incumbent_slot_alignment;
+        const auto end_of_result = reinterpret_cast<std::uintptr_t>(p_result_address) + p_result_size;
+        return reinterpret_cast<void*>((end_of_result + alignment - 1) / alignment * alignment);
+    }
+
+
+    /********************************
+    * File handoff for large models *
+    ********************************/
+    // Offsets of mapped regions must be multiples of the page size (allocation granularity on Windows).
+    // The result region starts at the first such offset behind the model.
+    static size_t round_up_to_page_size(size_t p_size)
+    {
+        const auto page_size = mapped_region::get_page_size();
+        return (p_size + page_size - 1) / page_size * page_size;
+    }
+
+
+    static std::filesystem::path determine_free_file_name()
+    {
+        static std::atomic<int> s_num_files{ 0 };
+        const auto directory  = std::filesystem::temp_directory_path();
+        const auto process_id = std::to_string(ipcdetail::get_current_process_id());
+        for (auto trial = 1; trial <= c_num_shared_memory_name_trials; ++trial)
+        {
+            const auto file_name = directory / (c_shared_memory_base_name + process_id + "_" + std::to_string(++s_num_files) + ".ilp");
+            if (!std::filesystem::exists(file_name))
+                return file_name;
+        }
+        throw std::exception("Could not find a free file name for the ILP data.");
+    }
+
+
+    static void create_file(const std::filesystem::path& p_file_name, size_t p_size)
+    {
+        {
+            std::ofstream file(p_file_name, std::ios_base::binary | std::ios_base::trunc);
+            if (!file)
+                throw std::exception(("Could not create " + p_file_name.u8string() + ".").c_str());
+        }
+        std::filesystem::resize_file(p_file_name, p_size);
+    }
+
+
+    /*****************
+    * Incumbent slot *
+    *****************/
+    IncumbentSlot::IncumbentSlot(void* p_address, int p_num_variables)
+        : d_header(static_cast<Header*>(p_address)),
+          d_values(reinterpret_cast<std::atomic<double>*>(static_cast<char*>(p_address) + sizeof(Header))),
+          d_num_variables(p_num_variables)
+    { }
+
+
+    size_t IncumbentSlot::required_bytes(int p_num_variables)
+    {
+        return sizeof(Header) + p_num_variables * sizeof(std::atomic<double>);
+    }
+
+
+    // The atomics are constructed by the parent, the child uses them as they are.
+    void IncumbentSlot::reset(bool p_enabled)
+    {
+        new (d_header) Header{};
+        for (auto j = 0; j < d_num_variables; ++j)
+            new (d_values + j) std::atomic<double>(0.);
+        d_header->enabled.store(p_enabled ? 1 : 0, std::memory_order_release);
+
+        d_read_sequence       = 0;
+        d_written_version     = 0;
+        d_read_progress_count = 0;
+    }
+
+
+    bool IncumbentSlot::enabled() const
+    {
+        return d_header->enabled.load(std::memory_order_acquire) != 0;
+    }
+
+
+    void IncumbentSlot::exchange(SharedIncumbent* v_incumbent)
+    {
+        Incumbent incumbent;
+        if (read(&incumbent))
+            v_incumbent->publish(incumbent.solution, incumbent.objective);
+
+        // The incumbent just read is not better than the one in the slot, so it is not written back.
+        const auto version = v_incumbent->version();
+        if (version == d_written_version)
+            return;
+        const auto local = v_incumbent->get();
+        if (!local || static_cast<int>(local->solution.size()) != d_num_variables || write(*local, *v_incumbent))
+            d_written_version = version;
+    }
+
+
+    void IncumbentSlot::request_interrupt()
+    {
+        d_header->interrupt.store(1, std::memory_order_release);
+    }
+
+
+    bool IncumbentSlot::interrupt_requested() const
+    {
+        return d_header->interrupt.load(std::memory_order_acquire) != 0;
+    }
+
+
+    void IncumbentSlot::write_progress(double p_objective, double p_best_bound, long long p_num_nodes)
+    {
+        d_header->progress_objective.store(p_objective,  std::memory_order_relaxed);
+        d_header->best_bound        .store(p_best_bound, std::memory_order_relaxed);
+        d_header->num_nodes         .store(p_num_nodes,  std::memory_order_relaxed);
+        d_header->progress_count.fetch_add(1, std::memory_order_release);
+    }
+
+
+    bool IncumbentSlot::read_progress(double* r_objective, double* r_best_bound, long long* r_num_nodes)
+    {
+        const auto progress_count = d_header->progress_count.load(std::memory_order_acquire);
+        if (progress_count == d_read_progress_count)
+            return false;
+        d_read_progress_count = progress_count;
+
+        *r_objective  = d_header->progress_objective.load(std::memory_order_relaxed);
+        *r_best_bound = d_header->best_bound        .load(std::memory_order_relaxed);
+        *r_num_nodes  = d_header->num_nodes         .load(std::memory_order_relaxed);
+        return true;
+    }
+
+
+    bool IncumbentSlot::write(const Incumbent& p_incumbent, const SharedIncumbent& p_reference)
+    {
+        auto sequence = d_header->sequence.load(std::memory_order_acquire);
+        if (sequence % 2 == 1 || !d_header->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+            return false;
+
+        // Nothing has been changed, so readers need not notice.
+        if (sequence != 0 && !p_reference.is_better(p_incumbent.objective, d_header->objective.load(std::memory_order_relaxed)))
+        {
+            d_header->sequence.store(sequence, std::memory_order_release);
+            return true;
+        }
+
+        d_header->objective.store(p_incumbent.objective, std::memory_order_relaxed);
+        for (auto j = 0; j < d_num_variables; ++j)
+            d_values[j].store(p_incumbent.solution[j], std::memory_order_relaxed);
+        d_header->sequence.store(sequence + 2, std::memory_order_release);
+
+        // This process need not read its own incumbent.
+        d_read_sequence = sequence + 2;
+        return true;
+    }
+
+
+    bool IncumbentSlot::read(Incumbent* r_incumbent)
+    {
+        const auto sequence = d_header->sequence.load(std::memory_order_acquire);
+        if (sequence == d_read_sequence || sequence % 2 == 1)
+            return false;
+
+        r_incumbent->objective = d_header->objective.load(std::memory_order_relaxed);
+        r_incumbent->solution.resize(d_num_variables);
+        for (auto j = 0; j < d_num_variables; ++j)
+            r_incumbent->solution[j] = d_values[j].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (d_header->sequence.load(std::memory_order_relaxed) != sequence)
+            return false;
+
+        d_read_sequence = sequence;
+        return true;
     }
 
 
     /******************************
     * Communication of the parent *
     ******************************/
-    static windows_shared_memory* determine_free_shared_memory_name(size_t p_size, std::string* r_shared_memory_name)
+    static windows_shared_memory* determine_free_shared_memory_name(const std::string& p_base_name, size_t p_size, std::string* r_shared_memory_name)
     {
         windows_shared_memory* shared_memory = nullptr;
         for (auto trial = 1; trial <= c_num_shared_memory_name_trials; ++trial)
         {
-            *r_shared_memory_name = c_shared_memory_base_name + std::to_string(trial);
+            *r_shared_memory_name = p_base_name + std::to_string(trial);
             try
             {
                 shared_memory = new windows_shared_memory(create_only, r_shared_memory_name->c_str(), read_write, p_size);
@@ -136,9 +424,14 @@ namespace ilp_solver
     }
 
 
-    CommunicationParent::CommunicationParent()
-        : d_shared_memory(nullptr),
+    CommunicationParent::CommunicationParent(std::size_t p_max_shared_memory_bytes)
+        : d_max_shared_memory_bytes(p_max_shared_memory_bytes),
+          d_shared_memory(nullptr),
+          d_file_mapping(nullptr),
           d_mapped_region(nullptr),
+          d_matrix_size(0),
+          d_model_size(0),
+          d_result_size(0),
           d_address(nullptr),
           d_result_address(nullptr)
         {}
@@ -146,27 +439,148 @@ namespace ilp_solver
 
     CommunicationParent::~CommunicationParent()
     {
-        delete d_shared_memory;
+        release();
+    }
+
+
+    void CommunicationParent::release()
+    {
         delete d_mapped_region;
+        delete d_file_mapping;
+        delete d_shared_memory;
+        d_mapped_region = nullptr;
+        d_file_mapping  = nullptr;
+        d_shared_memory = nullptr;
+
+        if (!d_file_name.empty())
+        {
+            std::error_code ignored;
+            std::filesystem::remove(d_file_name, ignored);
+            d_file_name.clear();
+        }
+
+        d_handoff_name.clear();
+        d_address        = nullptr;
+        d_result_address = nullptr;
+        d_incumbent_slot.reset();
     }
 
 
     std::string CommunicationParent::create_shared_memory(size_t p_size)
     {
         std::string shared_memory_name;
-        d_shared_memory = determine_free_shared_memory_name(p_size, &shared_memory_name);
+        d_shared_memory = determine_free_shared_memory_name(c_shared_memory_base_name, p_size, &shared_memory_name);
         d_mapped_region = new mapped_region(*d_shared_memory, read_write);
         d_address = d_mapped_region->get_address();
         return shared_memory_name;
     }
 
 
-    std::string CommunicationParent::write_ilp_data(const ILPData& p_data)
+    std::string CommunicationParent::write_ilp_data(const ILPData& p_data, bool p_matrix_changed)
     {
-        const auto size = determine_required_size(p_data);
-        const auto shared_memory_name = create_shared_memory(size);
-        d_result_address = serialize_ilp_data(d_address, p_data);
-        return shared_memory_name;
+        const auto model_size  = determine_model_size(p_data);
+        const auto result_size = determine_result_size(num_variables(p_data));
+        if (!p_matrix_changed && !d_handoff_name.empty() && model_size == d_model_size && result_size == d_result_size)
+        {
+            rewrite_ilp_data(p_data);
+            return d_handoff_name;
+        }
+
+        release();
+        d_matrix_size = determine_matrix_size(p_data);
+        d_model_size  = model_size;
+        d_result_size = result_size;
+
+        const auto handoff_name = write_payload(model_size, [&p_data](Serializer* v_serializer) { serialize_model(v_serializer, p_data); }, p_data);
+
+        // Only set after everything has been written. Otherwise, the next call must not reuse the data.
+        d_handoff_name = handoff_name;
+        return d_handoff_name;
+    }
+
+
+    // The delta is not kept for a rewrite, so the next call of write_ilp_data writes the whole model anew.
+    std::string CommunicationParent::write_model_delta(const ModelDelta& p_delta, const ILPData& p_data)
+    {
+        release();
+
+        Serializer size_serializer(nullptr);
+        serialize_model_delta(&size_serializer, p_delta, p_data);
+
+        return write_payload(size_serializer.required_bytes(),
+                             [&p_delta, &p_data](Serializer* v_serializer) { serialize_model_delta(v_serializer, p_delta, p_data); }, p_data);
+    }
+
+
+    // Writes the payload (model or model delta), followed by the result region with the incumbent slot.
+    std::string CommunicationParent::write_payload(size_t p_payload_size, const std::function<void(Serializer*)>& p_serialize_payload, const ILPData& p_data)
+    {
+        const auto result_region_size = determine_result_region_size(num_variables(p_data));
+        std::string handoff_name;
+        if (p_payload_size + result_region_size > d_max_shared_memory_bytes)
+            handoff_name = write_payload_to_file(p_payload_size, p_serialize_payload, result_region_size);
+        else
+        {
+            handoff_name = create_shared_memory(p_payload_size + result_region_size);
+            Serializer serializer(d_address);
+            p_serialize_payload(&serializer);
+            d_result_address = serializer.current_address();
+        }
+
+        Serializer serializer(d_result_address);
+        serialize_result(&serializer, ILPSolutionData(p_data.objective_sense));
+
+        const auto result_size = determine_result_size(num_variables(p_data));
+        d_incumbent_slot = std::make_unique<IncumbentSlot>(incumbent_slot_address(d_result_address, result_size), num_variables(p_data));
+        d_incumbent_slot->reset(false);
+        return handoff_name;
+    }
+
+
+    // Everything behind the matrix has the same size as before, so it can be overwritten in place.
+    void CommunicationParent::rewrite_ilp_data(const ILPData& p_data)
+    {
+        if (d_file_mapping)
+        {
+            mapped_region vectors_region(*d_file_mapping, read_write, d_matrix_size, d_model_size - d_matrix_size);
+            Serializer serializer(vectors_region.get_address());
+            serialize_vectors_and_parameters(&serializer, p_data);
+        }
+        else
+        {
+            Serializer serializer(static_cast<char*>(d_address) + d_matrix_size);
+            serialize_vectors_and_parameters(&serializer, p_data);
+        }
+
+        Serializer serializer(d_result_address);
+        serialize_result(&serializer, ILPSolutionData(p_data.objective_sense));
+        d_incumbent_slot->reset(false);
+    }
+
+
+    // The file contains the payload, followed by the result region (including the incumbent slot) at the next page boundary.
+    // The parent only keeps the result region mapped, so the payload pages are not pinned in its address space
+    // and the child can page them in lazily.
+    std::string CommunicationParent::write_payload_to_file(size_t p_payload_size, const std::function<void(Serializer*)>& p_serialize_payload,
+                                                           size_t p_result_region_size)
+    {
+        const auto file_name     = determine_free_file_name();
+        const auto result_offset = round_up_to_page_size(p_payload_size);
+        d_file_name = file_name.string();
+        create_file(file_name, result_offset + p_result_region_size);
+
+        d_file_mapping = new file_mapping(d_file_name.c_str(), read_write);
+        {
+            mapped_region payload_region(*d_file_mapping, read_write, 0, p_payload_size);
+            Serializer serializer(payload_region.get_address());
+            p_serialize_payload(&serializer);
+        }
+
+        d_mapped_region  = new mapped_region(*d_file_mapping, read_write, result_offset, p_result_region_size);
+        d_address        = d_mapped_region->get_address();
+        d_result_address = d_address;
+
+        return c_file_handoff_prefix + file_name.u8string();
     }
 
 
@@ -177,21 +591,94 @@ namespace ilp_solver
     }
 
 
+    IncumbentSlot& CommunicationParent::incumbent_slot()
+    {
+        return *d_incumbent_slot;
+    }
+
+
     /*****************************
     * Communication of the child *
     *****************************/
-    CommunicationChild::CommunicationChild(const std::string& p_shared_memory_name)
-        : d_shared_memory(open_only, p_shared_memory_name.c_str(), read_write),
-          d_mapped_region(d_shared_memory, read_write),
-          d_address(d_mapped_region.get_address()),
+    static bool is_file_handoff(const std::string& p_handoff_name)
+    {
+        const std::string prefix{ c_file_handoff_prefix };
+        return p_handoff_name.compare(0, prefix.size(), prefix) == 0;
+    }
+
+
+    CommunicationChild::CommunicationChild(const std::string& p_handoff_name)
+        : d_shared_memory(nullptr),
+          d_file_mapping(nullptr),
+          d_mapped_region(nullptr),
+          d_result_region(nullptr),
+          d_address(nullptr),
           d_result_address(nullptr)
-        {}
+    {
+        try
+        {
+            if (is_file_handoff(p_handoff_name))
+            {
+                const auto file_name = std::filesystem::u8path(p_handoff_name.substr(std::strlen(c_file_handoff_prefix))).string();
+                d_file_mapping  = new file_mapping(file_name.c_str(), read_write);
+                // The model is mapped read-only. The result region is mapped separately in read_ilp_data.
+                d_mapped_region = new mapped_region(*d_file_mapping, read_only);
+            }
+            else
+            {
+                d_shared_memory = new windows_shared_memory(open_only, p_handoff_name.c_str(), read_write);
+                d_mapped_region = new mapped_region(*d_shared_memory, read_write);
+            }
+        }
+        catch (...)
+        {
+            delete d_file_mapping;
+            delete d_shared_memory;
+            throw;
+        }
+        d_address = d_mapped_region->get_address();
+    }
+
+
+    CommunicationChild::~CommunicationChild()
+    {
+        delete d_result_region;
+        delete d_mapped_region;
+        delete d_file_mapping;
+        delete d_shared_memory;
+    }
 
 
     void CommunicationChild::read_ilp_data(ILPData* r_data)
+    {
+        // Deserialized first, since the number of variables is only known afterwards.
+        Deserializer deserializer(d_address);
+        const auto result_address = deserialize_ilp_data(&deserializer, r_data);
+        map_result_region(result_address, num_variables(*r_data));
+    }
+
+
+    void CommunicationChild::read_model_delta(ModelDelta* r_delta, ILPData* r_settings)
     {
         Deserializer deserializer(d_address);
-        d_result_address = deserialize_ilp_data(&deserializer, r_data);
+        const auto result_address = deserialize_model_delta(&deserializer, r_delta, r_settings);
+        map_result_region(result_address, r_delta->num_variables);
+    }
+
+
+    // p_result_address is the end of the payload in the mapped region.
+    void CommunicationChild::map_result_region(void* p_result_address, int p_num_variables)
+    {
+        d_result_address = p_result_address;
+        if (d_file_mapping)
+        {
+            const auto payload_size = static_cast<size_t>(static_cast<char*>(d_result_address) - static_cast<char*>(d_address));
+            d_result_region  = new mapped_region(*d_file_mapping, read_write, round_up_to_page_size(payload_size));
+            d_result_address = d_result_region->get_address();
+        }
+
+        d_incumbent_slot = std::make_unique<IncumbentSlot>(incumbent_slot_address(d_result_address, determine_result_size(p_num_variables)),
+                                                           p_num_variables);
     }
 
 
@@ -202,6 +689,148 @@ namespace ilp_solver
     }
 
 
+    IncumbentSlot& CommunicationChild::incumbent_slot()
+    {
+        return *d_incumbent_slot;
+    }
+
+
+    /**********
+    * Session *
+    **********/
+    constexpr std::size_t c_max_handoff_name_bytes{ 1 << 15 };
+
+    // The semaphores order the accesses of both processes, so the members need not be atomic.
+    struct SessionHeader
+    {
+        std::uint64_t  parent_process_id;
+        SessionRequest request;
+        SolverExitCode exit_code;
+        char           handoff_name[c_max_handoff_name_bytes];
+    };
+
+
+    static std::string request_semaphore_name(const std::string& p_session_name)
+    {
+        return p_session_name + "Request";
+    }
+
+
+    static std::string response_semaphore_name(const std::string& p_session_name)
+    {
+        return p_session_name + "Response";
+    }
+
+
+    // Named semaphores may outlive a crashed process on some systems. Since the name of the session is free,
+    // such a semaphore is not used by anyone else.
+    static named_semaphore* create_semaphore(const std::string& p_name)
+    {
+        named_semaphore::remove(p_name.c_str());
+        return new named_semaphore(create_only, p_name.c_str(), 0);
+    }
+
+
+    static bool timed_wait(named_semaphore* v_semaphore, int p_milliseconds)
+    {
+        const auto timeout = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(p_milliseconds);
+        return v_semaphore->timed_wait(timeout);
+    }
+
+
+    SessionParent::SessionParent()
+    {
+        d_shared_memory.reset(determine_free_shared_memory_name(c_session_base_name, sizeof(SessionHeader), &d_name));
+        d_mapped_region = std::make_unique<mapped_region>(*d_shared_memory, read_write);
+        d_header = new (d_mapped_region->get_address()) SessionHeader{};
+        d_header->parent_process_id = static_cast<std::uint64_t>(ipcdetail::get_current_process_id());
+
+        d_request_semaphore .reset(create_semaphore(request_semaphore_name (d_name)));
+        d_response_semaphore.reset(create_semaphore(response_semaphore_name(d_name)));
+    }
+
+
+    SessionParent::~SessionParent()
+    {
+        d_request_semaphore .reset();
+        d_response_semaphore.reset();
+        named_semaphore::remove(request_semaphore_name (d_name).c_str());
+        named_semaphore::remove(response_semaphore_name(d_name).c_str());
+    }
+
+
+    const std::string& SessionParent::name() const
+    {
+        return d_name;
+    }
+
+
+    void SessionParent::post(SessionRequest p_request, const std::string& p_handoff_name)
+    {
+        if (p_handoff_name.size() >= c_max_handoff_name_bytes)
+            throw std::exception(("Handoff name too long: " + p_handoff_name).c_str());
+
+        d_header->request = p_request;
+        std::memcpy(d_header->handoff_name, p_handoff_name.c_str(), p_handoff_name.size() + 1);
+        d_request_semaphore->post();
+    }
+
+
+    bool SessionParent::wait_for_response(int p_milliseconds)
+    {
+        return timed_wait(d_response_semaphore.get(), p_milliseconds);
+    }
+
+
+    SolverExitCode SessionParent::exit_code() const
+    {
+        return d_header->exit_code;
+    }
+
+
+    SessionChild::SessionChild(const std::string& p_name)
+        : d_shared_memory(std::make_unique<windows_shared_memory>(open_only, p_name.c_str(), read_write)),
+          d_mapped_region(std::make_unique<mapped_region>(*d_shared_memory, read_write)),
+          d_request_semaphore (std::make_unique<named_semaphore>(open_only, request_semaphore_name (p_name).c_str())),
+          d_response_semaphore(std::make_unique<named_semaphore>(open_only, response_semaphore_name(p_name).c_str())),
+          d_header(static_cast<SessionHeader*>(d_mapped_region->get_address()))
+    { }
+
+
+    SessionChild::~SessionChild() = default;
+
+
+    std::uint64_t SessionChild::parent_process_id() const
+    {
+        return d_header->parent_process_id;
+    }
+
+
+    bool SessionChild::wait_for_request(int p_milliseconds)
+    {
+        return timed_wait(d_request_semaphore.get(), p_milliseconds);
+    }
+
+
+    SessionRequest SessionChild::request() const
+    {
+        return d_header->request;
+    }
+
+
+    std::string SessionChild::handoff_name() const
+    {
+        return std::string(d_header->handoff_name);
+    }
+
+
+    void SessionChild::respond(SolverExitCode p_exit_code)
+    {
+        d_header->exit_code = p_exit_code;
+        d_response_semaphore->post();
+    }
+
+
     /*********************************
     * Convert between UTF8 and UTF16 *
     *********************************/
@@ -1,53 +1,264 @@
 #pragma once
 
 #include "ilp_data.hpp"
+#include "ilp_model_delta.hpp"
+#include "ilp_shared_incumbent.hpp"
+#include "solver_exit_code.hpp"
 
+#include <atomic>
+#include <boost/interprocess/file_mapping.hpp>
 #include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/named_semaphore.hpp>
 #include <boost/interprocess/windows_shared_memory.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
 
+class Serializer;
+
 namespace ilp_solver
 {
+    // Models whose serialization is larger than this are not written to shared memory, but to a temporary file.
+    // By default, shared memory is always used.
+    constexpr std::size_t c_default_max_shared_memory_bytes{ std::numeric_limits<std::size_t>::max() };
+
+    // Prefix of the handoff name if the data has been written to a file instead of a shared memory segment.
+    constexpr auto c_file_handoff_prefix = "file:";
+
+    // Prefix of the command line argument of a solver process that solves requests of a session (see SessionParent).
+    constexpr auto c_session_prefix = "session:";
+
+
+    // Solution exchanged between the stub and the solver process while solving, see SharedIncumbent.
+    // It is located behind the result and written by both processes without locks:
+    // A writer makes the sequence number odd while writing. Readers skip the slot if the number is odd
+    // or has changed while they were reading, and try again at the next exchange.
+    // Thus, a process dying while writing only stops the exchange, it never blocks the other process.
+    // The slot also passes interrupt requests of the stub on to the solver process
+    // and the progress of the solver process back to the stub, for the callbacks of the stub.
+    class IncumbentSlot
+    {
+        public:
+            // p_address must be aligned to c_incumbent_slot_alignment.
+            IncumbentSlot(void* p_address, int p_num_variables);
+
+            static constexpr std::size_t c_incumbent_slot_alignment{ 64 };
+            static std::size_t required_bytes(int p_num_variables);
+
+            // Empties the slot. Called by the parent before every solve.
+            // The solver process only exchanges the incumbent and reports its progress if the slot is enabled.
+            void reset(bool p_enabled);
+            bool enabled() const;
+
+            // Writes a new incumbent of v_incumbent into the slot if it is better
+            // and publishes a new incumbent of the slot into v_incumbent.
+            void exchange(SharedIncumbent* v_incumbent);
+
+            // Set by the parent to ask the solver process to interrupt its solve, until the next reset.
+            void request_interrupt();
+            bool interrupt_requested() const;
+
+            // Written by the solver process, read by the parent. The values are written one by one,
+            // so a read may mix consecutive reports, which is good enough for progress.
+            // read_progress returns false if nothing has been written since the last read.
+            void write_progress(double p_objective, double p_best_bound, long long p_num_nodes);
+            bool read_progress (double* r_objective, double* r_best_bound, long long* r_num_nodes);
+
+        private:
+            struct Header
+            {
+                std::atomic<std::uint64_t> sequence;
+                std::atomic<std::uint32_t> enabled;
+                std::atomic<std::uint32_t> interrupt;
+                std::atomic<double>        objective;
+
+                std::atomic<std::uint64_t> progress_count;
+                std::atomic<double>        progress_objective;
+                std::atomic<double>        best_bound;
+                std::atomic<std::int64_t>  num_nodes;
+            };
+
+            // non-owned pointers; do not delete
+            Header*              d_header;
+            std::atomic<double>* d_values;
+            int                  d_num_variables;
+
+            // What this process has already exchanged.
+            std::uint64_t d_read_sequence      { 0 };
+            long long     d_written_version    { 0 };
+            std::uint64_t d_read_progress_count{ 0 };
+
+            // Returns false if another process is writing.
+            bool write(const Incumbent& p_incumbent, const SharedIncumbent& p_reference);
+            bool read (Incumbent* r_incumbent);
+    };
+
+
     class CommunicationParent
     {
         public:
-            CommunicationParent();
+            explicit CommunicationParent(std::size_t p_max_shared_memory_bytes = c_default_max_shared_memory_bytes);
             ~CommunicationParent();
 
-            // Returns the name of the shared memory segment the data has been written to
-            std::string write_ilp_data(const ILPData& p_data);
+            // copy constructor and assignment operator are not allowed (due to owned pointers)
+            CommunicationParent(const CommunicationParent&) = delete;
+            CommunicationParent& operator= (const CommunicationParent&) = delete;
+
+            // Returns the name of the shared memory segment the data has been written to,
+            // or c_file_handoff_prefix followed by the path of the file the data has been written to.
+            // If the matrix has not changed since the previous call and the data still needs the same number of bytes,
+            // the shared memory segment or file is reused and only the data behind the matrix is rewritten.
+            std::string write_ilp_data(const ILPData& p_data, bool p_matrix_changed = true);
+
+            // Like write_ilp_data, but only writes the changes of the model since a previous call (see ModelDelta),
+            // together with objective sense, start solution and parameters of p_data.
+            // For a solver process that has kept the previous model.
+            std::string write_model_delta(const ModelDelta& p_delta, const ILPData& p_data);
+
             void read_solution_data(ILPSolutionData* r_solution_data);
 
+            // Behind the result written by the last call of write_ilp_data or write_model_delta. Disabled by both.
+            IncumbentSlot& incumbent_slot();
+
         private:
+            std::size_t d_max_shared_memory_bytes;
+
             boost::interprocess::windows_shared_memory* d_shared_memory;
+            boost::interprocess::file_mapping* d_file_mapping;
             boost::interprocess::mapped_region* d_mapped_region;
+            std::string d_file_name;
+
+            // Describes the data written by the previous call of write_ilp_data.
+            std::string d_handoff_name;
+            size_t d_matrix_size;
+            size_t d_model_size;
+            size_t d_result_size;
 
             // non-owned pointer; do not delete
             void* d_address;
             void* d_result_address;
 
+            std::unique_ptr<IncumbentSlot> d_incumbent_slot;
+
+            void release();
             std::string create_shared_memory(size_t p_size);
+            std::string write_payload(size_t p_payload_size, const std::function<void(Serializer*)>& p_serialize_payload, const ILPData& p_data);
+            std::string write_payload_to_file(size_t p_payload_size, const std::function<void(Serializer*)>& p_serialize_payload, size_t p_result_region_size);
+            void rewrite_ilp_data(const ILPData& p_data);
     };
 
 
     class CommunicationChild
     {
         public:
-            explicit CommunicationChild(const std::string& p_shared_memory_name);
+            // Accepts the names returned by CommunicationParent::write_ilp_data.
+            explicit CommunicationChild(const std::string& p_handoff_name);
+            ~CommunicationChild();
+
+            // copy constructor and assignment operator are not allowed (due to owned pointers)
+            CommunicationChild(const CommunicationChild&) = delete;
+            CommunicationChild& operator= (const CommunicationChild&) = delete;
 
             void read_ilp_data(ILPData* r_data);
+
+            // Reads what CommunicationParent::write_model_delta has written.
+            // Only objective sense, start solution and parameters of r_settings are read, its model stays empty.
+            void read_model_delta(ModelDelta* r_delta, ILPData* r_settings);
+
             void write_solution_data(const ILPSolutionData& p_solution_data);
 
+            // Available after read_ilp_data or read_model_delta.
+            IncumbentSlot& incumbent_slot();
+
         private:
-            const boost::interprocess::windows_shared_memory d_shared_memory;
-            const boost::interprocess::mapped_region d_mapped_region;
+            boost::interprocess::windows_shared_memory* d_shared_memory;
+            boost::interprocess::file_mapping* d_file_mapping;
+            boost::interprocess::mapped_region* d_mapped_region;
+            boost::interprocess::mapped_region* d_result_region;
 
             // non-owned pointer; do not delete
-            void* const d_address;
+            void* d_address;
             void* d_result_address;
+
+            std::unique_ptr<IncumbentSlot> d_incumbent_slot;
+
+            void map_result_region(void* p_result_address, int p_num_variables);
+    };
+
+
+    enum class SessionRequest : std::uint32_t { solve_model, solve_model_delta, quit };
+
+    struct SessionHeader;
+
+
+    // Control block of a solver process that solves one request of the parent after the other
+    // and keeps its model in between (see ILPSolverStub). The parent posts a request together with the name
+    // returned by CommunicationParent::write_ilp_data or write_model_delta, and the child responds with its exit code.
+    // Both are signaled by named semaphores, so neither side polls.
+    class SessionParent
+    {
+        public:
+            SessionParent();
+            ~SessionParent();
+
+            // copy constructor and assignment operator are not allowed (due to owned pointers)
+            SessionParent(const SessionParent&) = delete;
+            SessionParent& operator= (const SessionParent&) = delete;
+
+            // To be passed to the child, preceded by c_session_prefix.
+            const std::string& name() const;
+
+            void post(SessionRequest p_request, const std::string& p_handoff_name = "");
+
+            // Returns false if the child has not responded within p_milliseconds.
+            bool wait_for_response(int p_milliseconds);
+            SolverExitCode exit_code() const;
+
+        private:
+            std::string d_name;
+
+            std::unique_ptr<boost::interprocess::windows_shared_memory> d_shared_memory;
+            std::unique_ptr<boost::interprocess::mapped_region>         d_mapped_region;
+            std::unique_ptr<boost::interprocess::named_semaphore>       d_request_semaphore;
+            std::unique_ptr<boost::interprocess::named_semaphore>       d_response_semaphore;
+
+            // non-owned pointer; do not delete
+            SessionHeader* d_header;
+    };
+
+
+    class SessionChild
+    {
+        public:
+            // Accepts the names returned by SessionParent::name.
+            explicit SessionChild(const std::string& p_name);
+            ~SessionChild();
+
+            // copy constructor and assignment operator are not allowed (due to owned pointers)
+            SessionChild(const SessionChild&) = delete;
+            SessionChild& operator= (const SessionChild&) = delete;
+
+            std::uint64_t parent_process_id() const;
+
+            // Returns false if the parent has not posted a request within p_milliseconds.
+            bool wait_for_request(int p_milliseconds);
+            SessionRequest request() const;
+            std::string handoff_name() const;
+
+            void respond(SolverExitCode p_exit_code);
+
+        private:
+            std::unique_ptr<boost::interprocess::windows_shared_memory> d_shared_memory;
+            std::unique_ptr<boost::interprocess::mapped_region>         d_mapped_region;
+            std::unique_ptr<boost::interprocess::named_semaphore>       d_request_semaphore;
+            std::unique_ptr<boost::interprocess::named_semaphore>       d_response_semaphore;
+
+            // non-owned pointer; do not delete
+            SessionHeader* d_header;
     };
 
 
@@ -3,10 +3,14 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <boost/test/unit_test.hpp>
 #include <filesystem>
 #include <iostream>
+#include <numeric>
+#include <stdexcept>
 #include <string_view>
+#include <vector>
 
 #define NOMINMAX
 #include <windows.h>    // for GetTickCount
@@ -391,6 +395,41 @@ namespace ilp_solver
     }
 
 
+    // The model of test_performance_big, but given column by column,
+    // i.e. every variable with its coefficients in the existing constraints.
+    void test_performance_big_columns(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_constraints{ 50 };
+        static constexpr int c_num_variables  { 50000 };
+        static constexpr double variable_scaling = 10.0;
+        static const double   constraint_scaling = c_num_variables * variable_scaling;
+        srand(3);
+
+        const auto start_time = GetTickCount();
+        for (auto i = 0; i < c_num_constraints; ++i)
+            p_solver->add_constraint(vector<int>(), vector<double>(), constraint_scaling*rand_double(), constraint_scaling*(1.0 + rand_double()));
+
+        std::vector<double> column_vector(c_num_constraints);
+        for (auto j = 0; j < c_num_variables; ++j)
+        {
+            std::generate(std::begin(column_vector), std::end(column_vector), []() { return rand_double(); });
+            p_solver->add_variable_integer(column_vector, rand_double(), variable_scaling*rand_double(), variable_scaling*(1.0 + rand_double()));
+        }
+        BOOST_REQUIRE_EQUAL( p_solver->get_num_constraints(), c_num_constraints );
+        BOOST_REQUIRE_EQUAL( p_solver->get_num_variables(),   c_num_variables );
+
+        const auto middle_time = GetTickCount();
+        p_solver->set_max_seconds(0.001);
+        p_solver->minimize();
+        const auto end_time = GetTickCount();
+
+        if (LOGGING)
+            cout << "Test for creating a big problem by columns took " << end_time - start_time << " ms.\n"
+                 << "\t" << middle_time - start_time << " for adding the constraints and variables.\n"
+                 << "\t" << end_time - middle_time   << " for finalizing the problem." << endl;
+    }
+
+
     void test_performance_zero(ILPSolverInterface* p_solver)
     {
         const auto start_time = GetTickCount();
@@ -407,6 +446,8 @@ namespace ilp_solver
             constraint[j]   = 1.;
             p_solver->add_constraint(constraint, -1., 1.);
         }
+        const auto build_time = GetTickCount();
+
         p_solver->minimize();
         const auto objective = p_solver->get_objective();
 
@@ -414,7 +455,9 @@ namespace ilp_solver
         BOOST_REQUIRE_CLOSE( objective, -1., c_eps );
 
         if (LOGGING)
-            cout << "Test for zero-pruning took " << end_time - start_time << " ms" << endl;
+            cout << "Test for zero-pruning took " << end_time - start_time << " ms.\n"
+                 << "\t" << build_time - start_time << " for building the model.\n"
+                 << "\t" << end_time - build_time   << " for solving." << endl;
     }
 
 
@@ -593,11 +636,1339 @@ namespace ilp_solver
     }
 
 
+    void test_solution_cache(ILPSolverInterface* p_solver)
+    {
+        // max x+y, 0 <= x, y <= 3, x+2y <= 4 integral
+        // The objective is unique to this test, so that the first solve can not be answered from the cache.
+        p_solver->add_variable_integer(1.25, 0, 3);
+        p_solver->add_variable_integer(1,    0, 3);
+
+        vector<double> values{1, 2};
+        p_solver->add_constraint_upper(values, 4);
+
+        long long hits_before, misses_before;
+        get_solution_cache_statistics(&hits_before, &misses_before);
+
+        p_solver->maximize();
+        const auto first_solution = p_solver->get_solution();
+
+        long long hits, misses;
+        get_solution_cache_statistics(&hits, &misses);
+        BOOST_REQUIRE_EQUAL(hits,   hits_before);
+        BOOST_REQUIRE_EQUAL(misses, misses_before + 1);
+
+        p_solver->reset_solution();
+        p_solver->maximize();
+        const auto second_solution = p_solver->get_solution();
+
+        get_solution_cache_statistics(&hits, &misses);
+        BOOST_REQUIRE_EQUAL(hits,   hits_before + 1);
+        BOOST_REQUIRE_EQUAL(misses, misses_before + 1);
+
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_EQUAL(second_solution.size(), 2u);
+        BOOST_REQUIRE_CLOSE(second_solution[0], first_solution[0], c_eps);
+        BOOST_REQUIRE_CLOSE(second_solution[1], first_solution[1], c_eps);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 3.75, c_eps);
+
+        // Another objective sense is another model.
+        p_solver->reset_solution();
+        p_solver->minimize();
+
+        get_solution_cache_statistics(&hits, &misses);
+        BOOST_REQUIRE_EQUAL(misses, misses_before + 2);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 0., c_eps);
+    }
+
+
+    static std::filesystem::path recreate_directory(const string& p_name)
+    {
+        const auto directory = std::filesystem::temp_directory_path() / p_name;
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+
+
+    static std::filesystem::path only_file(const std::filesystem::path& p_directory)
+    {
+        vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::directory_iterator(p_directory))
+            files.push_back(entry.path());
+        BOOST_REQUIRE_EQUAL(files.size(), 1u);
+        return files.front();
+    }
+
+
+    // A file in the cache directory that belongs to another model, e.g. a stale one, must not be taken as the solution.
+    void test_solution_cache_foreign_file(ILPSolverInterface* p_solver)
+    {
+        const auto foreign_directory = recreate_directory("ScaiIlpSolutionCacheForeign");
+        const auto directory         = recreate_directory("ScaiIlpSolutionCache");
+
+        // Without solutions in memory, every lookup reads the file.
+        // max 1.375x + y, x+y <= 3, 0 <= x, y <= 3 integral: (3, 0)
+        configure_solution_cache(0, foreign_directory.u8string().c_str());
+        auto* foreign_solver = create_solver_cache(create_solver_cbc);
+        foreign_solver->add_variable_integer(1.375, 0, 3);
+        foreign_solver->add_variable_integer(1,     0, 3);
+        foreign_solver->add_constraint_upper(vector<double>{1, 1}, 3);
+        foreign_solver->maximize();
+        destroy_solver(foreign_solver);
+
+        // max x + 1.125y, 2x+y <= 2, 0 <= x, y <= 3 integral: (0, 2)
+        configure_solution_cache(0, directory.u8string().c_str());
+        p_solver->add_variable_integer(1,     0, 3);
+        p_solver->add_variable_integer(1.125, 0, 3);
+        p_solver->add_constraint_upper(vector<double>{2, 1}, 2);
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 2.25, c_eps);
+
+        // The foreign solution has the right size, but violates the constraint.
+        const auto file = only_file(directory);
+        std::filesystem::copy_file(only_file(foreign_directory), file, std::filesystem::copy_options::overwrite_existing);
+
+        long long hits_before, misses_before;
+        get_solution_cache_statistics(&hits_before, &misses_before);
+
+        p_solver->reset_solution();
+        p_solver->maximize();
+
+        long long hits, misses;
+        get_solution_cache_statistics(&hits, &misses);
+        BOOST_REQUIRE_EQUAL(hits,   hits_before);
+        BOOST_REQUIRE_EQUAL(misses, misses_before + 1);
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 2.25, c_eps);
+
+        // The solve has replaced the foreign file.
+        p_solver->reset_solution();
+        p_solver->maximize();
+        get_solution_cache_statistics(&hits, &misses);
+        BOOST_REQUIRE_EQUAL(hits, hits_before + 1);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 2.25, c_eps);
+
+        // Back to the default: 1000 solutions in memory, no directory.
+        configure_solution_cache(1000, nullptr);
+        std::filesystem::remove_all(foreign_directory);
+        std::filesystem::remove_all(directory);
+    }
+
+
+    static void add_structure_cache_model(ILPSolverInterface* p_solver, double p_rhs, double p_upper_bound)
+    {
+        // max x+y, 0 <= x <= p_upper_bound, 0 <= y <= 10, x+2y <= p_rhs integral
+        p_solver->add_variable_integer(1.5, 0, p_upper_bound);
+        p_solver->add_variable_integer(1,   0, 10);
+
+        vector<double> values{1, 2};
+        p_solver->add_constraint_upper(values, p_rhs);
+    }
+
+
+    ILPSolverInterface* __stdcall create_cbc_feasibility_first();
+
+
+    void test_structure_cache(ILPSolverInterface* p_solver)
+    {
+        add_structure_cache_model(p_solver, 7, 3);
+
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 6.5, c_eps);
+
+        long long hits_before, misses_before;
+        get_structure_cache_statistics(&hits_before, &misses_before);
+
+        // A second model with the same structure, but different right-hand side and bounds, reuses the backend.
+        auto* second_solver = create_solver_structure_cache(create_solver_cbc);
+        auto second_test = [](ILPSolverInterface* p_second_solver)
+        {
+            add_structure_cache_model(p_second_solver, 9, 5);
+            p_second_solver->maximize();
+
+            const auto solution = p_second_solver->get_solution();
+            BOOST_REQUIRE(p_second_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+            BOOST_REQUIRE_CLOSE(solution[0], 5., c_eps);
+            BOOST_REQUIRE_CLOSE(solution[1], 2., c_eps);
+            BOOST_REQUIRE_CLOSE(p_second_solver->get_objective(), 9.5, c_eps);
+        };
+        execute_test_and_destroy_solver(second_solver, second_test);
+
+        long long hits, misses;
+        get_structure_cache_statistics(&hits, &misses);
+        BOOST_REQUIRE_EQUAL(hits,   hits_before + 1);
+        BOOST_REQUIRE_EQUAL(misses, misses_before);
+
+        // A solver with another backend factory must not get the backend of create_solver_cbc.
+        auto* other_backend_solver = create_solver_structure_cache(create_cbc_feasibility_first);
+        auto other_backend_test = [](ILPSolverInterface* p_other_backend_solver)
+        {
+            add_structure_cache_model(p_other_backend_solver, 9, 5);
+            p_other_backend_solver->maximize();
+            BOOST_REQUIRE_CLOSE(p_other_backend_solver->get_objective(), 9.5, c_eps);
+        };
+        execute_test_and_destroy_solver(other_backend_solver, other_backend_test);
+
+        get_structure_cache_statistics(&hits, &misses);
+        BOOST_REQUIRE_EQUAL(hits,   hits_before + 1);
+        BOOST_REQUIRE_EQUAL(misses, misses_before + 1);
+
+        // Re-solving the first model after the backend has been changed must give the original result.
+        p_solver->reset_solution();
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 6.5, c_eps);
+    }
+
+
+    void test_model_statistics(ILPSolverInterface* p_solver)
+    {
+        p_solver->add_variable_boolean   ( 1.);
+        p_solver->add_variable_integer   ( 0.,  0.,   10.);
+        p_solver->add_variable_continuous(-2.5, -5., 1000.);
+
+        p_solver->add_constraint_upper   (vector<double>{1, 2,     0}, 4);    // one-sided
+        p_solver->add_constraint_equality(vector<double>{0, 0.001, 3}, 1);    // equality
+        p_solver->add_constraint         (vector<double>{1, 1,     1}, 1, 5); // range
+
+        ModelStatistics statistics;
+        if (!get_model_statistics(p_solver, &statistics))
+            return; // The solver does not collect the model itself.
+
+        BOOST_REQUIRE_EQUAL(statistics.num_variables,            3);
+        BOOST_REQUIRE_EQUAL(statistics.num_constraints,          3);
+        BOOST_REQUIRE_EQUAL(statistics.num_binary_variables,     1);
+        BOOST_REQUIRE_EQUAL(statistics.num_integer_variables,    1);
+        BOOST_REQUIRE_EQUAL(statistics.num_continuous_variables, 1);
+        BOOST_REQUIRE_EQUAL(statistics.num_non_zeros,            7);
+
+        // All rows and columns have 2 or 3 non-zeros.
+        const auto expected_histogram = vector<int>{0, 0, 3};
+        BOOST_REQUIRE(statistics.row_non_zero_histogram    == expected_histogram);
+        BOOST_REQUIRE(statistics.column_non_zero_histogram == expected_histogram);
+
+        BOOST_REQUIRE_CLOSE(statistics.coefficient_range.min,    0.001, c_eps);
+        BOOST_REQUIRE_CLOSE(statistics.coefficient_range.max,    3.,    c_eps);
+        BOOST_REQUIRE_CLOSE(statistics.objective_range.min,      1.,    c_eps);
+        BOOST_REQUIRE_CLOSE(statistics.objective_range.max,      2.5,   c_eps);
+        BOOST_REQUIRE_CLOSE(statistics.variable_bound_range.min, 1.,    c_eps);
+        BOOST_REQUIRE_CLOSE(statistics.variable_bound_range.max, 1000., c_eps);
+        BOOST_REQUIRE_CLOSE(statistics.rhs_range.min,            1.,    c_eps);
+        BOOST_REQUIRE_CLOSE(statistics.rhs_range.max,            5.,    c_eps);
+
+        BOOST_REQUIRE_EQUAL(statistics.num_equality_constraints,  1);
+        BOOST_REQUIRE_EQUAL(statistics.num_range_constraints,     1);
+        BOOST_REQUIRE_EQUAL(statistics.num_one_sided_constraints, 1);
+        BOOST_REQUIRE_EQUAL(statistics.num_free_constraints,      0);
+    }
+
+
+    void test_check_solution(ILPSolverInterface* p_solver)
+    {
+        // max x0 + 2 x1
+        p_solver->add_variable_integer   (1., 0., 4.);
+        p_solver->add_variable_continuous(2., 0., 3.);
+        p_solver->add_constraint_upper(vector<double>{1, 1}, 5);
+
+        // Violates the constraint by 2.5, the bound of x0 by 0.5 and the integrality of x0 by 0.5.
+        ViolationReport report;
+        if (!check_solution(p_solver, vector<double>{4.5, 3.}, c_default_verification_tolerance, &report))
+            return; // The solver does not collect the model itself.
+
+        BOOST_REQUIRE(!report.feasible);
+        BOOST_REQUIRE_CLOSE(report.objective, 10.5, c_eps);
+        BOOST_REQUIRE_EQUAL(report.num_violated_constraints,   1);
+        BOOST_REQUIRE_CLOSE(report.max_constraint_violation,   2.5, c_eps);
+        BOOST_REQUIRE_EQUAL(report.max_violated_constraint,    0);
+        BOOST_REQUIRE_EQUAL(report.num_violated_bounds,        1);
+        BOOST_REQUIRE_CLOSE(report.max_bound_violation,        0.5, c_eps);
+        BOOST_REQUIRE_EQUAL(report.max_violated_bound,         0);
+        BOOST_REQUIRE_EQUAL(report.num_integrality_violations, 1);
+        BOOST_REQUIRE_CLOSE(report.max_integrality_violation,  0.5, c_eps);
+
+        p_solver->maximize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE(check_solution(p_solver, p_solver->get_solution(), c_default_verification_tolerance, &report));
+        BOOST_REQUIRE(report.feasible);
+        BOOST_REQUIRE_CLOSE(report.objective, p_solver->get_objective(), c_eps);
+    }
+
+
+    void test_modification(ILPSolverInterface* p_solver)
+    {
+        // max x0 + x1 + x2, 0 <= x <= 4 integral
+        for (auto j = 0; j < 3; ++j)
+            p_solver->add_variable_integer(1., 0., 4.);
+        p_solver->add_constraint_upper(vector<double>{1, 1, 0}, 5);
+        p_solver->add_constraint_upper(vector<double>{0, 1, 1}, 6);
+
+        p_solver->maximize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 9., c_eps);
+
+        // max x0 + x1 + 2 x2, x0 <= 2
+        p_solver->reset_solution();
+        p_solver->set_variable_bounds(0, 0., 2.);
+        p_solver->set_objective_coefficient(2, 2.);
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 12., c_eps);
+
+        // x0 + x1 + x2 <= 5, x1 + x2 <= 5
+        p_solver->reset_solution();
+        p_solver->set_coefficient(0, 2, 1.);
+        p_solver->set_constraint_bounds(1, c_neg_inf, 5.);
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 9., c_eps);
+
+        // max 3 x0 + x1 + x2, x0 <= 4, x0 + 2 x1 + x2 <= 6
+        p_solver->reset_solution();
+        p_solver->set_variable_bounds      (vector<int>{0, 1}, vector<double>{0, 0}, vector<double>{4, 4});
+        p_solver->set_objective_coefficient(vector<int>{0, 2}, vector<double>{3, 1});
+        p_solver->set_coefficient          (vector<int>{0, 1}, vector<int>{1, 1}, vector<double>{2, 1});
+        p_solver->set_constraint_bounds    (vector<int>{0},    vector<double>{c_neg_inf}, vector<double>{6});
+        p_solver->maximize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 14., c_eps);
+
+        // 1 <= x0 <= 3 and x0 + x1 + x2 without upper bound
+        p_solver->reset_solution();
+        p_solver->add_constraint(vector<double>{1, 0, 0}, 1., 3.);
+        p_solver->add_constraint(vector<double>{1, 1, 1}, c_neg_inf_bound, c_pos_inf);
+        BOOST_REQUIRE_EQUAL(p_solver->get_num_constraints(), 4);
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 12., c_eps);
+
+        // Changes the range and bounds the constraint without upper bound: 2 <= x0 <= 2.5, x0 + x1 + x2 <= 5
+        p_solver->reset_solution();
+        p_solver->set_constraint_bounds(2, 2., 2.5);
+        p_solver->set_constraint_bounds(3, c_neg_inf, 5.);
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 9., c_eps);
+
+        // Removes the range and turns an upper bound into one: 1 <= x1 + x2 <= 1.5
+        p_solver->reset_solution();
+        p_solver->set_constraint_bounds(2, c_neg_inf, c_pos_inf);
+        p_solver->set_constraint_bounds(1, 1., 1.5);
+        p_solver->maximize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 13., c_eps);
+
+        // Indices out of range and vectors of different sizes.
+        BOOST_REQUIRE_THROW(p_solver->set_variable_bounds(3, 0., 1.), std::exception);
+        BOOST_REQUIRE_THROW(p_solver->set_coefficient(4, 0, 1.), std::exception);
+        BOOST_REQUIRE_THROW(p_solver->set_objective_coefficient(vector<int>{0, 1}, vector<double>{1}), std::exception);
+    }
+
+
+    void test_deletion(ILPSolverInterface* p_solver)
+    {
+        // max x0 + x1 + x2 + x3, 0 <= x <= 4 integral
+        for (auto j = 0; j < 4; ++j)
+            p_solver->add_variable_integer(1., 0., 4.);
+        p_solver->add_constraint_upper(vector<double>{1, 1, 0, 0}, 3);
+        p_solver->add_constraint_upper(vector<double>{0, 1, 1, 0}, 2);
+        p_solver->add_constraint_upper(vector<double>{0, 0, 1, 1}, 5);
+        p_solver->add_constraint_upper(vector<double>{1, 0, 0, 1}, 1);
+
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 3., c_eps);
+
+        // x0 + x1 <= 3, x2 + x3 <= 5
+        const auto constraint_mapping = p_solver->delete_constraints(vector<int>{3, 1, 3});
+        BOOST_REQUIRE(constraint_mapping == (vector<int>{0, -1, 1, -1}));
+        BOOST_REQUIRE_EQUAL(p_solver->get_num_constraints(), 2);
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 8., c_eps);
+
+        // max x1 + x3, x1 <= 3
+        const auto variable_mapping = p_solver->delete_variables(vector<int>{0, 2});
+        BOOST_REQUIRE(variable_mapping == (vector<int>{-1, 0, -1, 1}));
+        BOOST_REQUIRE_EQUAL(p_solver->get_num_variables(), 2);
+        p_solver->maximize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 7., c_eps);
+        BOOST_REQUIRE_EQUAL(p_solver->get_solution().size(), 2u);
+
+        // The model can be extended with the new indices.
+        p_solver->add_constraint_upper(vector<double>{1, 1}, 4);
+        p_solver->maximize();
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 4., c_eps);
+
+        BOOST_REQUIRE(p_solver->delete_constraints(vector<int>{}) == (vector<int>{0, 1, 2}));
+        BOOST_REQUIRE_THROW(p_solver->delete_constraints(vector<int>{3}), std::exception);
+        BOOST_REQUIRE_THROW(p_solver->delete_variables(vector<int>{-1}), std::exception);
+    }
+
+
+    // Knapsack with 200 items and 10 capacity constraints, which takes long to prove optimal.
+    static void add_multidimensional_knapsack(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_items      { 200 };
+        static constexpr int c_num_constraints{ 10 };
+
+        srand(7);
+        for (auto j = 0; j < c_num_items; ++j)
+            p_solver->add_variable_boolean(1 + rand() % 100);
+
+        vector<double> weights(c_num_items);
+        for (auto i = 0; i < c_num_constraints; ++i)
+        {
+            std::generate(weights.begin(), weights.end(), []() { return 1 + rand() % 100; });
+            p_solver->add_constraint_upper(weights, std::accumulate(weights.begin(), weights.end(), 0.) / 4);
+        }
+    }
+
+
+    // Solves in the background, polls the solutions found so far and cancels the solve long before its time limit.
+    void test_async(ILPSolverInterface* p_solver)
+    {
+        static constexpr double c_max_seconds  { 60. };
+        static constexpr DWORD  c_max_poll_time{ 5000 };
+
+        add_multidimensional_knapsack(p_solver);
+        p_solver->set_max_seconds(c_max_seconds);
+
+        const auto start_time = GetTickCount();
+        auto* solve = solve_async(p_solver, true);
+        const auto start_duration = GetTickCount() - start_time;
+
+        vector<double> incumbent;
+        double         incumbent_objective{ 0. };
+        auto           has_incumbent      { false };
+        while (!has_incumbent && !wait_for_solve(solve, 0.01) && GetTickCount() - start_time < c_max_poll_time)
+            has_incumbent = get_solve_incumbent(solve, &incumbent, &incumbent_objective);
+
+        const auto cancel_time = GetTickCount();
+        cancel_solve(solve);
+        finish_solve(solve);
+        const auto cancel_duration = GetTickCount() - cancel_time;
+
+        BOOST_REQUIRE_LT(start_duration,  1000u);
+        BOOST_REQUIRE_LT(cancel_duration, 10000u);
+        BOOST_REQUIRE(p_solver->get_status() != SolutionStatus::PROVEN_INFEASIBLE);
+        if (has_incumbent)
+        {
+            BOOST_REQUIRE_EQUAL(incumbent.size(), 200u);
+            BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::SUBOPTIMAL || p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+            BOOST_REQUIRE_GE(p_solver->get_objective(), incumbent_objective - c_eps);
+        }
+
+        // Without cancelling, the solve ends at its time limit, and waiting for it accepts any duration.
+        p_solver->reset_solution();
+        p_solver->set_max_seconds(1.);
+        solve = solve_async(p_solver, true);
+        BOOST_REQUIRE(wait_for_solve(solve, c_default_max_seconds));
+        BOOST_REQUIRE(wait_for_solve(solve, 0.));
+        finish_solve(solve);
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::SUBOPTIMAL || p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+
+        if (LOGGING)
+            cout << "Test for solving asynchronously took " << start_duration << " ms to start and "
+                 << cancel_duration << " ms to cancel" << (has_incumbent ? " after the first solution." : ".") << endl;
+    }
+
+
+    // Follows the solutions and the progress of a solve via callbacks and stops it long before its time limit.
+    void test_callbacks(ILPSolverInterface* p_solver)
+    {
+        static constexpr double c_max_seconds     { 60. };
+        static constexpr double c_progress_seconds{ 0.01 };
+        static constexpr double c_stop_seconds    { 0.5 };
+
+        add_multidimensional_knapsack(p_solver);
+        p_solver->set_max_seconds(c_max_seconds);
+
+        vector<double> incumbent_objectives;
+        size_t         incumbent_size{ 0 };
+        auto           num_progress  { 0 };
+        auto           min_gap       { c_pos_inf };
+        p_solver->set_incumbent_callback([&](const IncumbentEvent& p_event)
+        {
+            incumbent_objectives.push_back(p_event.objective);
+            incumbent_size = static_cast<size_t>(p_event.num_variables);
+        });
+        p_solver->set_progress_callback([&](const ProgressEvent& p_event)
+        {
+            ++num_progress;
+            min_gap = std::min(min_gap, p_event.gap);
+            return (!incumbent_objectives.empty() && p_event.seconds >= c_stop_seconds) ? ProgressAction::STOP : ProgressAction::CONTINUE;
+        }, c_progress_seconds);
+
+        const auto start_time = GetTickCount();
+        p_solver->maximize();
+        const auto duration = GetTickCount() - start_time;
+
+        BOOST_REQUIRE_LT(duration, 30000u);
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::SUBOPTIMAL || p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_GE(num_progress, 1);
+        BOOST_REQUIRE_GE(min_gap, 0.);
+        BOOST_REQUIRE(!incumbent_objectives.empty());
+        BOOST_REQUIRE_EQUAL(incumbent_size, 200u);
+        BOOST_REQUIRE(std::is_sorted(incumbent_objectives.begin(), incumbent_objectives.end()));
+        BOOST_REQUIRE_GE(p_solver->get_objective(), incumbent_objectives.back() - c_eps);
+
+        // An exception thrown by a callback stops the solve and is rethrown by it.
+        p_solver->reset_solution();
+        p_solver->set_progress_callback(nullptr, c_progress_seconds);
+        p_solver->set_incumbent_callback([](const IncumbentEvent&) { throw std::runtime_error("Callback failed."); });
+        const auto throwing_start_time = GetTickCount();
+        BOOST_REQUIRE_THROW(p_solver->maximize(), std::runtime_error);
+        BOOST_REQUIRE_LT(GetTickCount() - throwing_start_time, 30000u);
+        p_solver->set_incumbent_callback(nullptr);
+
+        if (LOGGING)
+            cout << "Test for callbacks got " << incumbent_objectives.size() << " solutions and " << num_progress
+                 << " progress reports and stopped after " << duration << " ms." << endl;
+    }
+
+
+    // SCIP solves concurrently with several threads, but not while there are callbacks, which would not be called otherwise.
+    void test_callbacks_with_threads(ILPSolverInterface* p_solver)
+    {
+        p_solver->set_num_threads(4);
+        test_callbacks(p_solver);
+    }
+
+
+    void test_presolve_reductions(ILPSolverInterface* p_solver)
+    {
+        // min x0 + x1 + 2 x2 - x3
+        p_solver->add_variable_integer   ( 1, 2,  2); // fixed
+        p_solver->add_variable_integer   ( 1, 0, 10);
+        p_solver->add_variable_continuous( 2, 0,  5);
+        p_solver->add_variable_integer   (-1, 0,  4); // in no constraint
+
+        p_solver->add_constraint_lower(vector<double>{0, 1, 0, 0},  3);    // singleton: x1 >= 3
+        p_solver->add_constraint_lower(vector<double>{1, 1, 1, 0},  6);    // x0 + x1 + x2 >= 6
+        p_solver->add_constraint_lower(vector<double>{2, 2, 2, 0}, 10);    // duplicate, weaker than the previous one
+        p_solver->add_constraint      (vector<double>{0, 0, 0, 0}, -1, 1); // empty
+        p_solver->add_constraint_upper(vector<double>{0, 1, 1, 0}, 15);    // redundant: x1 + x2 <= 15
+
+        p_solver->minimize();
+
+        const auto solution = p_solver->get_solution();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_EQUAL(solution.size(), 4u);
+        BOOST_REQUIRE_CLOSE(solution[0], 2., c_eps);
+        BOOST_REQUIRE_CLOSE(solution[1], 4., c_eps);
+        BOOST_REQUIRE_SMALL(solution[2],     c_eps);
+        BOOST_REQUIRE_CLOSE(solution[3], 4., c_eps);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 2., c_eps);
+
+        // Infeasibility of an empty constraint is detected by presolve.
+        p_solver->add_constraint(vector<double>{0, 0, 0, 0}, 1, 2);
+        p_solver->minimize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_INFEASIBLE);
+        BOOST_REQUIRE(p_solver->get_solution().empty());
+    }
+
+
+    // Violations that are rounding errors relative to the bounds must not make presolve report infeasibility.
+    void test_presolve_tolerance(ILPSolverInterface* p_solver)
+    {
+        // min x0 + x1, x0 + x1 <= 10^6 is violated by 10^-8 at the lower bounds.
+        p_solver->add_variable_continuous(1, 500000.000000005, 600000);
+        p_solver->add_variable_continuous(1, 500000.000000005, 600000);
+        p_solver->add_constraint_upper(vector<double>{1, 1}, 1000000);
+
+        p_solver->minimize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 1000000., c_eps);
+
+        // A violation that is large relative to the bound is still detected.
+        p_solver->add_constraint_upper(vector<double>{1, 1}, 999990);
+        p_solver->minimize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_INFEASIBLE);
+    }
+
+
+    void test_bound_propagation(ILPSolverInterface* p_solver)
+    {
+        // max x0 + x1
+        p_solver->add_variable_integer(1, 0, 10);
+        p_solver->add_variable_integer(1, 0, 10);
+
+        p_solver->add_constraint_upper(vector<double>{1,  2}, 3); // implies x0 <= 3, x1 <= 1
+        p_solver->add_constraint_lower(vector<double>{1, -1}, 2); // implies x0 >= 2
+
+        p_solver->maximize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), 3., c_eps);
+
+        PresolveStatistics statistics;
+        BOOST_REQUIRE(get_presolve_statistics(p_solver, &statistics));
+        BOOST_REQUIRE_GE(statistics.propagation.num_tightened_bounds, 3);
+
+        // Only infeasible with the propagated bound x0 >= 2.
+        p_solver->add_constraint_upper(vector<double>{1, 1}, 1);
+        p_solver->maximize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_INFEASIBLE);
+    }
+
+
+    // A constraint that the bounds violate by less than the feasibility tolerance is not redundant.
+    void test_nearly_redundant_constraint(ILPSolverInterface* p_solver)
+    {
+        // max x0 + x1, x0 + x1 <= 10^6 is violated by 0.5 at the upper bounds.
+        p_solver->add_variable_continuous(1, 0, 500000.25);
+        p_solver->add_variable_continuous(1, 0, 500000.25);
+        p_solver->add_constraint_upper(vector<double>{1, 1}, 1000000);
+
+        p_solver->maximize();
+        const auto solution = p_solver->get_solution();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_EQUAL(solution.size(), 2u);
+        BOOST_REQUIRE_LE(solution[0] + solution[1], 1000000. + 1e-6);
+    }
+
+
+    // Independent knapsack problems, glued into one model.
+    static void generate_block_problem(ILPSolverInterface* p_solver, int p_num_blocks, int p_num_variables_per_block)
+    {
+        srand(5);
+        const auto num_variables = p_num_blocks * p_num_variables_per_block;
+        for (auto j = 0; j < num_variables; ++j)
+            p_solver->add_variable_boolean(1. + rand_double());
+
+        vector<int>    indices(p_num_variables_per_block);
+        vector<double> weights(p_num_variables_per_block);
+        for (auto block = 0; block < p_num_blocks; ++block)
+        {
+            for (auto k = 0; k < 2; ++k)
+            {
+                for (auto l = 0; l < p_num_variables_per_block; ++l)
+                {
+                    indices[l] = block * p_num_variables_per_block + l;
+                    weights[l] = 1. + rand_double();
+                }
+                p_solver->add_constraint_upper(indices, weights, 0.3 * p_num_variables_per_block);
+            }
+        }
+    }
+
+
+    void test_decomposition(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_blocks{ 8 };
+        static constexpr int c_num_variables_per_block{ 40 };
+
+        generate_block_problem(p_solver, c_num_blocks, c_num_variables_per_block);
+        p_solver->set_num_threads(1);
+
+        auto start_time = GetTickCount();
+        p_solver->maximize();
+        const auto sequential_time = GetTickCount() - start_time;
+
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        const auto sequential_objective = p_solver->get_objective();
+
+        p_solver->reset_solution();
+        p_solver->set_num_threads(c_num_blocks);
+
+        start_time = GetTickCount();
+        p_solver->maximize();
+        const auto parallel_time = GetTickCount() - start_time;
+
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), sequential_objective, c_eps);
+
+        // A constraint without non-zeros is only violated beyond the feasibility tolerance.
+        p_solver->add_constraint_lower(vector<int>(), vector<double>(), 1e-9);
+        p_solver->reset_solution();
+        p_solver->maximize();
+
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), sequential_objective, c_eps);
+
+        // The blocks must be solved like a single model.
+        auto* monolithic_solver = create_solver_cbc();
+        auto monolithic_test = [](ILPSolverInterface* p_monolithic_solver)
+        {
+            generate_block_problem(p_monolithic_solver, c_num_blocks, c_num_variables_per_block);
+            p_monolithic_solver->maximize();
+            BOOST_REQUIRE(p_monolithic_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        };
+        start_time = GetTickCount();
+        monolithic_test(monolithic_solver);
+        const auto monolithic_time = GetTickCount() - start_time;
+        BOOST_REQUIRE_CLOSE(monolithic_solver->get_objective(), sequential_objective, c_eps);
+        destroy_solver(monolithic_solver);
+
+        if (LOGGING)
+            cout << "Test for " << c_num_blocks << " independent blocks took\n"
+                 << "\t" << monolithic_time << " ms as a single model,\n"
+                 << "\t" << sequential_time << " ms decomposed with 1 thread,\n"
+                 << "\t" << parallel_time   << " ms decomposed with " << c_num_blocks << " threads." << endl;
+    }
+
+
+    // The sparse copy of the matrix that check_solution creates on its first call makes the further checks cheap.
+    void test_check_solution_overhead(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_blocks{ 8 };
+        static constexpr int c_num_variables_per_block{ 40 };
+        static constexpr int c_num_checks{ 1000 };
+
+        generate_block_problem(p_solver, c_num_blocks, c_num_variables_per_block);
+
+        auto start_time = GetTickCount();
+        p_solver->maximize();
+        const auto solve_time = GetTickCount() - start_time;
+
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        const auto solution = p_solver->get_solution();
+
+        ViolationReport report;
+        start_time = GetTickCount();
+        for (auto k = 0; k < c_num_checks; ++k)
+            BOOST_REQUIRE(check_solution(p_solver, solution, c_default_verification_tolerance, &report));
+        const auto check_time = GetTickCount() - start_time;
+
+        BOOST_REQUIRE(report.feasible);
+        BOOST_REQUIRE_CLOSE(report.objective, p_solver->get_objective(), c_eps);
+
+        if (LOGGING)
+            cout << "Solving " << c_num_blocks << " independent blocks took " << solve_time << " ms, "
+                 << c_num_checks << " checks of the solution took " << check_time << " ms." << endl;
+    }
+
+
+    // Rows and continuous columns have magnitudes between 1e-4 and 1e6.
+    static void generate_badly_scaled_problem(ILPSolverInterface* p_solver, int p_num_continuous, int p_num_integer, int p_num_constraints)
+    {
+        srand(7);
+        auto rand_magnitude = [](int p_min_exponent, int p_max_exponent)
+            { return std::pow(10., p_min_exponent + rand() % (p_max_exponent - p_min_exponent + 1)); };
+
+        vector<double> column_magnitude(p_num_continuous + p_num_integer, 1.);
+        for (auto j = 0; j < p_num_continuous; ++j)
+        {
+            column_magnitude[j] = rand_magnitude(-4, 3);
+            p_solver->add_variable_continuous(column_magnitude[j] * (1. + rand_double()), 0., 10. / column_magnitude[j]);
+        }
+        for (auto j = 0; j < p_num_integer; ++j)
+            p_solver->add_variable_integer(1. + rand_double(), 0., 10.);
+
+        vector<double> row(p_num_continuous + p_num_integer);
+        for (auto i = 0; i < p_num_constraints; ++i)
+        {
+            const auto row_magnitude = rand_magnitude(-2, 3);
+            for (auto j = 0; j < static_cast<int>(row.size()); ++j)
+                row[j] = (rand() % 3 == 0) ? row_magnitude * column_magnitude[j] * (1. + rand_double()) : 0.;
+            p_solver->add_constraint_upper(row, row_magnitude * 0.2 * row.size());
+        }
+    }
+
+
+    void test_badly_scaled(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_continuous { 150 };
+        static constexpr int c_num_integer    {  50 };
+        static constexpr int c_num_constraints{ 100 };
+
+        generate_badly_scaled_problem(p_solver, c_num_continuous, c_num_integer, c_num_constraints);
+        auto start_time = GetTickCount();
+        p_solver->maximize();
+        const auto scaled_time = GetTickCount() - start_time;
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+
+        auto* unscaled_solver = create_solver_cbc();
+        auto unscaled_test = [](ILPSolverInterface* p_unscaled_solver)
+        {
+            generate_badly_scaled_problem(p_unscaled_solver, c_num_continuous, c_num_integer, c_num_constraints);
+            p_unscaled_solver->maximize();
+            BOOST_REQUIRE(p_unscaled_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        };
+        start_time = GetTickCount();
+        unscaled_test(unscaled_solver);
+        const auto unscaled_time = GetTickCount() - start_time;
+
+        // Both solves are subject to numerical tolerances, which differ with the scaling.
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), unscaled_solver->get_objective(), 0.01);
+        destroy_solver(unscaled_solver);
+
+        if (LOGGING)
+            cout << "Test for badly scaled model took\n"
+                 << "\t" << unscaled_time << " ms without scaling,\n"
+                 << "\t" << scaled_time   << " ms with scaling." << endl;
+    }
+
+
+    // Solves a few models with every CBC profile. All profiles must find the same optimum.
+    void test_cbc_profiles(ILPSolverInterface* p_solver)
+    {
+        using ModelGenerator = void(*)(ILPSolverInterface*);
+        constexpr std::array<std::pair<ModelGenerator, std::string_view>, 3> models
+        { std::pair{[](ILPSolverInterface* p_model) { generate_block_problem(p_model, 1, 60); },             "knapsack"}
+        , std::pair{[](ILPSolverInterface* p_model) { generate_block_problem(p_model, 4, 25); },             "block"}
+        , std::pair{[](ILPSolverInterface* p_model) { generate_badly_scaled_problem(p_model, 30, 20, 20); }, "mixed"}
+        };
+        constexpr std::array<std::pair<CbcProfile, std::string_view>, 4> profiles
+        { std::pair{CbcProfile::DEFAULT,           "default"}
+        , std::pair{CbcProfile::AGGRESSIVE_CUTS,   "aggressive cuts"}
+        , std::pair{CbcProfile::FEASIBILITY_FIRST, "feasibility first"}
+        , std::pair{CbcProfile::PLAIN,             "plain"}
+        };
+
+        int num_nodes;
+        BOOST_REQUIRE(!get_cbc_num_nodes(nullptr, &num_nodes));
+        BOOST_REQUIRE(get_cbc_num_nodes(p_solver, &num_nodes));
+        BOOST_REQUIRE_EQUAL(num_nodes, 0);
+
+        for (const auto& [generate_model, model_name] : models)
+        {
+            if (LOGGING)
+                cout << "CBC profiles on the " << model_name << " model:\n";
+
+            // Every profile must reach the optimum of plain branch and bound, which has been used before the profiles.
+            auto* reference_solver = create_solver_cbc_profile(CbcProfile::PLAIN);
+            generate_model(reference_solver);
+            reference_solver->maximize();
+            BOOST_REQUIRE(reference_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+            const auto expected_objective = reference_solver->get_objective();
+            destroy_solver(reference_solver);
+
+            for (const auto& [profile, profile_name] : profiles)
+            {
+                auto* solver = create_solver_cbc_profile(profile);
+                generate_model(solver);
+
+                const auto start_time = GetTickCount();
+                solver->maximize();
+                const auto solve_time = GetTickCount() - start_time;
+
+                BOOST_REQUIRE(solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+                BOOST_REQUIRE_CLOSE(solver->get_objective(), expected_objective, c_eps);
+                BOOST_REQUIRE(get_cbc_num_nodes(solver, &num_nodes));
+                destroy_solver(solver);
+
+                if (LOGGING)
+                    cout << "\t" << profile_name << ": " << num_nodes << " nodes, " << solve_time << " ms" << endl;
+            }
+        }
+    }
+
+
+    // Re-solves a model after each of a sequence of added constraints, with and without warm start.
+    void test_cbc_warm_start(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_continuous   { 200 };
+        static constexpr int c_num_integer      {  10 };
+        static constexpr int c_num_constraints  { 100 };
+        static constexpr int c_num_perturbations{  20 };
+
+        struct WarmStartMode
+        {
+            bool             keep_root_basis;
+            bool             reset_branch_and_bound_only;
+            std::string_view name;
+        };
+        constexpr std::array<WarmStartMode, 3> modes
+        { WarmStartMode{false, false, "cold"}
+        , WarmStartMode{false, true,  "branch and bound reset"}
+        , WarmStartMode{true,  true,  "root basis"}
+        };
+
+        BOOST_REQUIRE(!set_cbc_warm_start(nullptr, true, true));
+
+        vector<double> objectives;
+        for (const auto& mode : modes)
+        {
+            auto* solver = (&mode == &modes.front()) ? p_solver : create_solver_cbc();
+            BOOST_REQUIRE(set_cbc_warm_start(solver, mode.keep_root_basis, mode.reset_branch_and_bound_only));
+            generate_badly_scaled_problem(solver, c_num_continuous, c_num_integer, c_num_constraints);
+            solver->maximize();
+
+            // The same perturbations for every mode. All variables have a lower bound of 0, thus the model stays feasible.
+            srand(11);
+            vector<double> row(c_num_continuous + c_num_integer);
+            const auto start_time = GetTickCount();
+            for (auto k = 0; k < c_num_perturbations; ++k)
+            {
+                std::generate(std::begin(row), std::end(row), []() { return 0.5 + rand_double(); });
+                solver->add_constraint_upper(row, 0.05 * row.size());
+
+                solver->reset_solution();
+                solver->maximize();
+                BOOST_REQUIRE(solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+
+                if (&mode == &modes.front())
+                    objectives.push_back(solver->get_objective());
+                else
+                    BOOST_REQUIRE_CLOSE(solver->get_objective(), objectives[k], c_eps);
+            }
+            const auto solve_time = GetTickCount() - start_time;
+
+            if (solver != p_solver)
+                destroy_solver(solver);
+
+            if (LOGGING)
+                cout << "Test for " << c_num_perturbations << " re-solves (" << mode.name << ") took " << solve_time << " ms" << endl;
+        }
+    }
+
+
+    // Re-solves a model after each of a sequence of objective changes, with and without reoptimization.
+    void test_scip_reoptimization(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_continuous   { 200 };
+        static constexpr int c_num_integer      {  10 };
+        static constexpr int c_num_constraints  { 100 };
+        static constexpr int c_num_perturbations{  20 };
+
+        BOOST_REQUIRE(!set_scip_reoptimization(nullptr, true));
+
+        vector<double> objectives;
+        for (const auto reoptimize : {false, true})
+        {
+            auto* solver = reoptimize ? create_solver_scip() : p_solver;
+            BOOST_REQUIRE(set_scip_reoptimization(solver, reoptimize));
+            generate_badly_scaled_problem(solver, c_num_continuous, c_num_integer, c_num_constraints);
+            solver->maximize();
+
+            // The same objectives for every mode. All variables are bounded, thus the model stays bounded.
+            srand(13);
+            vector<int>    indices(c_num_continuous + c_num_integer);
+            vector<double> objective(indices.size());
+            std::iota(std::begin(indices), std::end(indices), 0);
+            const auto start_time = GetTickCount();
+            for (auto k = 0; k < c_num_perturbations; ++k)
+            {
+                std::generate(std::begin(objective), std::end(objective), []() { return rand_double(); });
+                solver->set_objective_coefficient(indices, objective);
+
+                solver->reset_solution();
+                solver->maximize();
+                BOOST_REQUIRE(solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+
+                if (!reoptimize)
+                    objectives.push_back(solver->get_objective());
+                else
+                    BOOST_REQUIRE_CLOSE(solver->get_objective(), objectives[k], c_eps);
+            }
+            const auto solve_time = GetTickCount() - start_time;
+
+            if (solver != p_solver)
+                destroy_solver(solver);
+
+            if (LOGGING)
+                cout << "Test for " << c_num_perturbations << " re-solves (" << (reoptimize ? "reoptimization" : "free transform") << ") took " << solve_time << " ms" << endl;
+        }
+    }
+
+
+    // Re-solves a model after a solve stopped by its time limit, with and without reoptimization.
+    void test_scip_reoptimization_after_limit(ILPSolverInterface* p_solver)
+    {
+        static constexpr double c_max_seconds{ 0.5 };
+        static constexpr int    c_num_free   { 20 };
+
+        vector<double> objectives;
+        for (const auto reoptimize : {false, true})
+        {
+            auto* solver = reoptimize ? create_solver_scip() : p_solver;
+            BOOST_REQUIRE(set_scip_reoptimization(solver, reoptimize));
+            add_multidimensional_knapsack(solver);
+            solver->set_max_seconds(c_max_seconds);
+            solver->maximize();
+            BOOST_REQUIRE(solver->get_status() == SolutionStatus::SUBOPTIMAL || solver->get_status() == SolutionStatus::NO_SOLUTION);
+
+            // Only the first items remain, which is solved quickly.
+            const auto num_items = solver->get_num_variables();
+            vector<int> indices(num_items - c_num_free);
+            std::iota(std::begin(indices), std::end(indices), c_num_free);
+            solver->reset_solution();
+            solver->set_max_seconds(c_default_max_seconds);
+            solver->set_variable_bounds(indices, vector<double>(indices.size(), 0.), vector<double>(indices.size(), 0.));
+            solver->set_objective_coefficient(0, 1000.);
+            solver->maximize();
+            BOOST_REQUIRE(solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+            objectives.push_back(solver->get_objective());
+
+            if (solver != p_solver)
+                destroy_solver(solver);
+        }
+        BOOST_REQUIRE_CLOSE(objectives[0], objectives[1], c_eps);
+    }
+
+
+    // Solves the same model with an increasing number of threads, which SCIP uses for a concurrent solve.
+    void test_scip_concurrent(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_continuous { 150 };
+        static constexpr int c_num_integer    {  50 };
+        static constexpr int c_num_constraints{ 100 };
+
+        double objective{ 0. };
+        for (const auto num_threads : {1, 2, 4, 8, 16})
+        {
+            auto* solver = (num_threads == 1) ? p_solver : create_solver_scip();
+            solver->set_num_threads(num_threads);
+            generate_badly_scaled_problem(solver, c_num_continuous, c_num_integer, c_num_constraints);
+
+            const auto start_time = GetTickCount();
+            solver->maximize();
+            const auto solve_time = GetTickCount() - start_time;
+            BOOST_REQUIRE(solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+
+            if (num_threads == 1)
+                objective = solver->get_objective();
+            else
+                BOOST_REQUIRE_CLOSE(solver->get_objective(), objective, c_eps);
+
+            if (solver != p_solver)
+                destroy_solver(solver);
+
+            if (LOGGING)
+                cout << "Test for solving with " << num_threads << " threads took " << solve_time << " ms" << endl;
+        }
+    }
+
+
+    // Creates, uses and destroys many solvers for small models, with and without the pool of SCIP environments.
+    void test_scip_pool(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_solvers{ 20 };
+
+        auto solve_small_model = [](ILPSolverInterface* p_small_solver)
+        {
+            BOOST_REQUIRE_EQUAL(p_small_solver->get_num_variables(),   0);
+            BOOST_REQUIRE_EQUAL(p_small_solver->get_num_constraints(), 0);
+            p_small_solver->add_variable_integer(1., 0., 10.);
+            p_small_solver->add_variable_integer(1., 0., 10.);
+            p_small_solver->add_constraint_upper({1., 2.}, 4.);
+            p_small_solver->add_constraint_upper({2., 1.}, 4.);
+            p_small_solver->maximize();
+            BOOST_REQUIRE(p_small_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+            BOOST_REQUIRE_CLOSE(p_small_solver->get_objective(), 2., c_eps);
+        };
+        solve_small_model(p_solver);
+
+        auto start_time = GetTickCount();
+        for (auto k = 0; k < c_num_solvers; ++k)
+        {
+            auto* solver = create_solver_scip();
+            solve_small_model(solver);
+            destroy_solver(solver);
+        }
+        const auto unpooled_time = GetTickCount() - start_time;
+
+        warm_up_scip_pool(1);
+        start_time = GetTickCount();
+        for (auto k = 0; k < c_num_solvers; ++k)
+        {
+            auto* solver = create_solver_scip_pooled();
+            solve_small_model(solver);
+            destroy_solver(solver);
+        }
+        const auto pooled_time = GetTickCount() - start_time;
+
+        long long num_created{ 0 };
+        long long num_reused { 0 };
+        double creation_seconds{ 0. };
+        double reset_seconds   { 0. };
+        BOOST_REQUIRE(get_scip_pool_statistics(&num_created, &num_reused, &creation_seconds, &reset_seconds));
+        BOOST_REQUIRE_GE(num_reused, c_num_solvers);
+
+        if (LOGGING)
+            cout << "Test for " << c_num_solvers << " small models took " << unpooled_time << " ms without and "
+                 << pooled_time << " ms with the pool.\n"
+                 << "\t" << num_created << " environments created in " << creation_seconds << " s, "
+                 << num_reused << " reused after resetting in " << reset_seconds << " s." << endl;
+    }
+
+
+    // Solves a badly scaled model, on which the backends of the portfolio differ, and reports the winner.
+    void test_portfolio(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_continuous { 150 };
+        static constexpr int c_num_integer    {  50 };
+        static constexpr int c_num_constraints{ 100 };
+
+        auto* cbc_solver = create_solver_cbc();
+        int winner{ -1 };
+        BOOST_REQUIRE(!get_portfolio_winner(cbc_solver, &winner));
+        generate_badly_scaled_problem(cbc_solver, c_num_continuous, c_num_integer, c_num_constraints);
+        cbc_solver->maximize();
+        BOOST_REQUIRE(cbc_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+
+        generate_badly_scaled_problem(p_solver, c_num_continuous, c_num_integer, c_num_constraints);
+        const auto start_time = GetTickCount();
+        p_solver->maximize();
+        const auto solve_time = GetTickCount() - start_time;
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+        BOOST_REQUIRE_CLOSE(p_solver->get_objective(), cbc_solver->get_objective(), c_eps);
+        destroy_solver(cbc_solver);
+
+        BOOST_REQUIRE(get_portfolio_winner(p_solver, &winner));
+        BOOST_REQUIRE_GE(winner, 0);
+
+        if (LOGGING)
+            cout << "Test for the portfolio took " << solve_time << " ms, won by backend " << winner << endl;
+    }
+
+
+    ILPSolverInterface* __stdcall create_portfolio_stub();
+
+
+    // Solves the same model with and without sharing the incumbent between the backends of a portfolio,
+    // once with threads only and once with a backend in a separate process.
+    void test_portfolio_incumbent_sharing(ILPSolverInterface* p_solver)
+    {
+        static constexpr int c_num_continuous { 150 };
+        static constexpr int c_num_integer    {  50 };
+        static constexpr int c_num_constraints{ 100 };
+
+        auto* stub_solver = create_portfolio_stub();
+        for (auto* solver: { p_solver, stub_solver })
+        {
+            std::array<double, 2>        objective;
+            std::array<unsigned long, 2> solve_time;
+            for (auto share: { false, true })
+            {
+                BOOST_REQUIRE(set_portfolio_incumbent_sharing(solver, share));
+                solver->reset_solution();
+                if (!share)
+                    generate_badly_scaled_problem(solver, c_num_continuous, c_num_integer, c_num_constraints);
+
+                const auto start_time = GetTickCount();
+                solver->maximize();
+                solve_time[share] = GetTickCount() - start_time;
+                BOOST_REQUIRE(solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+                objective[share] = solver->get_objective();
+            }
+            BOOST_REQUIRE_CLOSE(objective[true], objective[false], c_eps);
+
+            if (LOGGING)
+                cout << "Test for the portfolio " << ((solver == stub_solver) ? "with a stub " : "")
+                     << "took " << solve_time[false] << " ms without and " << solve_time[true] << " ms with sharing the incumbent." << endl;
+        }
+        destroy_solver(stub_solver);
+
+        auto* cbc_solver = create_solver_cbc();
+        BOOST_REQUIRE(!set_portfolio_incumbent_sharing(cbc_solver, true));
+        destroy_solver(cbc_solver);
+    }
+
+
+    // Knapsack with 12 items. The instance is determined by p_seed, so that it can be generated again.
+    static void add_knapsack_model(ILPSolverInterface* p_solver, int p_seed)
+    {
+        static constexpr int c_num_items{ 12 };
+
+        srand(p_seed);
+        vector<double> weights(c_num_items);
+        for (auto& weight: weights)
+        {
+            weight = 1 + rand() % 20;
+            p_solver->add_variable_boolean(1 + rand() % 20);
+        }
+        p_solver->add_constraint_upper(weights, std::accumulate(weights.begin(), weights.end(), 0.) / 2);
+    }
+
+
+    // Assignment of 4 workers to 4 jobs. The instance is determined by p_seed, so that it can be generated again.
+    static void add_assignment_model(ILPSolverInterface* p_solver, int p_seed)
+    {
+        static constexpr int c_size{ 4 };
+
+        srand(p_seed);
+        for (auto j = 0; j < c_size * c_size; ++j)
+            p_solver->add_variable_boolean(1 + rand() % 20);
+
+        vector<int> indices(c_size);
+        const vector<double> ones(c_size, 1.);
+        for (auto i = 0; i < c_size; ++i)
+        {
+            std::iota(indices.begin(), indices.end(), i * c_size);
+            p_solver->add_constraint_equality(indices, ones, 1.);
+
+            for (auto k = 0; k < c_size; ++k)
+                indices[k] = k * c_size + i;
+            p_solver->add_constraint_equality(indices, ones, 1.);
+        }
+    }
+
+
+    ILPSolverInterface* __stdcall create_no_solver()
+    {
+        return nullptr;
+    }
+
+
+    // Solves p_num_models_per_kind small knapsack and assignment models in batches on all cores
+    // and compares the first p_num_serial_models of them with solving them one by one with a new solver each.
+    static void solve_batches(ILPSolverInterface* p_solver, int p_num_models_per_kind, int p_num_serial_models)
+    {
+        add_knapsack_model(p_solver, 0);
+        p_solver->maximize();
+        BOOST_REQUIRE(p_solver->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+
+        vector<ILPSolverInterface*> knapsacks  (p_num_models_per_kind);
+        vector<ILPSolverInterface*> assignments(p_num_models_per_kind);
+        for (auto k = 0; k < p_num_models_per_kind; ++k)
+        {
+            knapsacks[k] = create_batch_model(create_solver_cbc);
+            add_knapsack_model(knapsacks[k], k);
+            assignments[k] = create_batch_model(create_solver_cbc);
+            add_assignment_model(assignments[k], k);
+        }
+
+        double knapsacks_per_second  { 0. };
+        double assignments_per_second{ 0. };
+        auto start_time = GetTickCount();
+        BOOST_REQUIRE(solve_batch(knapsacks.data(),   p_num_models_per_kind, true,  create_solver_cbc, 0, &knapsacks_per_second));
+        BOOST_REQUIRE(solve_batch(assignments.data(), p_num_models_per_kind, false, create_solver_cbc, 0, &assignments_per_second));
+        const auto batch_time = GetTickCount() - start_time;
+
+        BOOST_REQUIRE_CLOSE(knapsacks[0]->get_objective(), p_solver->get_objective(), c_eps);
+        for (const auto* models: { &knapsacks, &assignments })
+        {
+            for (auto* model: *models)
+            {
+                BOOST_REQUIRE(model->get_status() == SolutionStatus::PROVEN_OPTIMAL);
+
+                auto failed{ true };
+                BOOST_REQUIRE(get_batch_model_failed(model, &failed));
+                BOOST_REQUIRE(!failed);
+
+                ViolationReport report;
+                BOOST_REQUIRE(check_solution(model, model->get_solution(), c_default_verification_tolerance, &report));
+                BOOST_REQUIRE(report.feasible);
+                BOOST_REQUIRE_CLOSE(report.objective, model->get_objective(), c_eps);
+            }
+        }
+
+        start_time = GetTickCount();
+        for (auto k = 0; k < p_num_serial_models; ++k)
+        {
+            auto* solver = create_solver_cbc();
+            add_knapsack_model(solver, k);
+            solver->maximize();
+            BOOST_REQUIRE_CLOSE(solver->get_objective(), knapsacks[k]->get_objective(), c_eps);
+            destroy_solver(solver);
+
+            solver = create_solver_cbc();
+            add_assignment_model(solver, k);
+            solver->minimize();
+            BOOST_REQUIRE_CLOSE(solver->get_objective(), assignments[k]->get_objective(), c_eps);
+            destroy_solver(solver);
+        }
+        const auto serial_time = GetTickCount() - start_time;
+
+        for (auto k = 0; k < p_num_models_per_kind; ++k)
+        {
+            destroy_solver(knapsacks[k]);
+            destroy_solver(assignments[k]);
+        }
+
+        if (LOGGING)
+            cout << "Test for " << 2 * p_num_models_per_kind << " small models took " << batch_time << " ms in batches ("
+                 << knapsacks_per_second << " knapsacks/s, " << assignments_per_second << " assignments/s).\n"
+                 << "\t" << 2 * p_num_serial_models << " of them took " << serial_time << " ms one by one." << endl;
+    }
+
+
+    void test_batch(ILPSolverInterface* p_solver)
+    {
+        solve_batches(p_solver, 150, 20);
+
+        // Only models created by create_batch_model can be solved in a batch.
+        double models_per_second{ 0. };
+        BOOST_REQUIRE(!solve_batch(&p_solver, 1, true, create_solver_cbc, 0, &models_per_second));
+
+        auto failed{ false };
+        BOOST_REQUIRE(!get_batch_model_failed(p_solver, &failed));
+
+        // Without a backend, the batch fails without throwing and every model is marked as failed.
+        std::array<ILPSolverInterface*, 3> models;
+        for (auto k = 0; k < static_cast<int>(models.size()); ++k)
+        {
+            models[k] = create_batch_model(create_solver_cbc);
+            add_knapsack_model(models[k], k);
+        }
+        BOOST_REQUIRE(!solve_batch(models.data(), static_cast<int>(models.size()), true, create_no_solver, 2, &models_per_second));
+        for (auto* model: models)
+        {
+            BOOST_REQUIRE(get_batch_model_failed(model, &failed));
+            BOOST_REQUIRE(failed);
+            BOOST_REQUIRE(model->get_status() == SolutionStatus::NO_SOLUTION);
+            destroy_solver(model);
+        }
+    }
+
+
+    // Not part of the unit tests, see create_ilp_test_suite.
+    void benchmark_batch(ILPSolverInterface* p_solver)
+    {
+        solve_batches(p_solver, 5000, 500);
+    }
+
+
     ILPSolverInterface* __stdcall create_stub()
     {
         constexpr std::string_view solver_exe_name = "ScaiIlpExe.exe";
         return create_solver_stub(solver_exe_name.data());
     }
+
+
+    // Hands every model over via a file, however small it is.
+    ILPSolverInterface* __stdcall create_stub_file_backed()
+    {
+        constexpr std::string_view solver_exe_name = "ScaiIlpExe.exe";
+        return create_solver_stub_file_backed(solver_exe_name.data(), 0);
+    }
+
+
+    ILPSolverInterface* __stdcall create_cache_cbc()
+    {
+        return create_solver_cache(create_solver_cbc);
+    }
+
+
+    ILPSolverInterface* __stdcall create_structure_cache_cbc()
+    {
+        return create_solver_structure_cache(create_solver_cbc);
+    }
+
+
+    ILPSolverInterface* __stdcall create_presolve_cbc()
+    {
+        return create_solver_presolve(create_solver_cbc);
+    }
+
+
+    ILPSolverInterface* __stdcall create_decompose_cbc()
+    {
+        return create_solver_decompose(create_solver_cbc);
+    }
+
+
+    ILPSolverInterface* __stdcall create_scaling_cbc()
+    {
+        return create_solver_scaling(create_solver_cbc, true);
+    }
+
+
+    ILPSolverInterface* __stdcall create_cbc_feasibility_first()
+    {
+        return create_solver_cbc_profile(CbcProfile::FEASIBILITY_FIRST);
+    }
+
+
+    // Without SCIP, create_solver_scip returns nullptr, which the portfolio skips.
+    ILPSolverInterface* __stdcall create_portfolio_cbc()
+    {
+        constexpr std::array<ILPSolverInterface* (__stdcall*)(), 3> backends{ create_solver_cbc, create_cbc_feasibility_first, create_solver_scip };
+        return create_solver_portfolio(backends.data(), static_cast<int>(backends.size()));
+    }
+
+
+    // The stub runs CBC in a separate process, which shares its incumbent through the shared memory.
+    ILPSolverInterface* __stdcall create_portfolio_stub()
+    {
+        constexpr std::array<ILPSolverInterface* (__stdcall*)(), 2> backends{ create_cbc_feasibility_first, create_stub };
+        return create_solver_portfolio(backends.data(), static_cast<int>(backends.size()));
+    }
 }
 
 
@@ -609,23 +1980,60 @@ namespace
     // and we somehow need to get a different file path per solver.
     int global_current_index{0};
 
-    constexpr int num_solvers = 2 * (WITH_CBC) + (WITH_SCIP)
+    constexpr int num_solvers = 9 * (WITH_CBC) + (WITH_SCIP)
 #if _WIN64 == 1
                               + (WITH_GUROBI)
 #endif
     ;
 
-    constexpr std::array<std::pair<FactoryFunction, std::string_view>, num_solvers> all_solvers
+    struct SolverSuite
+    {
+        FactoryFunction  factory;
+        std::string_view name;
+
+        // Tests only for this kind of solver, in addition to all_tests.
+        std::vector<std::pair<TestFunction, std::string_view>> extra_tests;
+    };
+
+    // Callbacks are only tested for the solvers supporting them. The other decorators change the model
+    // for their backend, which thus cannot report to the callbacks.
+    const std::array<SolverSuite, num_solvers> all_solvers
     {
 #if WITH_CBC == 1
-        std::pair{create_solver_cbc,    "CBC"},
-        std::pair{create_stub,          "CBCStub"},
+        SolverSuite{create_solver_cbc,          "CBC",               { {test_cbc_profiles,                  "Profiles"}
+                                                                       , {test_cbc_warm_start,                "WarmStart"}
+                                                                       , {test_batch,                         "Batch"}
+                                                                       , {test_callbacks,                     "Callbacks"} }},
+        SolverSuite{create_stub,                "CBCStub",           { {test_bad_alloc,                     "BadAlloc"}
+                                                                       , {test_callbacks,                     "Callbacks"} }},
+        SolverSuite{create_stub_file_backed,    "CBCStubFile",       { {test_bad_alloc,                     "BadAlloc"} }},
+        SolverSuite{create_cache_cbc,           "CBCCache",          { {test_solution_cache,                "SolutionCache"}
+                                                                       , {test_solution_cache_foreign_file,   "SolutionCacheForeignFile"}
+                                                                       , {test_callbacks,                     "Callbacks"} }},
+        SolverSuite{create_structure_cache_cbc, "CBCStructureCache", { {test_structure_cache,               "StructureCache"}
+                                                                       , {test_callbacks,                     "Callbacks"} }},
+        SolverSuite{create_presolve_cbc,        "CBCPresolve",       { {test_presolve_reductions,           "Reductions"}
+                                                                       , {test_bound_propagation,             "Propagation"}
+                                                                       , {test_presolve_tolerance,            "Tolerance"}
+                                                                       , {test_nearly_redundant_constraint,   "NearlyRedundant"} }},
+        SolverSuite{create_decompose_cbc,       "CBCDecompose",      { {test_decomposition,                 "Blocks"}
+                                                                       , {test_check_solution_overhead,       "CheckSolutionOverhead"} }},
+        SolverSuite{create_scaling_cbc,         "CBCScaling",        { {test_badly_scaled,                  "BadlyScaled"} }},
+        SolverSuite{create_portfolio_cbc,       "CBCPortfolio",      { {test_portfolio,                     "Winner"}
+                                                                       , {test_portfolio_incumbent_sharing,   "IncumbentSharing"}
+                                                                       , {test_callbacks,                     "Callbacks"} }},
 #endif
 #if WITH_SCIP == 1
-        std::pair{create_solver_scip,   "SCIP"},
+        SolverSuite{create_solver_scip,         "SCIP",              { {test_performance_big_columns,       "PerformanceBigColumns"}
+                                                                       , {test_scip_reoptimization,           "Reoptimization"}
+                                                                       , {test_scip_reoptimization_after_limit, "ReoptimizationAfterLimit"}
+                                                                       , {test_scip_concurrent,               "Concurrent"}
+                                                                       , {test_scip_pool,                     "Pool"}
+                                                                       , {test_callbacks,                     "Callbacks"}
+                                                                       , {test_callbacks_with_threads,        "CallbacksWithThreads"} }},
 #endif
 #if (WITH_GUROBI == 1) && (_WIN64 == 1)
-        std::pair{create_solver_gurobi, "Gurobi"},
+        SolverSuite{create_solver_gurobi,       "Gurobi",            { {test_callbacks,                     "Callbacks"} }},
 #endif
     };
 }
@@ -633,7 +2041,7 @@ namespace
 
 int create_ilp_test_suite()
 {
-    constexpr std::array<std::pair<TestFunction, std::string_view>, 9> all_tests
+    constexpr std::array<std::pair<TestFunction, std::string_view>, 14> all_tests
     { std::pair{test_sorting,                     "Sorting"}
     , std::pair{test_linear_programming,          "LinProgr"}
     , std::pair{test_start_solution_minimization, "StartSolutionMin"}
@@ -643,12 +2051,17 @@ int create_ilp_test_suite()
     , std::pair{test_performance,                 "Performance"}
     , std::pair{test_performance_big,             "PerformanceBig"}
     , std::pair{test_performance_zero,            "PerformanceZero"}
+    , std::pair{test_model_statistics,            "ModelStatistics"}
+    , std::pair{test_check_solution,              "CheckSolution"}
+    , std::pair{test_modification,                "Modification"}
+    , std::pair{test_deletion,                    "Deletion"}
+    , std::pair{test_async,                       "Async"}
     };
 
     boost::unit_test::test_suite* IlpSolverT = BOOST_TEST_SUITE("IlpSolverT");
 
     // Create a test suite for each kind of solver.
-    for (auto& [solver, solver_name] : all_solvers )
+    for (auto& [solver, solver_name, extra_tests] : all_solvers )
     {
         boost::unit_test::test_suite* suite = BOOST_TEST_SUITE(solver_name.data());
         for (auto& [test, test_name] : all_tests)
@@ -659,14 +2072,14 @@ int create_ilp_test_suite()
             suite->add( boost::unit_test::make_test_case(lambda, (std::string(solver_name) + '_' + test_name.data()).c_str(), __FILE__, __LINE__) );
         }
 
-        auto mps_path   = [](ILPSolverInterface* p_solver) -> void {test_mps_output(p_solver, std::string(all_solvers[global_current_index++].second) + "_unittest.mps");};
+        auto mps_path   = [](ILPSolverInterface* p_solver) -> void {test_mps_output(p_solver, std::string(all_solvers[global_current_index++].name) + "_unittest.mps");};
         auto mps_lambda = [solver, mps_path]() { execute_test_and_destroy_solver(solver(), mps_path); };
         suite->add( boost::unit_test::make_test_case(mps_lambda, (std::string(solver_name) + "_MPSOut").c_str(), __FILE__, __LINE__) );
 
-        if (solver_name.rfind("Stub") != std::string::npos)
+        for (auto& [test, test_name] : extra_tests)
         {
-            auto lambda = [solver]() { execute_test_and_destroy_solver(solver(), test_bad_alloc); };
-            suite->add( boost::unit_test::make_test_case(lambda, (std::string(solver_name) + "_BadAlloc").c_str(), __FILE__, __LINE__) );
+            auto lambda = [solver, test]() { execute_test_and_destroy_solver(solver(), test); };
+            suite->add( boost::unit_test::make_test_case(lambda, (std::string(solver_name) + '_' + test_name.data()).c_str(), __FILE__, __LINE__) );
         }
 
         // Add the current solver to the IlpSolverT test suite.
@@ -676,6 +2089,16 @@ int create_ilp_test_suite()
     // Add the whole IlpSolver test suite to the master test suite.
     boost::unit_test::framework::master_test_suite().add(IlpSolverT);
 
+    // The benchmarks take too long for the unit tests and are disabled by default.
+    // They only run if selected explicitly, e.g. with --run_test=IlpSolverBenchmarks.
+    boost::unit_test::test_suite* IlpSolverBenchmarks = BOOST_TEST_SUITE("IlpSolverBenchmarks");
+    IlpSolverBenchmarks->p_default_status.value = boost::unit_test::test_unit::RS_DISABLED;
+#if WITH_CBC == 1
+    auto batch_lambda = []() { execute_test_and_destroy_solver(create_solver_cbc(), benchmark_batch); };
+    IlpSolverBenchmarks->add( boost::unit_test::make_test_case(batch_lambda, "CBC_Batch", __FILE__, __LINE__) );
+#endif
+    boost::unit_test::framework::master_test_suite().add(IlpSolverBenchmarks);
+
     return 0;
 }
 
@@ -0,0 +1,309 @@
+#include "shared_memory_communication.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using std::string;
+using std::vector;
+
+namespace ilp_solver
+{
+    static ILPData generate_data()
+    {
+        ILPData data;
+        data.matrix           = { { 1., 2., 0. }, { 0., 1., 3. } };
+        data.objective        = { 1., 1., 2. };
+        data.variable_lower   = { 0., 0., 0. };
+        data.variable_upper   = { 4., 4., 4. };
+        data.constraint_lower = { c_neg_inf, 1. };
+        data.constraint_upper = { 5., 6. };
+        data.variable_type    = { VariableType::INTEGER, VariableType::INTEGER, VariableType::CONTINUOUS };
+        data.objective_sense  = ObjectiveSense::MAXIMIZE;
+        data.start_solution   = { 1., 2., 0. };
+        return data;
+    }
+
+
+    static void verify_equality(const ILPData& p_data_1, const ILPData& p_data_2)
+    {
+        BOOST_REQUIRE(p_data_1.matrix           == p_data_2.matrix);
+        BOOST_REQUIRE(p_data_1.objective        == p_data_2.objective);
+        BOOST_REQUIRE(p_data_1.variable_lower   == p_data_2.variable_lower);
+        BOOST_REQUIRE(p_data_1.variable_upper   == p_data_2.variable_upper);
+        BOOST_REQUIRE(p_data_1.constraint_lower == p_data_2.constraint_lower);
+        BOOST_REQUIRE(p_data_1.constraint_upper == p_data_2.constraint_upper);
+        BOOST_REQUIRE(p_data_1.variable_type    == p_data_2.variable_type);
+        BOOST_REQUIRE(p_data_1.objective_sense  == p_data_2.objective_sense);
+        BOOST_REQUIRE(p_data_1.start_solution   == p_data_2.start_solution);
+        BOOST_REQUIRE_EQUAL(p_data_1.max_seconds, p_data_2.max_seconds);
+    }
+
+
+    // The child reads what the parent has written and answers with a solution.
+    static void solve_in_child(const string& p_handoff_name, const ILPData& p_expected_data)
+    {
+        CommunicationChild child(p_handoff_name);
+        ILPData data;
+        child.read_ilp_data(&data);
+        verify_equality(data, p_expected_data);
+
+        ILPSolutionData solution_data(data.objective_sense);
+        solution_data.solution        = data.start_solution;
+        solution_data.objective       = 42.;
+        solution_data.solution_status = SolutionStatus::SUBOPTIMAL;
+        child.write_solution_data(solution_data);
+
+        // The start solution is passed on as incumbent as well, if the parent has enabled the incumbent slot.
+        if (child.incumbent_slot().enabled())
+        {
+            SharedIncumbent incumbent(data.objective_sense);
+            incumbent.publish(data.start_solution, 42.);
+            child.incumbent_slot().exchange(&incumbent);
+        }
+    }
+
+
+    // Re-solving with an unchanged matrix reuses the shared memory (or file) and only rewrites the data behind the matrix.
+    // The result of the previous solve must not survive the rewrite.
+    static void test_rewrite(std::size_t p_max_shared_memory_bytes)
+    {
+        CommunicationParent parent(p_max_shared_memory_bytes);
+        auto data = generate_data();
+        const auto handoff_name = parent.write_ilp_data(data);
+        parent.incumbent_slot().reset(true);
+        solve_in_child(handoff_name, data);
+
+        ILPSolutionData solution_data;
+        parent.read_solution_data(&solution_data);
+        BOOST_REQUIRE(solution_data.solution_status == SolutionStatus::SUBOPTIMAL);
+        BOOST_REQUIRE(solution_data.solution == data.start_solution);
+
+        SharedIncumbent incumbent(data.objective_sense);
+        parent.incumbent_slot().exchange(&incumbent);
+        BOOST_REQUIRE(incumbent.get() && incumbent.get()->solution == data.start_solution);
+
+        // Same sizes, changed bounds, objective, start solution and parameters.
+        data.variable_upper   = { 2., 4., 1. };
+        data.constraint_lower = { 0., c_neg_inf };
+        data.objective[2]     = -1.;
+        data.start_solution   = { 2., 1., 1. };
+        data.max_seconds      = 10.;
+        BOOST_REQUIRE_EQUAL(parent.write_ilp_data(data, false), handoff_name);
+
+        parent.read_solution_data(&solution_data);
+        BOOST_REQUIRE(solution_data.solution_status == SolutionStatus::NO_SOLUTION);
+        BOOST_REQUIRE(solution_data.solution.empty());
+
+        solve_in_child(handoff_name, data);
+        parent.read_solution_data(&solution_data);
+        BOOST_REQUIRE(solution_data.solution_status == SolutionStatus::SUBOPTIMAL);
+        BOOST_REQUIRE(solution_data.solution == data.start_solution);
+
+        // Without a start solution, the data gets smaller and is written anew.
+        data.start_solution.clear();
+        solve_in_child(parent.write_ilp_data(data, false), data);
+
+        // A changed matrix of the same size is written anew as well.
+        data.matrix[0][2] = 1.;
+        solve_in_child(parent.write_ilp_data(data, true), data);
+    }
+
+
+    void test_rewrite_shared_memory()
+    {
+        test_rewrite(c_default_max_shared_memory_bytes);
+    }
+
+
+    void test_rewrite_file()
+    {
+        test_rewrite(0);
+    }
+
+
+    static void verify_equality(const ModelDelta& p_delta_1, const ModelDelta& p_delta_2)
+    {
+        BOOST_REQUIRE_EQUAL(p_delta_1.num_variables,   p_delta_2.num_variables);
+        BOOST_REQUIRE_EQUAL(p_delta_1.num_constraints, p_delta_2.num_constraints);
+        BOOST_REQUIRE(p_delta_1.variable_indices       == p_delta_2.variable_indices);
+        BOOST_REQUIRE(p_delta_1.variable_lower         == p_delta_2.variable_lower);
+        BOOST_REQUIRE(p_delta_1.variable_upper         == p_delta_2.variable_upper);
+        BOOST_REQUIRE(p_delta_1.objective_indices      == p_delta_2.objective_indices);
+        BOOST_REQUIRE(p_delta_1.objective              == p_delta_2.objective);
+        BOOST_REQUIRE(p_delta_1.constraint_indices     == p_delta_2.constraint_indices);
+        BOOST_REQUIRE(p_delta_1.constraint_lower       == p_delta_2.constraint_lower);
+        BOOST_REQUIRE(p_delta_1.constraint_upper       == p_delta_2.constraint_upper);
+        BOOST_REQUIRE(p_delta_1.coefficient_rows       == p_delta_2.coefficient_rows);
+        BOOST_REQUIRE(p_delta_1.coefficient_columns    == p_delta_2.coefficient_columns);
+        BOOST_REQUIRE(p_delta_1.coefficients           == p_delta_2.coefficients);
+        BOOST_REQUIRE(p_delta_1.new_variable_type      == p_delta_2.new_variable_type);
+        BOOST_REQUIRE(p_delta_1.new_variable_objective == p_delta_2.new_variable_objective);
+        BOOST_REQUIRE(p_delta_1.new_variable_lower     == p_delta_2.new_variable_lower);
+        BOOST_REQUIRE(p_delta_1.new_variable_upper     == p_delta_2.new_variable_upper);
+        BOOST_REQUIRE(p_delta_1.new_variable_rows      == p_delta_2.new_variable_rows);
+        BOOST_REQUIRE(p_delta_1.new_variable_values    == p_delta_2.new_variable_values);
+        BOOST_REQUIRE(p_delta_1.new_constraint_lower   == p_delta_2.new_constraint_lower);
+        BOOST_REQUIRE(p_delta_1.new_constraint_upper   == p_delta_2.new_constraint_upper);
+        BOOST_REQUIRE(p_delta_1.new_constraint_columns == p_delta_2.new_constraint_columns);
+        BOOST_REQUIRE(p_delta_1.new_constraint_values  == p_delta_2.new_constraint_values);
+    }
+
+
+    // The delta only contains what has changed, and the child reads it together with the settings.
+    static void test_model_delta(std::size_t p_max_shared_memory_bytes)
+    {
+        const auto old_data = generate_data();
+        auto data = old_data;
+        data.variable_upper[1]   = 3.;
+        data.objective[2]        = -1.;
+        data.constraint_lower[1] = 2.;
+        data.matrix[0][2]        = 4.;
+        data.max_seconds         = 10.;
+
+        // An appended variable and an appended constraint
+        data.matrix[1].push_back(5.);
+        data.matrix[0].push_back(0.);
+        data.objective.push_back(3.);
+        data.variable_lower.push_back(0.);
+        data.variable_upper.push_back(1.);
+        data.variable_type.push_back(VariableType::INTEGER);
+        data.start_solution.push_back(1.);
+        data.matrix.push_back({ 0., 1., 0., 1. });
+        data.constraint_lower.push_back(c_neg_inf);
+        data.constraint_upper.push_back(1.);
+
+        ModelDelta delta;
+        BOOST_REQUIRE(compute_model_delta(old_data, data, true, &delta));
+        BOOST_REQUIRE_EQUAL(delta.num_variables,   4);
+        BOOST_REQUIRE_EQUAL(delta.num_constraints, 3);
+        BOOST_REQUIRE(delta.variable_indices       == vector<int>{ 1 });
+        BOOST_REQUIRE(delta.objective_indices      == vector<int>{ 2 });
+        BOOST_REQUIRE(delta.constraint_indices     == vector<int>{ 1 });
+        BOOST_REQUIRE(delta.coefficient_rows       == vector<int>{ 0 });
+        BOOST_REQUIRE(delta.coefficient_columns    == vector<int>{ 2 });
+        BOOST_REQUIRE(delta.coefficients           == vector<double>{ 4. });
+        BOOST_REQUIRE(delta.new_variable_rows      == vector<vector<int>>{ { 1 } });
+        BOOST_REQUIRE(delta.new_variable_values    == vector<vector<double>>{ { 5. } });
+        BOOST_REQUIRE((delta.new_constraint_columns == vector<vector<int>>{ { 1, 3 } }));
+
+        CommunicationParent parent(p_max_shared_memory_bytes);
+        const auto handoff_name = parent.write_model_delta(delta, data);
+        parent.incumbent_slot().reset(true);
+        {
+            CommunicationChild child(handoff_name);
+            ModelDelta read_delta;
+            ILPData settings;
+            child.read_model_delta(&read_delta, &settings);
+            verify_equality(read_delta, delta);
+            BOOST_REQUIRE(settings.start_solution == data.start_solution);
+            BOOST_REQUIRE(settings.objective_sense == data.objective_sense);
+            BOOST_REQUIRE_EQUAL(settings.max_seconds, data.max_seconds);
+
+            ILPSolutionData solution_data(settings.objective_sense);
+            solution_data.solution        = settings.start_solution;
+            solution_data.solution_status = SolutionStatus::SUBOPTIMAL;
+            child.write_solution_data(solution_data);
+
+            // The incumbent slot of the child has the new number of variables.
+            SharedIncumbent incumbent(settings.objective_sense);
+            incumbent.publish(settings.start_solution, 1.);
+            child.incumbent_slot().exchange(&incumbent);
+        }
+        ILPSolutionData solution_data;
+        parent.read_solution_data(&solution_data);
+        BOOST_REQUIRE(solution_data.solution_status == SolutionStatus::SUBOPTIMAL);
+        BOOST_REQUIRE(solution_data.solution == data.start_solution);
+
+        SharedIncumbent incumbent(data.objective_sense);
+        parent.incumbent_slot().exchange(&incumbent);
+        BOOST_REQUIRE(incumbent.get() && incumbent.get()->solution == data.start_solution);
+
+        // Without matrix changes, the coefficients are not compared.
+        BOOST_REQUIRE(compute_model_delta(data, data, false, &delta));
+        BOOST_REQUIRE(delta.coefficients.empty() && delta.new_variable_type.empty() && delta.new_constraint_lower.empty());
+
+        // No deltas: fewer variables, another variable type and a removed start solution
+        BOOST_REQUIRE(!compute_model_delta(data, old_data, true, &delta));
+        auto other_data = data;
+        other_data.variable_type[0] = VariableType::CONTINUOUS;
+        BOOST_REQUIRE(!compute_model_delta(data, other_data, true, &delta));
+        other_data = data;
+        other_data.start_solution.clear();
+        BOOST_REQUIRE(!compute_model_delta(data, other_data, true, &delta));
+    }
+
+
+    void test_model_delta_shared_memory()
+    {
+        test_model_delta(c_default_max_shared_memory_bytes);
+    }
+
+
+    void test_model_delta_file()
+    {
+        test_model_delta(0);
+    }
+
+
+    // The child answers every request until it is asked to quit.
+    void test_session()
+    {
+        SessionParent parent;
+        std::thread child_thread([&parent]()
+        {
+            SessionChild child(parent.name());
+            while (true)
+            {
+                while (!child.wait_for_request(10))
+                    ;
+                if (child.request() == SessionRequest::quit)
+                    return;
+                child.respond(child.handoff_name() == "model" ? SolverExitCode::ok : SolverExitCode::model_error);
+            }
+        });
+
+        BOOST_REQUIRE(!parent.wait_for_response(10));
+        parent.post(SessionRequest::solve_model, "model");
+        BOOST_REQUIRE(parent.wait_for_response(10000));
+        BOOST_REQUIRE(parent.exit_code() == SolverExitCode::ok);
+
+        parent.post(SessionRequest::solve_model_delta, "delta");
+        BOOST_REQUIRE(parent.wait_for_response(10000));
+        BOOST_REQUIRE(parent.exit_code() == SolverExitCode::model_error);
+
+        parent.post(SessionRequest::quit);
+        child_thread.join();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( SharedMemoryCommunicationT );
+
+BOOST_AUTO_TEST_CASE ( RewriteSharedMemory )
+{
+    ilp_solver::test_rewrite_shared_memory ();
+}
+
+BOOST_AUTO_TEST_CASE ( RewriteFile )
+{
+    ilp_solver::test_rewrite_file ();
+}
+
+BOOST_AUTO_TEST_CASE ( ModelDeltaSharedMemory )
+{
+    ilp_solver::test_model_delta_shared_memory ();
+}
+
+BOOST_AUTO_TEST_CASE ( ModelDeltaFile )
+{
+    ilp_solver::test_model_delta_file ();
+}
+
+BOOST_AUTO_TEST_CASE ( Session )
+{
+    ilp_solver::test_session ();
+}
+
+BOOST_AUTO_TEST_SUITE_END();